@@ -65,6 +65,30 @@ public:
 						pfLayer->OnRebuildEvent();
 					}
 				});
+			imGuiLayer->OnViewportClickedEvent.Bind(
+				[this](float x, float y)
+				{
+					if (std::shared_ptr<PathfindingLayer> pfLayer = pathfindingLayer_.lock())
+					{
+						pfLayer->OnViewportClicked(x, y);
+					}
+				});
+			imGuiLayer->OnLoadMapEvent.Bind(
+				[this](const std::string& path)
+				{
+					if (std::shared_ptr<PathfindingLayer> pfLayer = pathfindingLayer_.lock())
+					{
+						pfLayer->OnLoadMapEvent(path);
+					}
+				});
+			imGuiLayer->OnSaveMapEvent.Bind(
+				[this](const std::string& path)
+				{
+					if (std::shared_ptr<PathfindingLayer> pfLayer = pathfindingLayer_.lock())
+					{
+						pfLayer->OnSaveMapEvent(path);
+					}
+				});
 			pathfindingLayer->OnRebuildEvent();
 		}
 	}
@@ -8,6 +8,10 @@
 #include "imgui_impl_glfw.h"
 #include "imgui_impl_opengl3.h"
 
+#include <cfloat>
+#include <chrono>
+#include <initializer_list>
+
 void ImGuiLayer::OnInit()
 {
 	IMGUI_CHECKVERSION();
@@ -57,6 +61,13 @@ void ImGuiLayer::RenderViewport()
 	ImVec2 imageSize = ImGui::GetContentRegionAvail();
 	framebuffer->Resize(static_cast<int>(imageSize.x), static_cast<int>(imageSize.y));
 	ImGui::Image(framebuffer->GetColorAttachmentId(), imageSize, ImVec2(0.0f, 1.0f), ImVec2(1.0f, 0.0f));
+	if (ImGui::IsItemClicked(ImGuiMouseButton_Left))
+	{
+		const ImVec2 imageMin = ImGui::GetItemRectMin();
+		const ImVec2 mousePosition = ImGui::GetMousePos();
+		OnViewportClickedEvent.Execute(mousePosition.x - imageMin.x - imageSize.x * 0.5f,
+									   imageSize.y * 0.5f - (mousePosition.y - imageMin.y));
+	}
 
 	ImGui::End();
 }
@@ -68,6 +79,7 @@ void ImGuiLayer::RenderDetailPanel()
 	ImGui::SeparatorText("Simulation Controls");
 	ImGui::Text("FrameRate: %d (%.0f ms)", static_cast<int>(ImGui::GetIO().Framerate),
 				1000.0f / ImGui::GetIO().Framerate);
+	RenderSearchStats();
 
 	if (ImGui::Button("Start"))
 	{
@@ -90,7 +102,9 @@ void ImGuiLayer::RenderDetailPanel()
 	ImGui::PopItemFlag();
 
 	ImGui::SliderInt("Cell Size", &currentMap_->CellSize, 4, 64);
-	ImGui::DragFloat("Simulation Speed", &currentMap_->SimulationSpeed, 0.1f, 0.1f, 5.0f, "%.1f x");
+	// 1x는 초당 100노드. 탐색은 워커 스레드에서 진행되므로 빠르게 해도 렌더링은 느려지지 않는다.
+	ImGui::DragFloat("Simulation Speed", &currentMap_->SimulationSpeed, 0.1f, 0.1f, 100000.0f, "%.1f x",
+					 ImGuiSliderFlags_Logarithmic);
 
 	ImGui::SeparatorText("Pathfinding Settings");
 	if (ImGui::Button("Reset"))
@@ -107,6 +121,40 @@ void ImGuiLayer::RenderDetailPanel()
 		OnRebuildEvent.Execute();
 	}
 
+	// .map(MovingAI)은 읽어서 복사하고, .pfmap은 메모리에 맵해서 그대로 탐색한다.
+	ImGui::InputText("Map File", mapFilePath_, sizeof(mapFilePath_));
+	if (ImGui::Button("Load"))
+	{
+		bIsRefreshed = true;
+		OnPauseEvent.Execute();
+		OnLoadMapEvent.Execute(mapFilePath_);
+	}
+	ImGui::SameLine();
+	if (ImGui::Button("Save"))
+	{
+		OnSaveMapEvent.Execute(mapFilePath_);
+	}
+	if (!currentMap_->MapFileError.empty())
+	{
+		ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "%s", currentMap_->MapFileError.c_str());
+	}
+
+	// 지형(Swamp/Water)은 통과할 수 있지만 이동 비용이 커진다.
+	constexpr ETileType paintTiles[] = {ETileType::Wall, ETileType::Swamp, ETileType::Water};
+	constexpr const char* paintTileNames[] = {"Wall", "Swamp", "Water"};
+	int selectedPaintTile = 0;
+	for (int i = 0; i < IM_ARRAYSIZE(paintTiles); ++i)
+	{
+		if (paintTiles[i] == currentMap_->PaintTile)
+		{
+			selectedPaintTile = i;
+		}
+	}
+	if (ImGui::Combo("Paint Tile", &selectedPaintTile, paintTileNames, IM_ARRAYSIZE(paintTileNames)))
+	{
+		currentMap_->PaintTile = paintTiles[selectedPaintTile];
+	}
+
 	ImGui::BeginDisabled(!bIsRefreshed);
 	ImGui::BeginGroup();
 	ImGui::Columns(2, "Start Position");
@@ -121,6 +169,18 @@ void ImGuiLayer::RenderDetailPanel()
 	ImGui::SliderInt("End Col", &currentMap_->EndColumn, 0, currentMap_->ColumnCount - 1);
 	ImGui::Columns(1);
 
+	const char* algorithmNames[static_cast<int>(ESearchAlgorithm::NUM_TYPES)];
+	for (int i = 0; i < static_cast<int>(ESearchAlgorithm::NUM_TYPES); ++i)
+	{
+		algorithmNames[i] = ESearchAlgorithm::to_string(static_cast<ESearchAlgorithm::Type>(i));
+	}
+
+	int selectedAlgorithm = currentMap_->Algorithm;
+	if (ImGui::Combo("Algorithm", &selectedAlgorithm, algorithmNames, ESearchAlgorithm::NUM_TYPES))
+	{
+		currentMap_->Algorithm = static_cast<ESearchAlgorithm::Type>(selectedAlgorithm);
+	}
+
 	const char* heuristicMethodNames[static_cast<int>(EHeuristicMethod::NUM_TYPES)];
 	for (int i = 0; i < static_cast<int>(EHeuristicMethod::NUM_TYPES); ++i)
 	{
@@ -133,12 +193,125 @@ void ImGuiLayer::RenderDetailPanel()
 	{
 		currentMap_->HeuristicMethod = static_cast<EHeuristicMethod::Type>(selectedIndex);
 	}
+
+	const char* openListTypeNames[static_cast<int>(EOpenListType::NUM_TYPES)];
+	for (int i = 0; i < static_cast<int>(EOpenListType::NUM_TYPES); ++i)
+	{
+		openListTypeNames[i] = EOpenListType::to_string(static_cast<EOpenListType::Type>(i));
+	}
+
+	int selectedOpenList = currentMap_->OpenListType;
+	if (ImGui::Combo("Open List", &selectedOpenList, openListTypeNames, EOpenListType::NUM_TYPES))
+	{
+		currentMap_->OpenListType = static_cast<EOpenListType::Type>(selectedOpenList);
+	}
 	ImGui::EndGroup();
 	if (!bIsRefreshed)
 	{
-		ImGui::SetItemTooltip("Reset or Rebuild the map to change start/end positions or heuristic method.");
+		ImGui::SetItemTooltip(
+			"Reset or Rebuild the map to change start/end positions, algorithm, heuristic method or open list.");
 	}
 	ImGui::EndDisabled();
 
 	ImGui::End();
-}
\ No newline at end of file
+}
+
+void ImGuiLayer::RenderSearchStats()
+{
+	if (!ImGui::CollapsingHeader("Search Stats", ImGuiTreeNodeFlags_DefaultOpen))
+	{
+		return;
+	}
+	auto toMilliseconds = [](std::chrono::nanoseconds time)
+	{ return std::chrono::duration<float, std::milli>(time).count(); };
+
+	SearchStatsHistory& history = currentMap_->StatsHistory;
+	const SearchStatsRecord& current = history.GetCurrent();
+	const SearchStats& stats = current.Stats;
+	const char* state = !history.IsCurrentFinished() ? "Searching" : current.bFound ? "Found" : "No Path";
+	ImGui::Text("%s / %s / %s: %s", ESearchAlgorithm::to_string(current.Algorithm),
+				EHeuristicMethod::to_string(current.HeuristicMethod), EOpenListType::to_string(current.OpenListType),
+				state);
+	ImGui::Text("Expanded: %d  Generated: %d  Reopened: %d", stats.NodesExpanded, stats.NodesGenerated,
+				stats.ReopenedCount);
+	ImGui::Text("Open List: %zu (peak %zu)  Duplicate Pushes: %d", current.OpenListSize, stats.PeakOpenListSize,
+				stats.DuplicatePushCount);
+	ImGui::Text("Path: %d cells, cost %.2f", stats.PathCellCount, stats.PathCost);
+	ImGui::Text("Time: %.3f ms  Scratch: %.1f KB", toMilliseconds(stats.ElapsedTime),
+				static_cast<float>(stats.ScratchBytes) / 1024.0f);
+	// 사본을 받을 때마다 찍은 표본이므로 가로축은 시간이 아니라 진행 순서이다.
+	const ImVec2 plotSize(0.0f, 48.0f);
+	ImGui::PlotLines("Expanded", history.GetExpandedSamples(), history.GetSampleCount(), history.GetSampleOffset(),
+					 nullptr, 0.0f, FLT_MAX, plotSize);
+	ImGui::PlotLines("Open List", history.GetOpenListSamples(), history.GetSampleCount(),
+					 history.GetSampleOffset(), nullptr, 0.0f, FLT_MAX, plotSize);
+
+	ImGui::SeparatorText("Query History");
+	ImGui::Text("%d queries", history.GetRecordCount());
+	ImGui::SameLine();
+	if (ImGui::Button("Clear History"))
+	{
+		history.ClearRecords();
+	}
+	if (history.GetRecordCount() == 0)
+	{
+		return;
+	}
+	ImGui::PlotHistogram(
+		"Expanded##History",
+		[](void* data, int index)
+		{
+			const SearchStatsHistory& records = *static_cast<const SearchStatsHistory*>(data);
+			return static_cast<float>(records.GetRecord(index).Stats.NodesExpanded);
+		},
+		&history, history.GetRecordCount(), 0, nullptr, 0.0f, FLT_MAX, plotSize);
+	ImGui::PlotHistogram(
+		"Time (ms)##History",
+		[](void* data, int index)
+		{
+			const SearchStatsHistory& records = *static_cast<const SearchStatsHistory*>(data);
+			return std::chrono::duration<float, std::milli>(records.GetRecord(index).Stats.ElapsedTime).count();
+		},
+		&history, history.GetRecordCount(), 0, nullptr, 0.0f, FLT_MAX, plotSize);
+
+	constexpr ImGuiTableFlags tableFlags = ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV
+										   | ImGuiTableFlags_ScrollY | ImGuiTableFlags_SizingStretchProp;
+	if (!ImGui::BeginTable("Query History", 7, tableFlags, ImVec2(0.0f, 160.0f)))
+	{
+		return;
+	}
+	ImGui::TableSetupScrollFreeze(0, 1);
+	for (const char* column : {"Algorithm", "Heuristic", "Open List", "Expanded", "Peak Open", "Cost", "ms"})
+	{
+		ImGui::TableSetupColumn(column);
+	}
+	ImGui::TableHeadersRow();
+	// 최근 쿼리를 위에 둔다.
+	for (int i = history.GetRecordCount() - 1; i >= 0; --i)
+	{
+		const SearchStatsRecord& record = history.GetRecord(i);
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn();
+		ImGui::TextUnformatted(ESearchAlgorithm::to_string(record.Algorithm));
+		ImGui::TableNextColumn();
+		ImGui::TextUnformatted(EHeuristicMethod::to_string(record.HeuristicMethod));
+		ImGui::TableNextColumn();
+		ImGui::TextUnformatted(EOpenListType::to_string(record.OpenListType));
+		ImGui::TableNextColumn();
+		ImGui::Text("%d", record.Stats.NodesExpanded);
+		ImGui::TableNextColumn();
+		ImGui::Text("%zu", record.Stats.PeakOpenListSize);
+		ImGui::TableNextColumn();
+		if (record.bFound)
+		{
+			ImGui::Text("%.2f", record.Stats.PathCost);
+		}
+		else
+		{
+			ImGui::TextUnformatted("-");
+		}
+		ImGui::TableNextColumn();
+		ImGui::Text("%.3f", toMilliseconds(record.Stats.ElapsedTime));
+	}
+	ImGui::EndTable();
+}
@@ -4,6 +4,7 @@
 #include "Core/Layers/Layer.h"
 #include "MapData.h"
 #include <memory>
+#include <string>
 
 class ImGuiLayer : public ILayer
 {
@@ -20,12 +21,19 @@ public:
 	Delegate<> OnResetEvent;
 	Delegate<> OnStepEvent;
 	Delegate<> OnRebuildEvent;
+	// 뷰포트 중심을 원점으로, 위쪽을 +y로 하는 클릭 위치
+	Delegate<float, float> OnViewportClickedEvent;
+	Delegate<const std::string&> OnLoadMapEvent;
+	Delegate<const std::string&> OnSaveMapEvent;
 
 private:
 	void RenderViewport();
 	void RenderDetailPanel();
+	// 지금 쿼리의 통계와 표본, 끝난 쿼리의 기록을 그린다. RenderDetailPanel 안에서 호출한다.
+	void RenderSearchStats();
 
 private:
 	std::shared_ptr<MapData> currentMap_;
 	bool bIsRefreshed = true;
+	char mapFilePath_[256] = {};
 };
\ No newline at end of file
@@ -9,7 +9,10 @@ MapData::MapData(int rows, int columns, int cellSize)
 	, StartColumn(0)
 	, EndRow(rows - 1)
 	, EndColumn(columns - 1)
+	, Algorithm(ESearchAlgorithm::AStar)
 	, HeuristicMethod(EHeuristicMethod::None)
+	, OpenListType(EOpenListType::BinaryHeap)
 	, SimulationSpeed(1.0f)
+	, PaintTile(ETileType::Wall)
 {
 }
\ No newline at end of file
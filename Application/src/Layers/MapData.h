@@ -1,6 +1,9 @@
 #pragma once
 
 #include "Layers/LayerCommon.h"
+#include "Pathfinding/SearchStatsHistory.h"
+
+#include <string>
 
 struct MapData
 {
@@ -17,6 +20,16 @@ struct MapData
 	int StartColumn;
 	int EndRow;
 	int EndColumn;
+	ESearchAlgorithm::Type Algorithm;
 	EHeuristicMethod::Type HeuristicMethod;
+	EOpenListType::Type OpenListType;
 	float SimulationSpeed;
+	// 뷰포트를 클릭했을 때 칠할 타일. 같은 타일을 다시 클릭하면 Path로 되돌린다.
+	ETileType PaintTile;
+
+	// 마지막 맵 불러오기/저장 실패 이유. 성공하면 비운다.
+	std::string MapFileError;
+
+	// PathfindingLayer가 프레임마다 채우고 ImGuiLayer가 그린다.
+	SearchStatsHistory StatsHistory;
 };
\ No newline at end of file
@@ -2,166 +2,195 @@
 
 #include "Core/Application.h"
 #include "GLFW/glfw3.h"
+#include "Pathfinding/MovingAIFormat.h"
+#include "Pathfinding/PathSmoothing.h"
 #include "Pathfinding/PathfindingConfig.h"
+#include "Pathfinding/Profiling.h"
 #include "Renderer/Renderer.h"
 #include "Renderer/ResourceManager.h"
+#include "common/TracySystem.hpp"
 #include "glm/ext/matrix_clip_space.hpp"
 
-#include <iostream>
-#include <queue>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <initializer_list>
 
+namespace
+{
+	// bits에서 row 행의 켜진 비트가 이어진 구간마다 func(firstColumn, count)를 호출한다. 비트 i는 셀 i이다.
+	// 꺼진 워드와 켜진 워드는 한 번에 건너뛴다.
+	template <typename Func>
+	void ForEachSetRun(const std::vector<uint64_t>& bits, int row, int columnCount, Func&& func)
+	{
+		const int begin = row * columnCount;
+		const int end = begin + columnCount;
+		for (int index = begin; index < end;)
+		{
+			int word = index >> 6;
+			uint64_t set = bits[word] & (~uint64_t{0} << (index & 63));
+			while (set == 0)
+			{
+				if (++word * 64 >= end)
+				{
+					return;
+				}
+				set = bits[word];
+			}
+			const int first = word * 64 + std::countr_zero(set);
+			if (first >= end)
+			{
+				return;
+			}
+
+			// first 뒤로 처음 꺼진 비트를 찾는다. 행 끝까지 켜져 있으면 행 끝에서 자른다.
+			uint64_t clear = ~bits[word] & (~uint64_t{0} << (first & 63));
+			while (clear == 0 && ++word * 64 < end)
+			{
+				clear = ~bits[word];
+			}
+			const int last = clear == 0 ? end : std::min(end, word * 64 + std::countr_zero(clear));
+			func(first - begin, last - first);
+			index = last;
+		}
+	}
+} // namespace
+
+PathfindingLayer::PathfindingLayer()
+	: worker_([this]() { WorkerLoop(); })
+{
+	// 워커는 첫 pendingSteps_ 전까지 탐색을 만지지 않는다.
+	search_.GetChangeLog().SetEnabled(true);
+	replanner_.GetChangeLog().SetEnabled(true);
+	bidirectional_.GetChangeLog(ESearchDirection::Forward).SetEnabled(true);
+	bidirectional_.GetChangeLog(ESearchDirection::Backward).SetEnabled(true);
+}
+PathfindingLayer::~PathfindingLayer()
+{
+	bStopping_ = true;
+	pendingSteps_ = 1;
+	pendingSteps_.notify_one();
+	worker_.join();
+}
 void PathfindingLayer::OnInit()
 {
 	const Application::Settings& settings = Application::GetInstance().GetSettings();
 	auto& framebufferManager = ResourceManager<Framebuffer>::GetInstance();
 	framebufferManager.GetOrCreate("Viewport", settings.Width, settings.Height);
 }
-void PathfindingLayer::GenerateRandomWalls(int rowCount, int columnCount)
-{
-	for (int i = 0; i < rowCount * columnCount * 0.3f; ++i)
-	{
-		const int randRow = rand() % rowCount;
-		const int randCol = rand() % columnCount;
-		grid_[randRow][randCol].Type = ETileType::Wall;
-	}
-}
 void PathfindingLayer::RebuildGrid(int rowCount, int columnCount, int startRow, int startColumn, int endRow,
 								   int endColumn, EHeuristicMethod::Type method)
 {
-
-	grid_.clear();
-	grid_.resize(rowCount, std::vector<Node>(columnCount));
-	for (int row = 0; row < rowCount; ++row)
+	PATHFINDING_ZONE("PathfindingLayer::RebuildGrid");
+	grid_.Resize(rowCount, columnCount);
+	// 실행할 때마다 같은 순서의 맵이 나오고, Rebuild할 때마다 다음 맵으로 넘어간다.
+	grid_.GenerateRandomWalls(PathfindingConfig::WALL_DENSITY, mapSeed_++);
+	mapFile_.Close();
+
+	grid_.SetTileType(startRow, startColumn, ETileType::Path);
+	grid_.SetTileType(endRow, endColumn, ETileType::Path);
+	connectivity_.Build();
+	bLandmarksDirty_ = true;
+	bTileRunsDirty_ = true;
+}
+void PathfindingLayer::StepPathfinding(const SearchBudget& budget)
+{
+	PATHFINDING_ZONE("PathfindingLayer::StepPathfinding");
+	const std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+	if (IsReplanning())
 	{
-		for (int column = 0; column < columnCount; ++column)
+		for (int i = 0; i < budget.MaxNodes && !replanner_.IsFinished(); ++i)
 		{
-			grid_[row][column].Row = row;
-			grid_[row][column].Column = column;
+			replanner_.Step();
 		}
+		// A* 계열은 AStarSearch::Advance가 같은 이름으로 남긴다.
+		PATHFINDING_PLOT("Nodes Expanded", replanner_.GetExpandedCount());
+		PATHFINDING_PLOT("Open List Size", replanner_.GetOpenListSize());
 	}
-
-	GenerateRandomWalls(rowCount, columnCount);
-
-	grid_[startRow][startColumn].Type = ETileType::Path;
-	grid_[endRow][endColumn].Type = ETileType::Path;
-}
-void PathfindingLayer::StepPathfinding(int rowCount, int columnCount, int endRow, int endColumn,
-									   EHeuristicMethod::Type method)
-{
-	if (!openSet_.empty() && !bPathFound_)
+	else if (IsBidirectional())
 	{
-		Node* current = openSet_.top();
-		openSet_.pop();
-		if (current->bClosed)
+		for (int i = 0; i < budget.MaxNodes && !bidirectional_.IsFinished(); ++i)
 		{
-			return;
+			bidirectional_.Step();
 		}
-		current->bClosed = true;
-		if (current->Row == endRow && current->Column == endColumn)
+		PATHFINDING_PLOT("Nodes Expanded", bidirectional_.GetStats().NodesExpanded);
+		PATHFINDING_PLOT("Open List Size", bidirectional_.GetOpenListSize());
+	}
+	else
+	{
+		search_.Advance(budget);
+		// 경로를 찾은 뒤 한 번만 웨이포인트로 줄여 둔다.
+		if (search_.IsPathFound() && !bWaypointsBuilt_)
 		{
-			bPathFound_ = true;
-			return;
-		}
-
-		const bool bAllowDiagonals = method != EHeuristicMethod::Manhattan;
-		const std::vector<Node*> neighbors
-			= GetNeighbors(current->Row, current->Column, rowCount, columnCount, bAllowDiagonals);
-		for (Node* neighbor : neighbors)
-		{
-			if (!neighbor->IsWalkable() || neighbor->bClosed)
-			{
-				continue;
-			}
-			int walkCost = GetWalkCost(neighbor->Type);
-			float newCost = current->GCost + walkCost;
-			if (newCost < neighbor->GCost)
-			{
-				neighbor->GCost = newCost;
-				neighbor->HCost = CalculateHeuristicCost(neighbor->Row, neighbor->Column, endRow, endColumn, method);
-				neighbor->Parent = current;
-				openSet_.push(neighbor);
-			}
+			search_.BuildPath(path_);
+			BuildWaypoints(grid_, path_);
+			bWaypointsBuilt_ = true;
 		}
 	}
+	searchTime_ += std::chrono::steady_clock::now() - begin;
 }
 
 void PathfindingLayer::DrawGridLines(Renderer& renderer, int rowCount, int columnCount, int cellSize)
 {
+	PATHFINDING_ZONE("PathfindingLayer::DrawGridLines");
 	const float gridHalfWidth = columnCount * cellSize / 2.0f;
 	const float gridHalfHeight = (rowCount * cellSize) / 2.0f;
+	auto drawLine = [&](const glm::vec2& start, const glm::vec2& end)
+	{ renderer.DrawLine(start, end, PathfindingConfig::Colors::GRID_LINE, PathfindingConfig::GRID_LINE_WIDTH); };
+	// row, column 셀의 왼쪽 위 꼭짓점
+	auto corner = [&](int row, int column)
+	{ return glm::vec2(-gridHalfWidth + column * cellSize, gridHalfHeight - row * cellSize); };
 
-	for (int column = 0; column <= columnCount; ++column)
+	for (int row = 0; row <= rowCount; ++row)
 	{
-		const glm::vec2 start = glm::vec2(-gridHalfWidth, -gridHalfHeight + column * cellSize);
-		const glm::vec2 end = glm::vec2(gridHalfWidth, -gridHalfHeight + column * cellSize);
-		renderer.DrawLine(start, end, PathfindingConfig::Colors::GRID_LINE, PathfindingConfig::GRID_LINE_WIDTH);
+		drawLine(corner(row, 0), corner(row, columnCount));
 	}
-	for (int row = 0; row <= rowCount; ++row)
+	for (int column = 0; column <= columnCount; ++column)
 	{
-		const glm::vec2 start = glm::vec2(-gridHalfWidth + row * cellSize, -gridHalfHeight);
-		const glm::vec2 end = glm::vec2(-gridHalfWidth + row * cellSize, gridHalfHeight);
-		renderer.DrawLine(start, end, PathfindingConfig::Colors::GRID_LINE, PathfindingConfig::GRID_LINE_WIDTH);
+		drawLine(corner(0, column), corner(rowCount, column));
 	}
 
-	for (int row = 0; row < rowCount; ++row)
+	// 셀마다 그리던 두 대각선은 이웃 셀의 대각선과 한 직선으로 이어지므로 대각선 하나를 선 하나로 그린다.
+	// 왼쪽 위에서 오른쪽 아래로 가는 선은 column - row가, 오른쪽 위에서 왼쪽 아래로 가는 선은 row + column이 같다.
+	for (int offset = 1 - rowCount; offset < columnCount; ++offset)
 	{
-		for (int column = 0; column < columnCount; ++column)
-		{
-			glm::vec2 center = GridToWorldPosition(row, column, rowCount, columnCount, cellSize);
-			glm::vec2 leftTop = glm::vec2(center.x - cellSize * 0.5f, center.y + cellSize * 0.5f);
-			glm::vec2 rightBottom = leftTop + glm::vec2(cellSize, -cellSize);
-			glm::vec2 rightTop = glm::vec2(center.x + cellSize * 0.5f, center.y + cellSize * 0.5f);
-			glm::vec2 leftBottom = rightTop + glm::vec2(-cellSize, -cellSize);
-
-			renderer.DrawLine(leftTop, rightBottom, PathfindingConfig::Colors::GRID_LINE,
-							  PathfindingConfig::GRID_LINE_WIDTH);
-			renderer.DrawLine(rightTop, leftBottom, PathfindingConfig::Colors::GRID_LINE,
-							  PathfindingConfig::GRID_LINE_WIDTH);
-		}
+		const int firstRow = std::max(0, -offset);
+		const int length = std::min(rowCount - firstRow, columnCount - (firstRow + offset));
+		drawLine(corner(firstRow, firstRow + offset), corner(firstRow + length, firstRow + offset + length));
 	}
-}
-void PathfindingLayer::DrawCurrentPath(Renderer& renderer, int rowCount, int columnCount, int cellSize, int endRow,
-									   int endColumn)
-{
-	Node* current = nullptr;
-	if (bPathFound_)
+	for (int sum = 0; sum < rowCount + columnCount - 1; ++sum)
 	{
-		current = &grid_[endRow][endColumn];
+		const int firstRow = std::max(0, sum - (columnCount - 1));
+		const int length = std::min(rowCount - firstRow, sum - firstRow + 1);
+		drawLine(corner(firstRow, sum - firstRow + 1), corner(firstRow + length, sum - firstRow + 1 - length));
 	}
-	else
+}
+void PathfindingLayer::DrawCurrentPath(Renderer& renderer, const SearchSnapshot& snapshot, int rowCount,
+									   int columnCount, int cellSize)
+{
+	PATHFINDING_ZONE("PathfindingLayer::DrawCurrentPath");
+	for (const std::vector<GridPosition>& path : snapshot.Paths)
 	{
-		if (openSet_.empty())
+		for (size_t i = 1; i < path.size(); ++i)
 		{
-			return;
+			renderer.DrawLine(
+				GridToWorldPosition(path[i - 1].Row, path[i - 1].Column, rowCount, columnCount, cellSize),
+				GridToWorldPosition(path[i].Row, path[i].Column, rowCount, columnCount, cellSize),
+				PathfindingConfig::Colors::PATH_LINE, PathfindingConfig::PATH_LINE_WIDTH);
 		}
-		current = openSet_.top();
-	}
-
-	int currentRow = current->Row;
-	int currentCol = current->Column;
-	while (Node* parent = grid_[currentRow][currentCol].Parent)
-	{
-
-		renderer.DrawLine(GridToWorldPosition(currentRow, currentCol, rowCount, columnCount, cellSize),
-						  GridToWorldPosition(parent->Row, parent->Column, rowCount, columnCount, cellSize),
-						  PathfindingConfig::Colors::PATH_LINE, PathfindingConfig::PATH_LINE_WIDTH);
-		currentRow = parent->Row;
-		currentCol = parent->Column;
 	}
 }
 void PathfindingLayer::DrawClosedNodes(Renderer& renderer, int rowCount, int columnCount, int cellSize)
 {
-	for (int row = 0; row < rowCount; ++row)
+	PATHFINDING_ZONE("PathfindingLayer::DrawClosedNodes");
+	// 가로로 이어진 셀은 사각형 하나로 그린다. 탐색이 퍼진 영역은 행마다 몇 개의 구간이 된다.
+	for (int row = 0; row < static_cast<int>(searchRuns_.size()); ++row)
 	{
-		for (int column = 0; column < columnCount; ++column)
+		for (const CellRun& run : searchRuns_[row].Closed)
 		{
-			if (!grid_[row][column].bClosed)
-			{
-				continue;
-			}
-
-			glm::ivec2 position = GridToWorldPosition(row, column, rowCount, columnCount, cellSize);
-			renderer.DrawRectangle(position, 0.0f, glm::vec2(cellSize, cellSize),
+			const glm::vec2 first = GridToWorldPosition(row, run.FirstColumn, rowCount, columnCount, cellSize);
+			const glm::vec2 center(first.x + (run.Count - 1) * cellSize * 0.5f, first.y);
+			renderer.DrawRectangle(center, 0.0f, glm::vec2(run.Count * cellSize, cellSize),
 								   PathfindingConfig::Colors::CLOSED_NODE, false);
 		}
 	}
@@ -169,55 +198,126 @@ void PathfindingLayer::DrawClosedNodes(Renderer& renderer, int rowCount, int col
 
 void PathfindingLayer::DrawOpenNodes(Renderer& renderer, int rowCount, int columnCount, int cellSize)
 {
-	std::priority_queue<Node*, std::vector<Node*>, NodeComparator> tempOpenSet = openSet_;
-	while (!tempOpenSet.empty())
+	PATHFINDING_ZONE("PathfindingLayer::DrawOpenNodes");
+	for (int row = 0; row < static_cast<int>(searchRuns_.size()); ++row)
 	{
-		Node* node = tempOpenSet.top();
-		tempOpenSet.pop();
-
-		glm::ivec2 position = GridToWorldPosition(node->Row, node->Column, rowCount, columnCount, cellSize);
-		renderer.DrawRectangle(position, 0.0f, glm::vec2(cellSize, cellSize), PathfindingConfig::Colors::OPEN_NODE,
-							   false);
+		for (const CellRun& run : searchRuns_[row].Open)
+		{
+			const glm::vec2 first = GridToWorldPosition(row, run.FirstColumn, rowCount, columnCount, cellSize);
+			const glm::vec2 center(first.x + (run.Count - 1) * cellSize * 0.5f, first.y);
+			renderer.DrawRectangle(center, 0.0f, glm::vec2(run.Count * cellSize, cellSize),
+								   PathfindingConfig::Colors::OPEN_NODE, false);
+		}
 	}
 }
 
-void PathfindingLayer::OnUpdate(float deltaTime)
+void PathfindingLayer::UpdateSearchRuns(const SearchSnapshot& snapshot)
 {
-	if (bIsPaused_)
+	PATHFINDING_ZONE("PathfindingLayer::UpdateSearchRuns");
+	if (static_cast<int>(searchRuns_.size()) != snapshot.RowCount)
 	{
-		return;
+		// 사본의 버전은 1부터이므로 새로 만든 행은 모두 다시 읽는다.
+		searchRuns_.assign(snapshot.RowCount, {});
 	}
+	for (int row = 0; row < snapshot.RowCount; ++row)
+	{
+		SearchRowRuns& runs = searchRuns_[row];
+		if (runs.Version == snapshot.RowVersions[row])
+		{
+			continue;
+		}
+		runs.Version = snapshot.RowVersions[row];
+		runs.Closed.clear();
+		runs.Open.clear();
+		ForEachSetRun(snapshot.ClosedBits, row, snapshot.ColumnCount,
+					  [&](int firstColumn, int count) { runs.Closed.push_back({firstColumn, count}); });
+		ForEachSetRun(snapshot.OpenBits, row, snapshot.ColumnCount,
+					  [&](int firstColumn, int count) { runs.Open.push_back({firstColumn, count}); });
+	}
+}
 
+void PathfindingLayer::OnUpdate(float deltaTime)
+{
 	std::shared_ptr<MapData> mapData = mapDataWeak_.lock();
 	if (!mapData)
 	{
 		return;
 	}
+	// 일시정지 중에도 Step이나 타일 토글로 발행된 사본의 통계는 받는다.
+	const SearchSnapshot& snapshot = snapshots_.Acquire();
+	mapData->StatsHistory.Update(snapshot.QueryId, snapshot.Stats, snapshot.bFinished);
 
-	float interval = PathfindingConfig::BASE_STEP_INTERVAL / mapData->SimulationSpeed;
+	if (bIsPaused_)
+	{
+		return;
+	}
 
+	// 지난 프레임 이후 쌓인 시간만큼의 확장을 워커에 넘긴다. 워커가 따라가지 못하면 1초 분량까지만 쌓는다.
+	const float interval = PathfindingConfig::BASE_STEP_INTERVAL / mapData->SimulationSpeed;
 	accumulatedTime_ += deltaTime;
-	if (accumulatedTime_ >= interval)
+	const int stepCount = static_cast<int>(accumulatedTime_ / interval);
+	if (stepCount <= 0)
+	{
+		return;
+	}
+	accumulatedTime_ -= stepCount * interval;
+	if (bSearchFinished_)
 	{
-		StepPathfinding(mapData->RowCount, mapData->ColumnCount, mapData->EndRow, mapData->EndColumn,
-						mapData->HeuristicMethod);
-		accumulatedTime_ = 0.0f;
+		return;
+	}
+	const int maxPendingCount = std::max(static_cast<int>(1.0f / interval), 1);
+	const int pendingCount = pendingSteps_.load();
+	if (pendingCount < maxPendingCount)
+	{
+		pendingSteps_.fetch_add(std::min(stepCount, maxPendingCount - pendingCount));
+		pendingSteps_.notify_one();
 	}
 }
 void PathfindingLayer::DrawTiles(Renderer& renderer, int rowCount, int columnCount, int cellSize)
 {
-
-	for (int row = 0; row < rowCount; ++row)
+	PATHFINDING_ZONE("PathfindingLayer::DrawTiles");
+	if (bTileRunsDirty_ || static_cast<int>(tileRuns_.size()) != grid_.GetRowCount())
 	{
+		tileRuns_.resize(grid_.GetRowCount());
+		for (int row = 0; row < grid_.GetRowCount(); ++row)
+		{
+			BuildTileRuns(row);
+		}
+		bTileRunsDirty_ = false;
+	}
 
-		for (int column = 0; column < columnCount; ++column)
+	const int drawRowCount = std::min(rowCount, static_cast<int>(tileRuns_.size()));
+	for (int row = 0; row < drawRowCount; ++row)
+	{
+		for (const TileRun& run : tileRuns_[row])
 		{
-			const Node& node = grid_[row][column];
-			const glm::ivec2 position = GridToWorldPosition(row, column, rowCount, columnCount, cellSize);
-			renderer.DrawRectangle(position, 0.0f, glm::vec2(cellSize, cellSize), GetTileColor(node.Type), false);
+			const glm::vec2 first = GridToWorldPosition(row, run.FirstColumn, rowCount, columnCount, cellSize);
+			const glm::vec2 center(first.x + (run.Count - 1) * cellSize * 0.5f, first.y);
+			renderer.DrawRectangle(center, 0.0f, glm::vec2(run.Count * cellSize, cellSize), GetTileColor(run.Type),
+								   false);
 		}
 	}
 }
+void PathfindingLayer::BuildTileRuns(int row)
+{
+	std::vector<TileRun>& runs = tileRuns_[row];
+	runs.clear();
+	const int columnCount = grid_.GetColumnCount();
+	for (int column = 0; column < columnCount;)
+	{
+		const ETileType type = grid_.GetTileType(row, column);
+		int endColumn = column + 1;
+		while (endColumn < columnCount && grid_.GetTileType(row, endColumn) == type)
+		{
+			++endColumn;
+		}
+		if (type != ETileType::Path)
+		{
+			runs.push_back({column, endColumn - column, type});
+		}
+		column = endColumn;
+	}
+}
 void PathfindingLayer::DrawStartAndEnd(Renderer& renderer, int startRow, int startColumn, int endRow, int endColumn,
 									   int rowCount, int columnCount, int cellSize)
 {
@@ -228,6 +328,7 @@ void PathfindingLayer::DrawStartAndEnd(Renderer& renderer, int startRow, int sta
 }
 void PathfindingLayer::OnRender(Renderer& renderer)
 {
+	PATHFINDING_ZONE("PathfindingLayer::OnRender");
 	auto& framebufferManager = ResourceManager<Framebuffer>::GetInstance();
 	auto framebuffer = framebufferManager.Get("Viewport");
 
@@ -254,68 +355,17 @@ void PathfindingLayer::OnRender(Renderer& renderer)
 	DrawGridLines(renderer, rowCount, columnCount, cellSize);
 	DrawTiles(renderer, rowCount, columnCount, cellSize);
 	DrawStartAndEnd(renderer, startRow, startColumn, endRow, endColumn, rowCount, columnCount, cellSize);
-	DrawClosedNodes(renderer, rowCount, columnCount, cellSize);
-	DrawCurrentPath(renderer, rowCount, columnCount, cellSize, endRow, endColumn);
-	DrawOpenNodes(renderer, rowCount, columnCount, cellSize);
-
-	renderer.EndScene();
-}
-
-std::vector<Node*> PathfindingLayer::GetNeighbors(int row, int column, int rowCount, int columnCount,
-												  bool bAllowDiagonals)
-{
-	std::vector<Node*> neighbors;
-	neighbors.reserve(bAllowDiagonals ? 8 : 4);
-
-	// 직교 방향 먼저 확인
-	const bool bCanUp = row - 1 >= 0 && grid_[row - 1][column].IsWalkable();
-	const bool bCanDown = row + 1 < rowCount && grid_[row + 1][column].IsWalkable();
-	const bool bCanLeft = column - 1 >= 0 && grid_[row][column - 1].IsWalkable();
-	const bool bCanRight = column + 1 < columnCount && grid_[row][column + 1].IsWalkable();
-
-	// 직교 이웃 추가
-	if (row - 1 >= 0)
-	{
-		neighbors.push_back(&grid_[row - 1][column]);
-	}
-	if (row + 1 < rowCount)
+	// 이벤트가 맵을 바꾸면 같은 잠금 안에서 새 사본을 발행하므로, 크기가 다른 사본은 첫 발행 전에만 보인다.
+	const SearchSnapshot& snapshot = snapshots_.Acquire();
+	if (snapshot.RowCount == grid_.GetRowCount() && snapshot.ColumnCount == grid_.GetColumnCount())
 	{
-		neighbors.push_back(&grid_[row + 1][column]);
-	}
-	if (column - 1 >= 0)
-	{
-		neighbors.push_back(&grid_[row][column - 1]);
-	}
-	if (column + 1 < columnCount)
-	{
-		neighbors.push_back(&grid_[row][column + 1]);
+		UpdateSearchRuns(snapshot);
+		DrawClosedNodes(renderer, rowCount, columnCount, cellSize);
+		DrawCurrentPath(renderer, snapshot, rowCount, columnCount, cellSize);
+		DrawOpenNodes(renderer, rowCount, columnCount, cellSize);
 	}
 
-	if (bAllowDiagonals)
-	{
-		// 대각선은 인접한 두 직교 방향이 모두 통과 가능할 때만
-		if (bCanUp && bCanLeft && row - 1 >= 0 && column - 1 >= 0)
-		{
-			neighbors.push_back(&grid_[row - 1][column - 1]);
-		}
-
-		if (bCanUp && bCanRight && row - 1 >= 0 && column + 1 < columnCount)
-		{
-			neighbors.push_back(&grid_[row - 1][column + 1]);
-		}
-
-		if (bCanDown && bCanLeft && row + 1 < rowCount && column - 1 >= 0)
-		{
-			neighbors.push_back(&grid_[row + 1][column - 1]);
-		}
-
-		if (bCanDown && bCanRight && row + 1 < rowCount && column + 1 < columnCount)
-		{
-			neighbors.push_back(&grid_[row + 1][column + 1]);
-		}
-	}
-
-	return neighbors;
+	renderer.EndScene();
 }
 
 glm::vec2 PathfindingLayer::GridToWorldPosition(int row, int column, int rowCount, int columnCount, int cellSize)
@@ -335,52 +385,24 @@ glm::vec4 PathfindingLayer::GetTileColor(ETileType type) const
 		return PathfindingConfig::Colors::PATH_TILE;
 	case ETileType::Wall:
 		return PathfindingConfig::Colors::WALL_TILE;
+	case ETileType::Swamp:
+		return PathfindingConfig::Colors::SWAMP_TILE;
+	case ETileType::Water:
+		return PathfindingConfig::Colors::WATER_TILE;
 	default:
 		return PathfindingConfig::Colors::PATH_TILE;
 	}
 }
-float PathfindingLayer::GetWalkCost(ETileType type) const
-{
-	switch (type)
-	{
-	case ETileType::Path:
-		return PathfindingConfig::ORTHOGONAL_COST;
-	case ETileType::Wall:
-		return PathfindingConfig::IMPASSABLE_COST;
-	default:
-		return PathfindingConfig::ORTHOGONAL_COST;
-	}
-}
-
-float PathfindingLayer::CalculateHeuristicCost(int rowStart, int columnStart, int rowEnd, int columnEnd,
-											   EHeuristicMethod::Type method) const
-{
-	const int deltaRow = abs(rowStart - rowEnd);
-	const int deltaCol = abs(columnStart - columnEnd);
-	switch (method)
-	{
-	case EHeuristicMethod::None:
-		return 0.0f;
-	case EHeuristicMethod::Manhattan:
-		return static_cast<float>(deltaRow + deltaCol);
-	case EHeuristicMethod::Euclidean:
-		return sqrtf(static_cast<float>(deltaRow * deltaRow + deltaCol * deltaCol));
-	case EHeuristicMethod::Octile:
-		return static_cast<float>(std::min(deltaRow, deltaCol)) * PathfindingConfig::DIAGONAL_COST
-			   + std::abs(static_cast<float>(deltaRow - deltaCol));
-	default:
-		return 0.0f;
-	}
-}
 void PathfindingLayer::OnMapRefChanged(const std::weak_ptr<MapData>& weak)
 {
 	mapDataWeak_ = weak;
 	if (std::shared_ptr<MapData> mapData = mapDataWeak_.lock())
 	{
+		std::lock_guard<std::mutex> lock(searchMutex_);
 		RebuildGrid(mapData->RowCount, mapData->ColumnCount, mapData->StartRow, mapData->StartColumn, mapData->EndRow,
 					mapData->EndColumn, mapData->HeuristicMethod);
 		ResetPathfinding(mapData->StartRow, mapData->StartColumn, mapData->EndRow, mapData->EndColumn,
-						 mapData->HeuristicMethod);
+						 mapData->Algorithm, mapData->HeuristicMethod, mapData->OpenListType);
 	}
 }
 
@@ -391,49 +413,496 @@ void PathfindingLayer::OnStartEvent()
 void PathfindingLayer::OnPauseEvent()
 {
 	bIsPaused_ = true;
+	pendingSteps_ = 0;
 }
 void PathfindingLayer::ResetPathfinding(int startRow, int startColumn, int endRow, int endColumn,
-										EHeuristicMethod::Type method)
+										ESearchAlgorithm::Type algorithm, EHeuristicMethod::Type method,
+										EOpenListType::Type openListType)
 {
-	bPathFound_ = false;
-
-	for (std::vector<Node>& row : grid_)
+	PATHFINDING_ZONE("PathfindingLayer::ResetPathfinding");
+	algorithm_ = algorithm;
+	heuristicMethod_ = method;
+	bWaypointsBuilt_ = false;
+	++queryId_;
+	searchTime_ = {};
+	if (IsReplanning())
+	{
+		replanner_.Reset({startRow, startColumn}, {endRow, endColumn}, method);
+	}
+	else if (IsBidirectional())
 	{
-		for (Node& node : row)
+		bidirectional_.SetConnectivity(&connectivity_);
+		bidirectional_.Reset({startRow, startColumn}, {endRow, endColumn}, method);
+	}
+	else
+	{
+		// 랜드마크 표는 맵 전체를 탐색해 만들므로 ALT를 고른 경우에만, 맵이 바뀐 뒤 처음 Reset할 때 만든다.
+		if (method == EHeuristicMethod::ALT && bLandmarksDirty_)
 		{
-			node.Reset();
+			landmarks_.Build(grid_);
+			bLandmarksDirty_ = false;
 		}
+		search_.SetLandmarks(&landmarks_);
+		search_.SetConnectivity(&connectivity_);
+		search_.SetAlgorithm(algorithm);
+		search_.SetOpenListType(openListType);
+		search_.Reset({startRow, startColumn}, {endRow, endColumn}, method);
 	}
-
-	Node& start = grid_[startRow][startColumn];
-	start.GCost = 0;
-	start.HCost = CalculateHeuristicCost(startRow, startColumn, endRow, endColumn, method);
-	openSet_ = std::priority_queue<Node*, std::vector<Node*>, NodeComparator>();
-	openSet_.push(&start);
+	PublishSnapshot();
 }
 void PathfindingLayer::OnResetEvent()
 {
 	if (std::shared_ptr<MapData> mapData = mapDataWeak_.lock())
 	{
+		std::lock_guard<std::mutex> lock(searchMutex_);
 		ResetPathfinding(mapData->StartRow, mapData->StartColumn, mapData->EndRow, mapData->EndColumn,
-						 mapData->HeuristicMethod);
+						 mapData->Algorithm, mapData->HeuristicMethod, mapData->OpenListType);
 	}
 }
 void PathfindingLayer::OnStepEvent()
 {
 	if (std::shared_ptr<MapData> mapData = mapDataWeak_.lock())
 	{
-		StepPathfinding(mapData->RowCount, mapData->ColumnCount, mapData->EndRow, mapData->EndColumn,
-						mapData->HeuristicMethod);
+		std::lock_guard<std::mutex> lock(searchMutex_);
+		StepPathfinding({1, {}});
+		PublishSnapshot();
 	}
 }
 void PathfindingLayer::OnRebuildEvent()
 {
 	if (std::shared_ptr<MapData> mapData = mapDataWeak_.lock())
 	{
+		std::lock_guard<std::mutex> lock(searchMutex_);
 		RebuildGrid(mapData->RowCount, mapData->ColumnCount, mapData->StartRow, mapData->StartColumn, mapData->EndRow,
 					mapData->EndColumn, mapData->HeuristicMethod);
 		ResetPathfinding(mapData->StartRow, mapData->StartColumn, mapData->EndRow, mapData->EndColumn,
-						 mapData->HeuristicMethod);
+						 mapData->Algorithm, mapData->HeuristicMethod, mapData->OpenListType);
+	}
+}
+void PathfindingLayer::OnViewportClicked(float x, float y)
+{
+	std::shared_ptr<MapData> mapData = mapDataWeak_.lock();
+	if (!mapData)
+	{
+		return;
+	}
+
+	const int cellSize = mapData->CellSize;
+	const float gridHalfWidth = grid_.GetColumnCount() * cellSize / 2.0f;
+	const float gridHalfHeight = grid_.GetRowCount() * cellSize / 2.0f;
+	const int row = static_cast<int>(std::floor((gridHalfHeight - y) / cellSize));
+	const int column = static_cast<int>(std::floor((x + gridHalfWidth) / cellSize));
+	if (!grid_.IsInBounds(row, column))
+	{
+		return;
+	}
+
+	// 시작/도착 셀은 벽으로 바꾸지 않는다.
+	const bool bIsStart = row == mapData->StartRow && column == mapData->StartColumn;
+	const bool bIsEnd = row == mapData->EndRow && column == mapData->EndColumn;
+	if (bIsStart || bIsEnd)
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(searchMutex_);
+	ToggleTile(row, column, mapData->PaintTile);
+	if (IsReplanning())
+	{
+		PublishSnapshot();
+	}
+	else
+	{
+		ResetPathfinding(mapData->StartRow, mapData->StartColumn, mapData->EndRow, mapData->EndColumn,
+						 mapData->Algorithm, mapData->HeuristicMethod, mapData->OpenListType);
+	}
+}
+void PathfindingLayer::ToggleTile(int row, int column, ETileType type)
+{
+	PATHFINDING_ZONE("PathfindingLayer::ToggleTile");
+	grid_.SetTileType(row, column, grid_.GetTileType(row, column) == type ? ETileType::Path : type);
+	connectivity_.OnTileChanged(row, column);
+	bLandmarksDirty_ = true;
+	if (!bTileRunsDirty_ && row < static_cast<int>(tileRuns_.size()))
+	{
+		BuildTileRuns(row);
+	}
+	if (IsReplanning())
+	{
+		// 수리는 새 쿼리로 기록한다. D* Lite의 통계와 시간은 Reset 이후의 누적이다.
+		replanner_.OnTileChanged(row, column);
+		++queryId_;
+	}
+}
+void PathfindingLayer::OnLoadMapEvent(const std::string& path)
+{
+	PATHFINDING_ZONE("PathfindingLayer::OnLoadMapEvent");
+	std::shared_ptr<MapData> mapData = mapDataWeak_.lock();
+	if (!mapData)
+	{
+		return;
+	}
+
+	// 파일을 읽는 동안에도 워커는 멈춘다. grid_를 바꾸기 전에 워커가 조각을 끝내야 하기 때문이다.
+	std::lock_guard<std::mutex> lock(searchMutex_);
+	GridPosition start;
+	GridPosition end;
+	const bool bMovingAIMap = path.size() >= 4 && path.compare(path.size() - 4, 4, ".map") == 0;
+	if (bMovingAIMap)
+	{
+		Grid loadedGrid;
+		if (!LoadMovingAIMap(path, loadedGrid, mapData->MapFileError))
+		{
+			return;
+		}
+		grid_ = std::move(loadedGrid);
+		mapFile_.Close();
+
+		// .map에는 시작/도착 정보가 없으므로 현재 위치를 맵 안으로 옮기고 통과 가능하게 만든다.
+		start = {std::min(mapData->StartRow, grid_.GetRowCount() - 1),
+				 std::min(mapData->StartColumn, grid_.GetColumnCount() - 1)};
+		end = {std::min(mapData->EndRow, grid_.GetRowCount() - 1),
+			   std::min(mapData->EndColumn, grid_.GetColumnCount() - 1)};
+		grid_.SetTileType(start.Row, start.Column, ETileType::Path);
+		grid_.SetTileType(end.Row, end.Column, ETileType::Path);
+	}
+	else
+	{
+		MapFile mapFile;
+		if (!mapFile.Open(path))
+		{
+			mapData->MapFileError = mapFile.GetError();
+			return;
+		}
+		// grid_가 새 파일을 가리키게 한 뒤에 이전 파일을 닫는다.
+		grid_ = mapFile.GetGrid();
+		mapFile_ = std::move(mapFile);
+		start = mapFile_.GetStart();
+		end = mapFile_.GetEnd();
+	}
+
+	connectivity_.Build();
+	bLandmarksDirty_ = true;
+	bTileRunsDirty_ = true;
+	mapData->MapFileError.clear();
+	mapData->RowCount = grid_.GetRowCount();
+	mapData->ColumnCount = grid_.GetColumnCount();
+	mapData->StartRow = start.Row;
+	mapData->StartColumn = start.Column;
+	mapData->EndRow = end.Row;
+	mapData->EndColumn = end.Column;
+	ResetPathfinding(mapData->StartRow, mapData->StartColumn, mapData->EndRow, mapData->EndColumn,
+					 mapData->Algorithm, mapData->HeuristicMethod, mapData->OpenListType);
+}
+void PathfindingLayer::OnSaveMapEvent(const std::string& path)
+{
+	std::shared_ptr<MapData> mapData = mapDataWeak_.lock();
+	if (!mapData)
+	{
+		return;
+	}
+
+	if (MapFile::Save(path, grid_, {mapData->StartRow, mapData->StartColumn}, {mapData->EndRow, mapData->EndColumn}))
+	{
+		mapData->MapFileError.clear();
+	}
+	else
+	{
+		mapData->MapFileError = "cannot write " + path;
+	}
+}
+
+bool PathfindingLayer::IsSearchFinished() const
+{
+	if (IsReplanning())
+	{
+		return replanner_.IsFinished();
+	}
+	return IsBidirectional() ? bidirectional_.IsFinished() : search_.IsFinished();
+}
+void PathfindingLayer::WorkerLoop()
+{
+	tracy::SetThreadName("Search Worker");
+	while (true)
+	{
+		pendingSteps_.wait(0);
+		if (bStopping_)
+		{
+			return;
+		}
+		// 남은 확장 수에서 한 조각만큼 가져온다. 그 사이 일시정지가 0으로 되돌려도 음수가 되지 않는다.
+		int pendingCount = pendingSteps_.load();
+		int count = 0;
+		do
+		{
+			count = std::min(pendingCount, PathfindingConfig::WORKER_SLICE_NODE_COUNT);
+		} while (count > 0 && !pendingSteps_.compare_exchange_weak(pendingCount, pendingCount - count));
+		if (count <= 0)
+		{
+			continue;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(searchMutex_);
+			if (IsSearchFinished())
+			{
+				pendingSteps_ = 0;
+			}
+			else
+			{
+				StepPathfinding({count, {}});
+				if (IsSearchFinished() || std::chrono::steady_clock::now() >= nextSnapshotTime_)
+				{
+					PublishSnapshot();
+				}
+			}
+		}
+		// 잠금을 기다리는 이벤트가 먼저 잡을 수 있게 한다.
+		std::this_thread::yield();
+	}
+}
+void PathfindingLayer::UpdateSearchView()
+{
+	PATHFINDING_ZONE("PathfindingLayer::UpdateSearchView");
+	const int rowCount = grid_.GetRowCount();
+	const int columnCount = grid_.GetColumnCount();
+	const int cellCount = grid_.GetCellCount();
+	const size_t wordCount = Grid::GetWordCount(rowCount, columnCount);
+	++viewVersion_;
+	bool bAllChanged = false;
+	if (closedBits_.size() != wordCount || static_cast<int>(rowVersions_.size()) != rowCount)
+	{
+		closedBits_.assign(wordCount, 0);
+		openBits_.assign(wordCount, 0);
+		rowVersions_.assign(rowCount, viewVersion_);
+		bAllChanged = true;
+	}
+
+	// 알고리즘 분기는 셀마다가 아니라 한 번만 한다.
+	auto refresh = [&](auto isClosed, auto isOpen, std::initializer_list<CellChangeLog*> changeLogs)
+	{
+		for (CellChangeLog* changeLog : changeLogs)
+		{
+			bAllChanged = bAllChanged || changeLog->HasAllChanged();
+		}
+		if (bAllChanged)
+		{
+			// 워드 단위로 다시 만들고, 바뀐 비트가 걸친 행만 버전을 올린다.
+			for (size_t word = 0; word < wordCount; ++word)
+			{
+				const int first = static_cast<int>(word * 64);
+				const int last = std::min(cellCount, first + 64);
+				uint64_t closed = 0;
+				uint64_t open = 0;
+				for (int index = first; index < last; ++index)
+				{
+					closed |= static_cast<uint64_t>(isClosed(index)) << (index - first);
+					open |= static_cast<uint64_t>(isOpen(index)) << (index - first);
+				}
+				const uint64_t changed = (closed ^ closedBits_[word]) | (open ^ openBits_[word]);
+				if (changed == 0)
+				{
+					continue;
+				}
+				closedBits_[word] = closed;
+				openBits_[word] = open;
+				const int lastRow = (first + 63 - std::countl_zero(changed)) / columnCount;
+				for (int row = (first + std::countr_zero(changed)) / columnCount; row <= lastRow; ++row)
+				{
+					rowVersions_[row] = viewVersion_;
+				}
+			}
+		}
+		else
+		{
+			for (CellChangeLog* changeLog : changeLogs)
+			{
+				for (int index : changeLog->GetCells())
+				{
+					const size_t word = static_cast<size_t>(index) >> 6;
+					const uint64_t bit = uint64_t{1} << (index & 63);
+					const uint64_t closed = isClosed(index) ? bit : 0;
+					const uint64_t open = isOpen(index) ? bit : 0;
+					if ((closedBits_[word] & bit) != closed || (openBits_[word] & bit) != open)
+					{
+						closedBits_[word] = (closedBits_[word] & ~bit) | closed;
+						openBits_[word] = (openBits_[word] & ~bit) | open;
+						rowVersions_[index / columnCount] = viewVersion_;
+					}
+				}
+			}
+		}
+		for (CellChangeLog* changeLog : changeLogs)
+		{
+			changeLog->Clear();
+		}
+	};
+	if (IsReplanning())
+	{
+		refresh([this](int index) { return replanner_.IsConsistent(index); },
+				[this](int index) { return replanner_.IsOpen(index); }, {&replanner_.GetChangeLog()});
+	}
+	else if (IsBidirectional())
+	{
+		refresh([this](int index) { return bidirectional_.IsClosed(index); },
+				[this](int index) { return bidirectional_.IsOpen(index); },
+				{&bidirectional_.GetChangeLog(ESearchDirection::Forward),
+				 &bidirectional_.GetChangeLog(ESearchDirection::Backward)});
+	}
+	else
+	{
+		refresh([this](int index) { return search_.IsClosed(index); },
+				[this](int index) { return search_.IsOpen(index); }, {&search_.GetChangeLog()});
+	}
+}
+void PathfindingLayer::PublishSnapshot()
+{
+	PATHFINDING_ZONE("PathfindingLayer::PublishSnapshot");
+	using Clock = std::chrono::steady_clock;
+	const Clock::time_point begin = Clock::now();
+	UpdateSearchView();
+	SearchSnapshot& snapshot = snapshots_.GetBack();
+	snapshot.RowCount = grid_.GetRowCount();
+	snapshot.ColumnCount = grid_.GetColumnCount();
+	const int cellCount = grid_.GetCellCount();
+
+	// 돌려 쓰는 버퍼는 두 번 전의 발행 내용을 갖고 있으므로 그 뒤로 버전이 바뀐 행만 복사한다.
+	// 행의 양 끝 워드는 이웃 행과 겹치지만 같은 원본에서 복사하므로 이웃 행의 내용은 그대로이다.
+	if (snapshot.RowVersions.size() != rowVersions_.size() || snapshot.ClosedBits.size() != closedBits_.size())
+	{
+		snapshot.ClosedBits = closedBits_;
+		snapshot.OpenBits = openBits_;
+		snapshot.RowVersions = rowVersions_;
+	}
+	else
+	{
+		for (int row = 0; row < snapshot.RowCount; ++row)
+		{
+			if (snapshot.RowVersions[row] == rowVersions_[row])
+			{
+				continue;
+			}
+			snapshot.RowVersions[row] = rowVersions_[row];
+			const size_t firstWord = static_cast<size_t>(row * snapshot.ColumnCount) >> 6;
+			const size_t lastWord = static_cast<size_t>((row + 1) * snapshot.ColumnCount - 1) >> 6;
+			std::copy(closedBits_.begin() + firstWord, closedBits_.begin() + lastWord + 1,
+					  snapshot.ClosedBits.begin() + firstWord);
+			std::copy(openBits_.begin() + firstWord, openBits_.begin() + lastWord + 1,
+					  snapshot.OpenBits.begin() + firstWord);
+		}
+	}
+
+	size_t pathCount = 0;
+	auto beginPath = [&]() -> std::vector<GridPosition>&
+	{
+		if (snapshot.Paths.size() <= pathCount)
+		{
+			snapshot.Paths.emplace_back();
+		}
+		std::vector<GridPosition>& path = snapshot.Paths[pathCount++];
+		path.clear();
+		return path;
+	};
+	auto appendChain = [&](int current, auto getNextIndex)
+	{
+		std::vector<GridPosition>& path = beginPath();
+		path.push_back({grid_.ToRow(current), grid_.ToColumn(current)});
+		// D* Lite는 탐색 도중 이웃 사이를 오갈 수 있으므로 셀 수만큼만 따라간다.
+		int remainingCount = cellCount;
+		for (int next = getNextIndex(current); next != SearchSpace::INVALID_INDEX && remainingCount > 0;
+			 next = getNextIndex(current), --remainingCount)
+		{
+			path.push_back({grid_.ToRow(next), grid_.ToColumn(next)});
+			current = next;
+		}
+	};
+
+	// A*는 부모를 따라 시작 셀로, D* Lite는 가장 싼 이웃을 따라 도착 셀로 간다.
+	// 양방향은 두 방향의 트리를 각각 따라가고, 경로를 찾았으면 두 사슬이 만난 셀에서 이어진다.
+	// 경로를 찾은 A* 계열은 부모 사슬 대신 줄 당기기로 줄인 웨이포인트를 잇는다.
+	if (IsBidirectional())
+	{
+		for (ESearchDirection direction : {ESearchDirection::Forward, ESearchDirection::Backward})
+		{
+			const int current = bidirectional_.GetCurrentIndex(direction);
+			if (current != SearchSpace::INVALID_INDEX)
+			{
+				appendChain(current,
+							[this, direction](int index) { return bidirectional_.GetParentIndex(direction, index); });
+			}
+		}
+	}
+	else if (bWaypointsBuilt_)
+	{
+		beginPath() = path_.Waypoints;
+	}
+	else
+	{
+		const int current = IsReplanning() ? replanner_.GetCurrentIndex() : search_.GetCurrentIndex();
+		if (current != SearchSpace::INVALID_INDEX)
+		{
+			appendChain(current, [this](int index)
+						{ return IsReplanning() ? replanner_.GetNextIndex(index) : search_.GetParentIndex(index); });
+		}
+	}
+	snapshot.Paths.resize(pathCount);
+	FillSearchStats(snapshot);
+
+	bSearchFinished_ = snapshot.bFinished;
+	snapshots_.Publish();
+	// 큰 맵에서는 사본을 만드는 데도 시간이 들므로 워커가 그 시간의 4배 이상은 탐색에 쓰게 한다.
+	const Clock::time_point end = Clock::now();
+	nextSnapshotTime_ = end + std::max<Clock::duration>(PathfindingConfig::SNAPSHOT_INTERVAL, (end - begin) * 4);
+}
+void PathfindingLayer::FillSearchStats(SearchSnapshot& snapshot)
+{
+	SearchStatsRecord& record = snapshot.Stats;
+	snapshot.QueryId = queryId_;
+	snapshot.bFinished = IsSearchFinished();
+	record.HeuristicMethod = heuristicMethod_;
+	if (IsReplanning())
+	{
+		record.Algorithm = ESearchAlgorithm::DStarLite;
+		record.OpenListType = EOpenListType::BinaryHeap;
+		record.bFound = replanner_.IsPathFound();
+		record.OpenListSize = replanner_.GetOpenListSize();
+		if (snapshot.bFinished)
+		{
+			replanner_.BuildPath(statsPath_);
+		}
+		record.Stats = snapshot.bFinished ? statsPath_.Stats : replanner_.GetStats();
+	}
+	else if (IsBidirectional())
+	{
+		record.Algorithm = ESearchAlgorithm::Bidirectional;
+		record.OpenListType = EOpenListType::BinaryHeap;
+		record.bFound = bidirectional_.IsPathFound();
+		record.OpenListSize = bidirectional_.GetOpenListSize();
+		if (snapshot.bFinished)
+		{
+			bidirectional_.BuildPath(statsPath_);
+		}
+		record.Stats = snapshot.bFinished ? statsPath_.Stats : bidirectional_.GetStats();
+	}
+	else
+	{
+		record.Algorithm = search_.GetActiveAlgorithm();
+		record.OpenListType = search_.GetActiveOpenListType();
+		record.bFound = search_.IsPathFound();
+		record.OpenListSize = search_.GetOpenListSize();
+		if (bWaypointsBuilt_)
+		{
+			record.Stats = path_.Stats;
+		}
+		else if (snapshot.bFinished)
+		{
+			search_.BuildPath(statsPath_);
+			record.Stats = statsPath_.Stats;
+		}
+		else
+		{
+			record.Stats = search_.GetStats();
+		}
 	}
+	record.Stats.ElapsedTime = searchTime_;
 }
@@ -2,23 +2,44 @@
 #include "Core/Layers/Layer.h"
 #include "LayerCommon.h"
 #include "MapData.h"
-#include "Pathfinding/Node.h"
+#include "Pathfinding/AStarSearch.h"
+#include "Pathfinding/BidirectionalSearch.h"
+#include "Pathfinding/ConnectivityIndex.h"
+#include "Pathfinding/DStarLite.h"
+#include "Pathfinding/Grid.h"
+#include "Pathfinding/LandmarkTable.h"
+#include "Pathfinding/MapFile.h"
+#include "Pathfinding/SearchSnapshot.h"
+#include "Pathfinding/TripleBuffer.h"
 #include "Renderer/Renderer.h"
 #include "glm/vec2.hpp"
 #include "glm/vec4.hpp"
 
-#include <queue>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
 
+// 탐색은 워커 스레드에서 진행하고, 렌더링은 워커가 발행한 사본(SearchSnapshot)만 읽는다.
+// 탐색 상태와 grid_를 바꾸는 이벤트는 searchMutex_를 잡으므로 워커의 한 조각(WORKER_SLICE_NODE_COUNT)이
+// 끝날 때까지 기다릴 수 있지만, OnUpdate와 OnRender는 잠그지 않는다.
 class PathfindingLayer : public ILayer
 {
 public:
+	PathfindingLayer();
+	virtual ~PathfindingLayer() override;
+
 	virtual void OnInit() override;
-	void GenerateRandomWalls(int rowCount, int columnCount);
+	// 아래 두 함수와 StepPathfinding, ToggleTile은 searchMutex_를 잡은 채로 호출한다.
 	void RebuildGrid(int rowCount, int columnCount, int startRow, int startColumn, int endRow, int endColumn,
 					 EHeuristicMethod::Type method);
-	void StepPathfinding(int rowCount, int columnCount, int endRow, int endColumn, EHeuristicMethod::Type method);
+	// A* 계열은 AStarSearch::Advance로 예산만큼, D* Lite와 양방향은 budget.MaxNodes번 Step한다.
+	// 걸린 시간은 알고리즘에 관계없이 여기서 재어 통계의 ElapsedTime으로 쓴다.
+	void StepPathfinding(const SearchBudget& budget);
 	void DrawGridLines(Renderer& renderer, int rowCount, int columnCount, int cellSize);
-	void DrawCurrentPath(Renderer& renderer, int rowCount, int columnCount, int cellSize, int endRow, int endColumn);
+	void DrawCurrentPath(Renderer& renderer, const SearchSnapshot& snapshot, int rowCount, int columnCount,
+						 int cellSize);
+	// 아래 두 함수는 UpdateSearchRuns로 맞춰 둔 구간을 그린다.
 	void DrawClosedNodes(Renderer& renderer, int rowCount, int columnCount, int cellSize);
 	void DrawOpenNodes(Renderer& renderer, int rowCount, int columnCount, int cellSize);
 	virtual void OnUpdate(float deltaTime) override;
@@ -27,42 +48,112 @@ public:
 						 int columnCount, int cellSize);
 	virtual void OnRender(Renderer& renderer) override;
 
-	std::vector<Node*> GetNeighbors(int row, int column, int rowCount, int columnCount, bool bAllowDiagonals);
-
 	glm::vec2 GridToWorldPosition(int row, int column, int rowCount, int columnCount, int cellSize);
 	glm::vec4 GetTileColor(ETileType type) const;
-	float GetWalkCost(ETileType type) const;
-	float CalculateHeuristicCost(int rowStart, int columnStart, int rowEnd, int columnEnd,
-								 EHeuristicMethod::Type method) const;
 
 	void OnMapRefChanged(const std::weak_ptr<MapData>& weak);
 	void OnStartEvent();
 	void OnPauseEvent();
-	void ResetPathfinding(int startRow, int startColumn, int endRow, int endColumn, EHeuristicMethod::Type method);
+	void ResetPathfinding(int startRow, int startColumn, int endRow, int endColumn, ESearchAlgorithm::Type algorithm,
+						  EHeuristicMethod::Type method, EOpenListType::Type openListType);
 	void OnResetEvent();
 	void OnStepEvent();
 	void OnRebuildEvent();
+	// 뷰포트 중심을 원점으로 하는 월드 좌표. 클릭한 타일을 MapData::PaintTile로 칠한다.
+	void OnViewportClicked(float x, float y);
+	// 맵을 다시 만들지 않고 타일 하나만 type으로 바꾼다. 이미 type이면 Path로 되돌린다.
+	// D* Lite는 탐색 상태를 유지한 채 수리하고, 나머지는 다시 탐색한다.
+	void ToggleTile(int row, int column, ETileType type);
+	void OnLoadMapEvent(const std::string& path);
+	void OnSaveMapEvent(const std::string& path);
 
 private:
-	std::vector<std::vector<Node>> grid_;
+	bool IsReplanning() const { return algorithm_ == ESearchAlgorithm::DStarLite; }
+	bool IsBidirectional() const { return algorithm_ == ESearchAlgorithm::Bidirectional; }
+	bool IsSearchFinished() const;
 
-	struct NodeComparator
+	// 한 행에서 같은 타일이 이어진 구간. 구간 하나를 사각형 하나로 그린다.
+	struct TileRun
 	{
-		bool operator()(const Node* a, const Node* b) const
-		{
-			if (a->FCost() == b->FCost())
-			{
-				return a->HCost > b->HCost;
-			}
-			return a->FCost() > b->FCost();
-		}
+		int FirstColumn = 0;
+		int Count = 0;
+		ETileType Type = ETileType::Path;
 	};
-	std::priority_queue<Node*, std::vector<Node*>, NodeComparator> openSet_;
+	// row의 타일 구간을 다시 만든다. Path는 투명하므로 담지 않는다.
+	void BuildTileRuns(int row);
+	// 한 행에서 Closed 또는 Open 셀이 이어진 구간
+	struct CellRun
+	{
+		int FirstColumn = 0;
+		int Count = 0;
+	};
+	struct SearchRowRuns
+	{
+		// 이 구간을 만든 사본의 행 버전(SearchSnapshot::RowVersions)
+		uint32_t Version = 0;
+		std::vector<CellRun> Closed;
+		std::vector<CellRun> Open;
+	};
+	// 사본에서 버전이 바뀐 행의 구간만 다시 만든다.
+	void UpdateSearchRuns(const SearchSnapshot& snapshot);
+
+	// pendingSteps_만큼 조각 단위로 StepPathfinding을 실행하고, 간격마다 사본을 발행한다.
+	void WorkerLoop();
+	// 탐색의 변경 목록(CellChangeLog)에 있는 셀만 다시 읽어 closedBits_, openBits_, rowVersions_를 맞춘다.
+	// Reset처럼 전부 바뀌었으면 모든 셀을 읽는다. searchMutex_를 잡은 채로 호출한다.
+	void UpdateSearchView();
+	// 지금 탐색 상태를 사본으로 만들어 발행한다. 사본에는 버전이 바뀐 행만 복사한다. searchMutex_를 잡은 채로 호출한다.
+	void PublishSnapshot();
+	// 지금 쿼리의 설정과 통계를 사본에 담는다. 끝난 탐색은 경로까지 만들어 경로 항목을 채운다.
+	void FillSearchStats(SearchSnapshot& snapshot);
+
+	// .pfmap을 불러온 경우 grid_가 이 파일의 메모리를 가리킨다.
+	MapFile mapFile_;
+	Grid grid_;
+	AStarSearch search_{grid_};
+	DStarLite replanner_{grid_};
+	BidirectionalSearch bidirectional_{grid_};
+	// ALT 휴리스틱용. 맵이 바뀌면 더럽혀 두고 ALT로 Reset할 때 다시 만든다.
+	LandmarkTable landmarks_;
+	bool bLandmarksDirty_ = true;
+	// 도달할 수 없는 목표를 탐색 없이 거절한다. 맵을 만들거나 읽으면 다시 Build하고, 타일 토글은 바로 반영한다.
+	ConnectivityIndex connectivity_{grid_, 0};
+	ESearchAlgorithm::Type algorithm_ = ESearchAlgorithm::AStar;
+	// 행마다의 타일 구간. 타일 하나를 바꾸면 그 행만, 맵을 바꾸면 전부 다시 만든다. 메인 스레드에서만 쓴다.
+	std::vector<std::vector<TileRun>> tileRuns_;
+	bool bTileRunsDirty_ = true;
+	// 사본의 행마다의 Closed, Open 구간. 메인 스레드에서만 쓴다.
+	std::vector<SearchRowRuns> searchRuns_;
+	// A* 계열이 찾은 경로와 그 웨이포인트. Reset하면 다시 만든다.
+	PathResult path_;
+	bool bWaypointsBuilt_ = false;
+	// 통계에 남길 쿼리 번호와 설정, 탐색에 쓴 시간. 끝난 탐색의 통계는 statsPath_에 경로를 만들어 얻는다.
+	uint32_t queryId_ = 0;
+	EHeuristicMethod::Type heuristicMethod_ = EHeuristicMethod::None;
+	std::chrono::steady_clock::duration searchTime_{};
+	PathResult statsPath_;
+	uint32_t mapSeed_ = 0;
 
-	bool bPathFound_ = false;
 	float accumulatedTime_ = 0.0f;
 
 	std::weak_ptr<MapData> mapDataWeak_;
 
 	bool bIsPaused_ = true;
-};
\ No newline at end of file
+
+	// 탐색 상태(search_, replanner_, bidirectional_, path_)와 grid_의 변경을 보호한다.
+	std::mutex searchMutex_;
+	// 워커 쪽에서 유지하는 Closed, Open 셀의 비트와 행 버전. 사본은 여기서 바뀐 행만 복사해 간다.
+	std::vector<uint64_t> closedBits_;
+	std::vector<uint64_t> openBits_;
+	std::vector<uint32_t> rowVersions_;
+	uint32_t viewVersion_ = 0;
+	TripleBuffer<SearchSnapshot> snapshots_;
+	std::chrono::steady_clock::time_point nextSnapshotTime_;
+	// 메인 스레드가 시뮬레이션 속도에 맞춰 더하고 워커가 빼 가는 남은 확장 수
+	std::atomic<int> pendingSteps_ = 0;
+	// 마지막 사본을 만들 때 탐색이 끝나 있었는지. 끝났으면 OnUpdate가 확장 수를 더하지 않는다.
+	std::atomic<bool> bSearchFinished_ = false;
+	std::atomic<bool> bStopping_ = false;
+	// 다른 멤버가 모두 초기화된 뒤에 시작하도록 마지막에 둔다.
+	std::thread worker_;
+};
@@ -1 +0,0 @@
-#include "Node.h"
@@ -1,16 +1,17 @@
 #pragma once
 
+#include "Pathfinding/PathfindingTypes.h"
 #include "glm/vec4.hpp"
 
+#include <chrono>
+
 namespace PathfindingConfig
 {
-	constexpr float WALL_DENSITY = 0.3f;
-
 	constexpr float BASE_STEP_INTERVAL = 0.01f;
-
-	constexpr float DIAGONAL_COST = 1.4142135f;
-	constexpr float ORTHOGONAL_COST = 1.0f;
-	constexpr float IMPASSABLE_COST = std::numeric_limits<float>::max();
+	// 워커 스레드가 잠금을 잡은 채 한 번에 확장하는 최대 노드 수. 메인 스레드의 이벤트가 기다리는 최대 시간을 정한다.
+	constexpr int WORKER_SLICE_NODE_COUNT = 1024;
+	// 워커가 렌더링용 사본을 만드는 최소 간격. 사본을 만드는 시간의 4배보다 자주 만들지는 않는다.
+	constexpr std::chrono::milliseconds SNAPSHOT_INTERVAL{16};
 
 	namespace Colors
 	{
@@ -22,6 +23,8 @@ namespace PathfindingConfig
 		constexpr glm::vec4 END_NODE = glm::vec4(1.0f, 0.0f, 1.0f, 1.0f);
 		constexpr glm::vec4 WALL_TILE = glm::vec4(1.0f, 0.0f, 0.0f, 0.3f);
 		constexpr glm::vec4 PATH_TILE = glm::vec4(0.0f, 0.0f, 0.0f, 0.0f);
+		constexpr glm::vec4 SWAMP_TILE = glm::vec4(0.45f, 0.55f, 0.2f, 0.4f);
+		constexpr glm::vec4 WATER_TILE = glm::vec4(0.2f, 0.4f, 1.0f, 0.4f);
 		constexpr glm::vec4 CLEAR_COLOR = glm::vec4(1.0f, 0.0f, 1.0f, 1.0f);
 	}
 
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Pathfinding/PathResult.h"
+#include "Pathfinding/SearchStatsHistory.h"
+
+#include <cstdint>
+#include <vector>
+
+// 워커 스레드가 탐색을 진행하는 동안 렌더링에 넘기는 시각화 상태의 사본.
+// 버퍼를 돌려 쓰므로 벡터의 용량은 유지된다.
+struct SearchSnapshot
+{
+	// 사본을 만든 Grid의 크기. 그리는 맵과 다르면 그리지 않는다.
+	int RowCount = 0;
+	int ColumnCount = 0;
+	// Closed 셀(D* Lite는 일관된 셀)과 Open 셀의 비트. 셀 인덱스 순서로 워드마다 64칸.
+	std::vector<uint64_t> ClosedBits;
+	std::vector<uint64_t> OpenBits;
+	// 행마다 두 비트가 마지막으로 바뀐 버전. 버전이 같은 행은 어느 사본에서나 내용이 같으므로
+	// 그리는 쪽은 버전이 바뀐 행만 다시 읽는다.
+	std::vector<uint32_t> RowVersions;
+	// 그릴 경로의 꺾은선들. 양방향은 두 방향의 사슬을 따로 담는다.
+	std::vector<std::vector<GridPosition>> Paths;
+	// 사본을 만들 때까지의 통계. 쿼리 번호는 Reset과 D* Lite의 수리마다 바뀐다.
+	SearchStatsRecord Stats;
+	uint32_t QueryId = 0;
+	bool bFinished = false;
+};
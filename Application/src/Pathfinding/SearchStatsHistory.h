@@ -0,0 +1,103 @@
+#pragma once
+
+#include "Pathfinding/PathResult.h"
+#include "Pathfinding/PathfindingTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// 쿼리 하나의 설정과 통계. 알고리즘과 Open List는 대체된 경우(AStarSearch::GetActiveAlgorithm) 실제로 쓴 것이다.
+struct SearchStatsRecord
+{
+	ESearchAlgorithm::Type Algorithm = ESearchAlgorithm::AStar;
+	EHeuristicMethod::Type HeuristicMethod = EHeuristicMethod::None;
+	EOpenListType::Type OpenListType = EOpenListType::BinaryHeap;
+	bool bFound = false;
+	// 기록할 때의 Open List 크기. 끝난 쿼리는 남은 크기이다.
+	size_t OpenListSize = 0;
+	SearchStats Stats;
+};
+
+// 패널에 그릴 탐색 통계. 지금 쿼리는 통계가 바뀔 때마다 표본을 남기고, 끝난 쿼리는 한 번만 기록한다.
+// 둘 다 링 버퍼라 가득 차면 가장 오래된 것을 덮어쓴다. 메인 스레드에서만 쓴다.
+class SearchStatsHistory
+{
+public:
+	static constexpr int SAMPLE_CAPACITY = 256;
+	static constexpr int RECORD_CAPACITY = 64;
+
+	// 사본의 쿼리 번호가 바뀌면 새 쿼리로 보고 표본을 비운다.
+	void Update(uint32_t queryId, const SearchStatsRecord& current, bool bFinished)
+	{
+		if (queryId != queryId_)
+		{
+			queryId_ = queryId;
+			bRecorded_ = false;
+			sampleCount_ = 0;
+			sampleOffset_ = 0;
+		}
+		const bool bChanged = sampleCount_ == 0
+							  || current.Stats.NodesExpanded != current_.Stats.NodesExpanded
+							  || current.Stats.ElapsedTime != current_.Stats.ElapsedTime;
+		current_ = current;
+		if (bChanged)
+		{
+			const int position = (sampleOffset_ + sampleCount_) % SAMPLE_CAPACITY;
+			expandedSamples_[position] = static_cast<float>(current.Stats.NodesExpanded);
+			openListSamples_[position] = static_cast<float>(current.OpenListSize);
+			if (sampleCount_ < SAMPLE_CAPACITY)
+			{
+				++sampleCount_;
+			}
+			else
+			{
+				sampleOffset_ = (sampleOffset_ + 1) % SAMPLE_CAPACITY;
+			}
+		}
+		if (bFinished && !bRecorded_)
+		{
+			records_[(recordOffset_ + recordCount_) % RECORD_CAPACITY] = current;
+			if (recordCount_ < RECORD_CAPACITY)
+			{
+				++recordCount_;
+			}
+			else
+			{
+				recordOffset_ = (recordOffset_ + 1) % RECORD_CAPACITY;
+			}
+			bRecorded_ = true;
+		}
+	}
+
+	const SearchStatsRecord& GetCurrent() const { return current_; }
+	bool IsCurrentFinished() const { return bRecorded_; }
+
+	// 아래 두 배열은 GetSampleOffset부터 GetSampleCount개가 오래된 순서이다. ImGui::PlotLines에 그대로 넘긴다.
+	const float* GetExpandedSamples() const { return expandedSamples_; }
+	const float* GetOpenListSamples() const { return openListSamples_; }
+	int GetSampleCount() const { return sampleCount_; }
+	int GetSampleOffset() const { return sampleOffset_; }
+
+	// 0이 가장 오래된 기록
+	int GetRecordCount() const { return recordCount_; }
+	const SearchStatsRecord& GetRecord(int index) const { return records_[(recordOffset_ + index) % RECORD_CAPACITY]; }
+	void ClearRecords()
+	{
+		recordCount_ = 0;
+		recordOffset_ = 0;
+	}
+
+private:
+	uint32_t queryId_ = 0;
+	bool bRecorded_ = false;
+	SearchStatsRecord current_;
+
+	float expandedSamples_[SAMPLE_CAPACITY] = {};
+	float openListSamples_[SAMPLE_CAPACITY] = {};
+	int sampleCount_ = 0;
+	int sampleOffset_ = 0;
+
+	SearchStatsRecord records_[RECORD_CAPACITY];
+	int recordCount_ = 0;
+	int recordOffset_ = 0;
+};
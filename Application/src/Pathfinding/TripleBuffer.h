@@ -0,0 +1,36 @@
+#pragma once
+
+#include <atomic>
+
+// 쓰는 쪽과 읽는 쪽이 서로를 기다리지 않고 값을 넘기는 삼중 버퍼.
+// 쓰는 쪽은 GetBack에 값을 채운 뒤 Publish하고, 읽는 쪽은 Acquire로 가장 최근에 발행된 값을 받는다.
+// 쓰는 쪽이 여러 스레드라면 그 사이의 순서는 호출한 쪽이 잠금으로 맞춘다. 읽는 쪽은 한 스레드여야 한다.
+template <typename T>
+class TripleBuffer
+{
+public:
+	// 다음 Publish까지 쓰는 쪽만 만지는 버퍼. 전에 발행했던 값이 남아 있을 수 있으므로 전부 다시 채운다.
+	T& GetBack() { return buffers_[backIndex_]; }
+	void Publish() { backIndex_ = middle_.exchange(backIndex_ | DIRTY_BIT, std::memory_order_acq_rel) & INDEX_MASK; }
+
+	// 새로 발행된 값이 있으면 바꿔 들고, 없으면 지난번에 받은 값을 그대로 준다.
+	// 돌려준 참조는 다음 Acquire까지 유효하다.
+	const T& Acquire()
+	{
+		if (middle_.load(std::memory_order_relaxed) & DIRTY_BIT)
+		{
+			frontIndex_ = middle_.exchange(frontIndex_, std::memory_order_acq_rel) & INDEX_MASK;
+		}
+		return buffers_[frontIndex_];
+	}
+
+private:
+	static constexpr int INDEX_MASK = 3;
+	// 가운데 버퍼가 읽는 쪽이 아직 받지 않은 값이면 켜진다.
+	static constexpr int DIRTY_BIT = 4;
+
+	T buffers_[3];
+	int backIndex_ = 0;
+	std::atomic<int> middle_{1};
+	int frontIndex_ = 2;
+};
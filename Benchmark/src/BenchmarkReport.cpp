@@ -0,0 +1,191 @@
+#include "BenchmarkReport.h"
+
+#include <cstdio>
+
+namespace
+{
+	void WriteTable(std::ostream& stream, const BenchmarkMetadata& metadata, const std::vector<BenchmarkRow>& rows)
+	{
+		char line[384];
+		std::snprintf(line, sizeof(line),
+					  "seed=%u queries=%d algorithm=%s threads=%d openList=%s connectivity=%s waypoints=%s "
+					  "frameBudget=%dus peakRss=%ldKB\n",
+					  metadata.Seed, metadata.QueryCount, metadata.Algorithm.c_str(), metadata.ThreadCount,
+					  metadata.OpenListType.c_str(), metadata.bUseConnectivity ? "On" : "Off",
+					  metadata.bBuildWaypoints ? "On" : "Off", metadata.FrameBudgetMicroseconds,
+					  metadata.PeakResidentKilobytes);
+		stream << line;
+		std::snprintf(line, sizeof(line),
+					  "%-10s %6s %-10s %6s %10s %10s %10s %9s %9s %9s %9s %9s %9s %9s %8s %8s %9s %7s %12s %6s %8s\n",
+					  "Scenario", "Size", "Heuristic", "Found", "Query/s", "Expanded", "PeakOpen", "Memory", "p50(us)",
+					  "p90(us)", "p99(us)", "max(us)", "Load(ms)", "Prep(ms)", "NotOpt", "Waypts", "WpLength", "Frames",
+					  "MaxFrame(us)", "Batch", "Scaling");
+		stream << line;
+		for (const BenchmarkRow& row : rows)
+		{
+			std::snprintf(line, sizeof(line),
+						  "%-10s %6d %-10s %6d %10.1f %10.1f %10.1f %8zuK %9.1f %9.1f %9.1f %9.1f %9.2f %9.2f %8d "
+						  "%8.1f %9.1f %7d %12.1f %6d %7.2fx\n",
+						  row.Scenario.c_str(), row.Size, row.Heuristic.c_str(), row.FoundCount, row.QueriesPerSecond,
+						  row.MeanNodesExpanded, row.MeanPeakOpenListSize, row.MemoryBytes / 1024, row.P50Microseconds,
+						  row.P90Microseconds, row.P99Microseconds, row.MaxMicroseconds, row.MapLoadMilliseconds,
+						  row.PreprocessMilliseconds, row.OptimalMismatchCount, row.MeanWaypointCount,
+						  row.MeanWaypointLength, row.FrameCount, row.MaxFrameMicroseconds, row.BatchThreadCount,
+						  row.BatchSpeedup);
+			stream << line;
+		}
+	}
+
+	void WriteCsv(std::ostream& stream, const std::vector<BenchmarkRow>& rows)
+	{
+		stream << "scenario,size,heuristic,queries,found,total_ms,queries_per_sec,mean_nodes_expanded,"
+				  "mean_peak_open,max_peak_open,mean_path_cost,memory_bytes,p50_us,p90_us,p99_us,max_us,map_load_ms,"
+				  "preprocess_ms,optimal_mismatches,mean_waypoints,mean_waypoint_length,frames,"
+				  "max_frame_us,batch_threads,batch_speedup\n";
+		char line[640];
+		for (const BenchmarkRow& row : rows)
+		{
+			std::snprintf(line, sizeof(line),
+						  "%s,%d,%s,%d,%d,%.3f,%.1f,%.2f,%.2f,%zu,%.4f,%zu,%.2f,%.2f,%.2f,%.2f,%.3f,%.3f,%d,%.2f,"
+						  "%.4f,%d,%.2f,%d,%.3f\n",
+						  row.Scenario.c_str(), row.Size, row.Heuristic.c_str(), row.QueryCount, row.FoundCount,
+						  row.TotalMilliseconds, row.QueriesPerSecond, row.MeanNodesExpanded, row.MeanPeakOpenListSize,
+						  row.MaxPeakOpenListSize, row.MeanPathCost, row.MemoryBytes, row.P50Microseconds,
+						  row.P90Microseconds, row.P99Microseconds, row.MaxMicroseconds, row.MapLoadMilliseconds,
+						  row.PreprocessMilliseconds, row.OptimalMismatchCount, row.MeanWaypointCount,
+						  row.MeanWaypointLength, row.FrameCount, row.MaxFrameMicroseconds, row.BatchThreadCount,
+						  row.BatchSpeedup);
+			stream << line;
+		}
+	}
+
+	void WriteJson(std::ostream& stream, const BenchmarkMetadata& metadata, const std::vector<BenchmarkRow>& rows)
+	{
+		char line[640];
+		std::snprintf(line, sizeof(line),
+					  "{\n  \"seed\": %u,\n  \"queries\": %d,\n  \"algorithm\": \"%s\",\n  \"threads\": %d,\n"
+					  "  \"openList\": \"%s\",\n  \"connectivity\": %s,\n  \"waypoints\": %s,\n"
+					  "  \"frameBudgetUs\": %d,\n  \"peakRssKb\": %ld,\n  \"results\": [\n",
+					  metadata.Seed, metadata.QueryCount, metadata.Algorithm.c_str(), metadata.ThreadCount,
+					  metadata.OpenListType.c_str(), metadata.bUseConnectivity ? "true" : "false",
+					  metadata.bBuildWaypoints ? "true" : "false", metadata.FrameBudgetMicroseconds,
+					  metadata.PeakResidentKilobytes);
+		stream << line;
+		for (size_t i = 0; i < rows.size(); ++i)
+		{
+			const BenchmarkRow& row = rows[i];
+			std::snprintf(line, sizeof(line),
+						  "    {\"scenario\": \"%s\", \"size\": %d, \"heuristic\": \"%s\", \"queries\": %d, "
+						  "\"found\": %d, \"totalMs\": %.3f, \"queriesPerSec\": %.1f, \"meanNodesExpanded\": %.2f, "
+						  "\"meanPeakOpen\": %.2f, \"maxPeakOpen\": %zu, \"meanPathCost\": %.4f, \"memoryBytes\": %zu, "
+						  "\"p50Us\": %.2f, \"p90Us\": %.2f, \"p99Us\": %.2f, \"maxUs\": %.2f, \"mapLoadMs\": %.3f, "
+						  "\"preprocessMs\": %.3f, \"optimalMismatches\": %d, \"meanWaypoints\": %.2f, "
+						  "\"meanWaypointLength\": %.4f, \"frames\": %d, \"maxFrameUs\": %.2f, \"batchThreads\": %d, "
+						  "\"batchSpeedup\": %.3f}%s\n",
+						  row.Scenario.c_str(), row.Size, row.Heuristic.c_str(), row.QueryCount, row.FoundCount,
+						  row.TotalMilliseconds, row.QueriesPerSecond, row.MeanNodesExpanded, row.MeanPeakOpenListSize,
+						  row.MaxPeakOpenListSize, row.MeanPathCost, row.MemoryBytes, row.P50Microseconds,
+						  row.P90Microseconds, row.P99Microseconds, row.MaxMicroseconds, row.MapLoadMilliseconds,
+						  row.PreprocessMilliseconds, row.OptimalMismatchCount, row.MeanWaypointCount,
+						  row.MeanWaypointLength, row.FrameCount, row.MaxFrameMicroseconds, row.BatchThreadCount,
+						  row.BatchSpeedup, i + 1 < rows.size() ? "," : "");
+			stream << line;
+		}
+		stream << "  ]\n}\n";
+	}
+
+	double GetSpeedup(const MicroBenchmarkRow& row)
+	{
+		return row.PerCellMegacellsPerSecond > 0.0 ? row.BitboardMegacellsPerSecond / row.PerCellMegacellsPerSecond
+												   : 0.0;
+	}
+
+	void WriteMicroTable(std::ostream& stream, const BenchmarkMetadata& metadata, const std::string& scanPath,
+						 const std::vector<MicroBenchmarkRow>& rows)
+	{
+		char line[256];
+		std::snprintf(line, sizeof(line), "seed=%u scan=%s\n", metadata.Seed, scanPath.c_str());
+		stream << line;
+		std::snprintf(line, sizeof(line), "%-10s %6s %-12s %8s %10s %14s %14s %8s %8s\n", "Scenario", "Size", "Test",
+					  "Samples", "Cells/op", "PerCell(Mc/s)", "Bitboard(Mc/s)", "Speedup", "Mismatch");
+		stream << line;
+		for (const MicroBenchmarkRow& row : rows)
+		{
+			std::snprintf(line, sizeof(line), "%-10s %6d %-12s %8d %10.1f %14.1f %14.1f %7.2fx %8d\n",
+						  row.Scenario.c_str(), row.Size, row.Test.c_str(), row.SampleCount, row.MeanCellsPerSample,
+						  row.PerCellMegacellsPerSecond, row.BitboardMegacellsPerSecond, GetSpeedup(row),
+						  row.MismatchCount);
+			stream << line;
+		}
+	}
+
+	void WriteMicroCsv(std::ostream& stream, const std::vector<MicroBenchmarkRow>& rows)
+	{
+		stream << "scenario,size,test,samples,mean_cells,per_cell_mcells_per_sec,bitboard_mcells_per_sec,speedup,"
+				  "mismatches\n";
+		char line[256];
+		for (const MicroBenchmarkRow& row : rows)
+		{
+			std::snprintf(line, sizeof(line), "%s,%d,%s,%d,%.2f,%.2f,%.2f,%.3f,%d\n", row.Scenario.c_str(), row.Size,
+						  row.Test.c_str(), row.SampleCount, row.MeanCellsPerSample, row.PerCellMegacellsPerSecond,
+						  row.BitboardMegacellsPerSecond, GetSpeedup(row), row.MismatchCount);
+			stream << line;
+		}
+	}
+
+	void WriteMicroJson(std::ostream& stream, const BenchmarkMetadata& metadata, const std::string& scanPath,
+						const std::vector<MicroBenchmarkRow>& rows)
+	{
+		char line[512];
+		std::snprintf(line, sizeof(line), "{\n  \"seed\": %u,\n  \"scan\": \"%s\",\n  \"results\": [\n", metadata.Seed,
+					  scanPath.c_str());
+		stream << line;
+		for (size_t i = 0; i < rows.size(); ++i)
+		{
+			const MicroBenchmarkRow& row = rows[i];
+			std::snprintf(line, sizeof(line),
+						  "    {\"scenario\": \"%s\", \"size\": %d, \"test\": \"%s\", \"samples\": %d, "
+						  "\"meanCells\": %.2f, \"perCellMcellsPerSec\": %.2f, \"bitboardMcellsPerSec\": %.2f, "
+						  "\"speedup\": %.3f, \"mismatches\": %d}%s\n",
+						  row.Scenario.c_str(), row.Size, row.Test.c_str(), row.SampleCount, row.MeanCellsPerSample,
+						  row.PerCellMegacellsPerSecond, row.BitboardMegacellsPerSecond, GetSpeedup(row),
+						  row.MismatchCount, i + 1 < rows.size() ? "," : "");
+			stream << line;
+		}
+		stream << "  ]\n}\n";
+	}
+} // namespace
+
+void WriteReport(std::ostream& stream, EReportFormat::Type format, const BenchmarkMetadata& metadata,
+				 const std::vector<BenchmarkRow>& rows)
+{
+	switch (format)
+	{
+	case EReportFormat::Csv:
+		WriteCsv(stream, rows);
+		break;
+	case EReportFormat::Json:
+		WriteJson(stream, metadata, rows);
+		break;
+	default:
+		WriteTable(stream, metadata, rows);
+		break;
+	}
+}
+
+void WriteMicroReport(std::ostream& stream, EReportFormat::Type format, const BenchmarkMetadata& metadata,
+					  const std::string& scanPath, const std::vector<MicroBenchmarkRow>& rows)
+{
+	switch (format)
+	{
+	case EReportFormat::Csv:
+		WriteMicroCsv(stream, rows);
+		break;
+	case EReportFormat::Json:
+		WriteMicroJson(stream, metadata, scanPath, rows);
+		break;
+	default:
+		WriteMicroTable(stream, metadata, scanPath, rows);
+		break;
+	}
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace EReportFormat
+{
+	enum Type
+	{
+		Table = 0,
+		Csv,
+		Json,
+		NUM_TYPES
+	};
+
+	inline const char* to_string(EReportFormat::Type e)
+	{
+		switch (e)
+		{
+		case EReportFormat::Table:
+			return "Table";
+		case EReportFormat::Csv:
+			return "Csv";
+		case EReportFormat::Json:
+			return "Json";
+		default:
+			return "Unknown";
+		}
+	}
+	inline EReportFormat::Type from_string(const std::string& str)
+	{
+		if (str == "Table")
+			return EReportFormat::Table;
+		else if (str == "Csv")
+			return EReportFormat::Csv;
+		else if (str == "Json")
+			return EReportFormat::Json;
+		return EReportFormat::NUM_TYPES;
+	}
+
+} // namespace EReportFormat
+
+// 시나리오 하나(맵 타입, 크기)를 휴리스틱 하나로 실행한 결과
+struct BenchmarkRow
+{
+	std::string Scenario;
+	int Size = 0;
+	std::string Heuristic;
+
+	int QueryCount = 0;
+	int FoundCount = 0;
+	double TotalMilliseconds = 0.0;
+	double QueriesPerSecond = 0.0;
+	double MeanNodesExpanded = 0.0;
+	double MeanPeakOpenListSize = 0.0;
+	size_t MaxPeakOpenListSize = 0;
+	double MeanPathCost = 0.0;
+	// 찾은 경로의 평균 웨이포인트 수와 그 점들을 직선으로 이은 길이. 웨이포인트가 없으면 0.
+	double MeanWaypointCount = 0.0;
+	double MeanWaypointLength = 0.0;
+	// Grid와 탐색 상태(SearchSpace), 전처리 결과(LandmarkTable, ConnectivityIndex)가 차지하는 바이트
+	size_t MemoryBytes = 0;
+	// 맵을 만들거나 파일에서 읽는 데 걸린 시간
+	double MapLoadMilliseconds = 0.0;
+	// 쿼리 전에 한 번 하는 전처리(ALT 랜드마크, 연결 영역) 시간. 없으면 0.
+	double PreprocessMilliseconds = 0.0;
+	// .scen의 최적 거리와 다른 결과 수. 비교하지 않았으면 -1.
+	int OptimalMismatchCount = -1;
+
+	// 프레임 예산 모드(--frame-budget)에서 모든 쿼리가 끝날 때까지 Update한 횟수와 가장 오래 걸린 Update.
+	// 다른 모드에서는 0.
+	int FrameCount = 0;
+	double MaxFrameMicroseconds = 0.0;
+
+	// 배치 모드(--batch-threads)에서 BatchPathfinder의 워커 수와, 같은 시나리오와 휴리스틱에서 처음 지정한
+	// 워커 수 대비 처리량 배율. 다른 모드에서는 0.
+	int BatchThreadCount = 0;
+	double BatchSpeedup = 0.0;
+
+	// 쿼리 하나(Reset + Run)의 지연 시간. 프레임 예산 모드에서는 제출부터 끝난 프레임까지의 시간이고,
+	// 배치 모드에서는 워커 안에서 탐색에 쓴 시간(SearchStats::ElapsedTime)이다.
+	double P50Microseconds = 0.0;
+	double P90Microseconds = 0.0;
+	double P99Microseconds = 0.0;
+	double MaxMicroseconds = 0.0;
+};
+
+struct BenchmarkMetadata
+{
+	uint32_t Seed = 0;
+	int QueryCount = 0;
+	std::string Algorithm;
+	int ThreadCount = 1;
+	std::string OpenListType;
+	bool bUseConnectivity = false;
+	bool bBuildWaypoints = false;
+	// 0이면 프레임 예산 모드가 아니다.
+	int FrameBudgetMicroseconds = 0;
+	// 프로세스 최대 RSS. 알 수 없는 플랫폼이면 0.
+	long PeakResidentKilobytes = 0;
+};
+
+// 같은 샘플을 셀 단위 구현(비트보드 이전 방식)과 비트보드 구현으로 각각 실행한 결과
+struct MicroBenchmarkRow
+{
+	std::string Scenario;
+	int Size = 0;
+	std::string Test;
+
+	int SampleCount = 0;
+	// 샘플 하나를 판정하기까지 셀 단위 구현이 읽은 셀 수의 평균
+	double MeanCellsPerSample = 0.0;
+	// 두 구현 모두 셀 단위 구현이 읽은 셀 수를 기준으로 한 초당 처리량(백만 셀)
+	double PerCellMegacellsPerSecond = 0.0;
+	double BitboardMegacellsPerSecond = 0.0;
+	// 두 구현의 결과가 다른 샘플 수. 0이어야 한다.
+	int MismatchCount = 0;
+};
+
+void WriteReport(std::ostream& stream, EReportFormat::Type format, const BenchmarkMetadata& metadata,
+				 const std::vector<BenchmarkRow>& rows);
+// metadata는 Seed만 쓴다. scanPath는 비트보드 스캔이 빌드된 방식(Scalar 또는 AVX2)이다.
+void WriteMicroReport(std::ostream& stream, EReportFormat::Type format, const BenchmarkMetadata& metadata,
+					  const std::string& scanPath, const std::vector<MicroBenchmarkRow>& rows);
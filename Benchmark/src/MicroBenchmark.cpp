@@ -0,0 +1,296 @@
+#include "MicroBenchmark.h"
+
+#include "Pathfinding/JumpPointScanner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	constexpr int INVALID_INDEX = -1;
+	// 시야 판정 샘플의 두 셀은 행과 열 모두 이 거리 안에서 고른다.
+	constexpr int LINE_OF_SIGHT_RANGE = 64;
+
+	struct ScanSample
+	{
+		int Row = 0;
+		int Column = 0;
+		int DeltaRow = 0;
+		int DeltaColumn = 0;
+	};
+
+	struct LineOfSightSample
+	{
+		int FromRow = 0;
+		int FromColumn = 0;
+		int ToRow = 0;
+		int ToColumn = 0;
+	};
+
+	bool IsWalkable(const Grid& grid, int row, int column)
+	{
+		return grid.IsInBounds(row, column) && grid.IsWalkable(row, column);
+	}
+
+	// JumpPointScanner가 비트보드를 쓰기 전의 직선 스캔. 셀마다 범위 검사와 비트 읽기를 한다.
+	// bCountCells면 읽은 셀 수를 cellCount에 더한다.
+	template <bool bCountCells>
+	int JumpStraightPerCell(const Grid& grid, int row, int column, int dRow, int dColumn, long long& cellCount)
+	{
+		while (IsWalkable(grid, row, column))
+		{
+			if constexpr (bCountCells)
+			{
+				++cellCount;
+			}
+			const int index = grid.ToIndex(row, column);
+			if (dColumn != 0)
+			{
+				if ((IsWalkable(grid, row - 1, column) && !IsWalkable(grid, row - 1, column - dColumn))
+					|| (IsWalkable(grid, row + 1, column) && !IsWalkable(grid, row + 1, column - dColumn)))
+				{
+					return index;
+				}
+			}
+			else
+			{
+				if ((IsWalkable(grid, row, column - 1) && !IsWalkable(grid, row - dRow, column - 1))
+					|| (IsWalkable(grid, row, column + 1) && !IsWalkable(grid, row - dRow, column + 1)))
+				{
+					return index;
+				}
+			}
+			row += dRow;
+			column += dColumn;
+		}
+		return INVALID_INDEX;
+	}
+
+	// GridBitboard::HasLineOfSight와 같은 셀을 보지만 한 셀씩 읽는다.
+	template <bool bCountCells>
+	bool HasLineOfSightPerCell(const Grid& grid, LineOfSightSample sample, long long& cellCount)
+	{
+		if (sample.FromRow > sample.ToRow)
+		{
+			std::swap(sample.FromRow, sample.ToRow);
+			std::swap(sample.FromColumn, sample.ToColumn);
+		}
+		const int deltaRow = sample.ToRow - sample.FromRow;
+		const int deltaColumn = sample.ToColumn - sample.FromColumn;
+		auto isSpanWalkable = [&](int row, int firstColumn, int lastColumn)
+		{
+			for (int column = firstColumn; column <= lastColumn; ++column)
+			{
+				if constexpr (bCountCells)
+				{
+					++cellCount;
+				}
+				if (!grid.IsWalkable(row, column))
+				{
+					return false;
+				}
+			}
+			return true;
+		};
+		if (deltaRow == 0)
+		{
+			return isSpanWalkable(sample.FromRow, std::min(sample.FromColumn, sample.ToColumn),
+								  std::max(sample.FromColumn, sample.ToColumn));
+		}
+
+		const long long denominator = 2ll * deltaRow;
+		for (int row = sample.FromRow; row <= sample.ToRow; ++row)
+		{
+			const long long topNumerator = row == sample.FromRow
+											   ? (2ll * sample.FromColumn + 1) * deltaRow
+											   : (2ll * sample.FromColumn + 1) * deltaRow
+													 + (2ll * row - 2ll * sample.FromRow - 1) * deltaColumn;
+			const long long bottomNumerator = row == sample.ToRow
+												  ? (2ll * sample.ToColumn + 1) * deltaRow
+												  : (2ll * sample.FromColumn + 1) * deltaRow
+														+ (2ll * row + 2 - 2ll * sample.FromRow - 1) * deltaColumn;
+			const long long lowNumerator = std::min(topNumerator, bottomNumerator);
+			const long long highNumerator = std::max(topNumerator, bottomNumerator);
+			const int firstColumn
+				= static_cast<int>(lowNumerator / denominator - (lowNumerator % denominator == 0 ? 1 : 0));
+			const int lastColumn = static_cast<int>(highNumerator / denominator);
+			if (!isSpanWalkable(row, firstColumn, lastColumn))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool HasWalkableCell(const Grid& grid)
+	{
+		const uint64_t* words = grid.GetWords();
+		return std::any_of(words, words + Grid::GetWordCount(grid.GetRowCount(), grid.GetColumnCount()),
+						   [](uint64_t word) { return word != 0; });
+	}
+
+	// 분포 클래스는 표준 라이브러리 구현마다 결과가 다르므로 mt19937 출력을 직접 쓴다.
+	GridPosition PickWalkableCell(const Grid& grid, std::mt19937& random)
+	{
+		for (;;)
+		{
+			const int row = static_cast<int>(random() % grid.GetRowCount());
+			const int column = static_cast<int>(random() % grid.GetColumnCount());
+			if (grid.IsWalkable(row, column))
+			{
+				return {row, column};
+			}
+		}
+	}
+
+	// 샘플 전체를 func로 한 번 실행하는 데 걸린 초
+	template <typename Func>
+	double MeasureSeconds(Func&& func)
+	{
+		const Clock::time_point begin = Clock::now();
+		func();
+		return std::chrono::duration<double>(Clock::now() - begin).count();
+	}
+
+	void RunJumpScan(const Grid& grid, int sampleCount, std::mt19937& random, MicroBenchmarkRow& row,
+					 long long& cellCount, double& perCellSeconds, double& bitboardSeconds)
+	{
+		static constexpr int DIRECTIONS[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+		std::vector<ScanSample> samples(sampleCount);
+		for (ScanSample& sample : samples)
+		{
+			const GridPosition cell = PickWalkableCell(grid, random);
+			const int direction = static_cast<int>(random() % 4);
+			sample = {cell.Row, cell.Column, DIRECTIONS[direction][0], DIRECTIONS[direction][1]};
+		}
+
+		std::vector<int> expected(samples.size());
+		for (size_t i = 0; i < samples.size(); ++i)
+		{
+			const ScanSample& sample = samples[i];
+			expected[i] = JumpStraightPerCell<true>(grid, sample.Row, sample.Column, sample.DeltaRow,
+													sample.DeltaColumn, cellCount);
+		}
+
+		// 두 구현 모두 한 번씩 미리 실행해 캐시 상태를 맞춘다. 비트보드 쪽 결과로 불일치를 센다.
+		JumpPointScanner scanner(grid);
+		// 도착 셀이 없으면 Jump는 벽이나 강제 이웃에서만 멈춘다.
+		scanner.SetEndIndex(INVALID_INDEX);
+		for (size_t i = 0; i < samples.size(); ++i)
+		{
+			const ScanSample& sample = samples[i];
+			const int result = scanner.Jump(sample.Row, sample.Column, sample.DeltaRow, sample.DeltaColumn);
+			row.MismatchCount += result != expected[i];
+		}
+
+		std::vector<int> results(samples.size());
+		long long unused = 0;
+		perCellSeconds = MeasureSeconds(
+			[&]
+			{
+				for (size_t i = 0; i < samples.size(); ++i)
+				{
+					const ScanSample& sample = samples[i];
+					results[i] = JumpStraightPerCell<false>(grid, sample.Row, sample.Column, sample.DeltaRow,
+															sample.DeltaColumn, unused);
+				}
+			});
+		bitboardSeconds = MeasureSeconds(
+			[&]
+			{
+				for (size_t i = 0; i < samples.size(); ++i)
+				{
+					const ScanSample& sample = samples[i];
+					results[i] = scanner.Jump(sample.Row, sample.Column, sample.DeltaRow, sample.DeltaColumn);
+				}
+			});
+	}
+
+	void RunLineOfSight(const Grid& grid, int sampleCount, std::mt19937& random, MicroBenchmarkRow& row,
+						long long& cellCount, double& perCellSeconds, double& bitboardSeconds)
+	{
+		std::vector<LineOfSightSample> samples(sampleCount);
+		for (LineOfSightSample& sample : samples)
+		{
+			const GridPosition from = PickWalkableCell(grid, random);
+			auto pickNear = [&](int center, int count)
+			{
+				const int offset = static_cast<int>(random() % (2 * LINE_OF_SIGHT_RANGE + 1)) - LINE_OF_SIGHT_RANGE;
+				return std::clamp(center + offset, 0, count - 1);
+			};
+			sample = {from.Row, from.Column, pickNear(from.Row, grid.GetRowCount()),
+					  pickNear(from.Column, grid.GetColumnCount())};
+		}
+
+		std::vector<char> expected(samples.size());
+		for (size_t i = 0; i < samples.size(); ++i)
+		{
+			expected[i] = HasLineOfSightPerCell<true>(grid, samples[i], cellCount);
+		}
+
+		for (size_t i = 0; i < samples.size(); ++i)
+		{
+			const LineOfSightSample& sample = samples[i];
+			const bool bResult = grid.HasLineOfSight(sample.FromRow, sample.FromColumn, sample.ToRow, sample.ToColumn);
+			row.MismatchCount += bResult != static_cast<bool>(expected[i]);
+		}
+
+		std::vector<char> results(samples.size());
+		long long unused = 0;
+		perCellSeconds = MeasureSeconds(
+			[&]
+			{
+				for (size_t i = 0; i < samples.size(); ++i)
+				{
+					results[i] = HasLineOfSightPerCell<false>(grid, samples[i], unused);
+				}
+			});
+		bitboardSeconds = MeasureSeconds(
+			[&]
+			{
+				for (size_t i = 0; i < samples.size(); ++i)
+				{
+					const LineOfSightSample& sample = samples[i];
+					results[i] = grid.HasLineOfSight(sample.FromRow, sample.FromColumn, sample.ToRow, sample.ToColumn);
+				}
+			});
+	}
+} // namespace
+
+MicroBenchmarkRow RunMicroBenchmark(EMicroBenchmarkType::Type type, const Scenario& scenario, int sampleCount,
+									uint32_t seed)
+{
+	MicroBenchmarkRow row;
+	row.Scenario = scenario.Name;
+	row.Size = scenario.Size;
+	row.Test = EMicroBenchmarkType::to_string(type);
+	row.SampleCount = sampleCount;
+
+	const Grid& grid = scenario.Map;
+	if (sampleCount <= 0 || !HasWalkableCell(grid))
+	{
+		return row;
+	}
+	std::mt19937 random(seed);
+	long long cellCount = 0;
+	double perCellSeconds = 0.0;
+	double bitboardSeconds = 0.0;
+	if (type == EMicroBenchmarkType::LineOfSight)
+	{
+		RunLineOfSight(grid, sampleCount, random, row, cellCount, perCellSeconds, bitboardSeconds);
+	}
+	else
+	{
+		RunJumpScan(grid, sampleCount, random, row, cellCount, perCellSeconds, bitboardSeconds);
+	}
+
+	row.MeanCellsPerSample = static_cast<double>(cellCount) / sampleCount;
+	row.PerCellMegacellsPerSecond = perCellSeconds > 0.0 ? cellCount / perCellSeconds / 1e6 : 0.0;
+	row.BitboardMegacellsPerSecond = bitboardSeconds > 0.0 ? cellCount / bitboardSeconds / 1e6 : 0.0;
+	return row;
+}
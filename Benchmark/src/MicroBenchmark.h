@@ -0,0 +1,45 @@
+#pragma once
+#include "BenchmarkReport.h"
+#include "Scenario.h"
+
+#include <cstdint>
+#include <string>
+
+namespace EMicroBenchmarkType
+{
+	enum Type
+	{
+		// JPS의 직선 스캔 (JumpPointScanner::Jump)
+		JumpScan = 0,
+		// 두 셀 사이의 시야 판정 (Grid::HasLineOfSight)
+		LineOfSight,
+		NUM_TYPES
+	};
+
+	inline const char* to_string(EMicroBenchmarkType::Type e)
+	{
+		switch (e)
+		{
+		case EMicroBenchmarkType::JumpScan:
+			return "JumpScan";
+		case EMicroBenchmarkType::LineOfSight:
+			return "LineOfSight";
+		default:
+			return "Unknown";
+		}
+	}
+	inline EMicroBenchmarkType::Type from_string(const std::string& str)
+	{
+		if (str == "JumpScan")
+			return EMicroBenchmarkType::JumpScan;
+		else if (str == "LineOfSight")
+			return EMicroBenchmarkType::LineOfSight;
+		return EMicroBenchmarkType::NUM_TYPES;
+	}
+
+} // namespace EMicroBenchmarkType
+
+// scenario의 맵에서 sampleCount개의 샘플을 만들어 셀 단위 구현과 비트보드 구현으로 각각 실행한다.
+// 샘플은 시드가 같으면 항상 같다.
+MicroBenchmarkRow RunMicroBenchmark(EMicroBenchmarkType::Type type, const Scenario& scenario, int sampleCount,
+									uint32_t seed);
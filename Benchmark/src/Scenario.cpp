@@ -0,0 +1,307 @@
+#include "Scenario.h"
+
+#include "Pathfinding/MovingAIFormat.h"
+#include "Pathfinding/PathfindingTypes.h"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <utility>
+
+namespace
+{
+	constexpr int ROOM_SIZE = 16;
+	// 가장 큰 영역은 여전히 맵 대부분을 덮지만 작은 섬이 많이 생기는 밀도
+	constexpr float ISLANDS_WALL_DENSITY = 0.45f;
+
+	// 분포 클래스는 표준 라이브러리 구현마다 결과가 다르므로 mt19937 출력을 직접 나눈다.
+	int RandomInt(std::mt19937& random, int count)
+	{
+		return static_cast<int>(random() % static_cast<uint32_t>(count));
+	}
+
+	// 홀수 좌표의 셀을 방으로 보고, 깊이 우선으로 벽을 허물어 가는 미로.
+	void GenerateMaze(Grid& grid, std::mt19937& random)
+	{
+		const int rowCount = grid.GetRowCount();
+		const int columnCount = grid.GetColumnCount();
+		for (int row = 0; row < rowCount; ++row)
+		{
+			for (int column = 0; column < columnCount; ++column)
+			{
+				grid.SetTileType(row, column, ETileType::Wall);
+			}
+		}
+
+		constexpr int DIRECTIONS[4][2] = {{-2, 0}, {2, 0}, {0, -2}, {0, 2}};
+		std::vector<std::pair<int, int>> stack = {{1, 1}};
+		grid.SetTileType(1, 1, ETileType::Path);
+		while (!stack.empty())
+		{
+			const auto [row, column] = stack.back();
+
+			int candidates[4];
+			int candidateCount = 0;
+			for (int direction = 0; direction < 4; ++direction)
+			{
+				const int nextRow = row + DIRECTIONS[direction][0];
+				const int nextColumn = column + DIRECTIONS[direction][1];
+				if (nextRow > 0 && nextRow < rowCount - 1 && nextColumn > 0 && nextColumn < columnCount - 1
+					&& !grid.IsWalkable(nextRow, nextColumn))
+				{
+					candidates[candidateCount++] = direction;
+				}
+			}
+			if (candidateCount == 0)
+			{
+				stack.pop_back();
+				continue;
+			}
+
+			const int direction = candidates[RandomInt(random, candidateCount)];
+			const int nextRow = row + DIRECTIONS[direction][0];
+			const int nextColumn = column + DIRECTIONS[direction][1];
+			// 두 방 사이의 벽을 허문다.
+			grid.SetTileType((row + nextRow) / 2, (column + nextColumn) / 2, ETileType::Path);
+			grid.SetTileType(nextRow, nextColumn, ETileType::Path);
+			stack.push_back({nextRow, nextColumn});
+		}
+	}
+
+	// ROOM_SIZE 간격의 벽으로 방을 나누고, 벽 한 칸마다 문을 하나씩 낸다.
+	void GenerateRooms(Grid& grid, std::mt19937& random)
+	{
+		const int rowCount = grid.GetRowCount();
+		const int columnCount = grid.GetColumnCount();
+		for (int row = ROOM_SIZE; row < rowCount; row += ROOM_SIZE)
+		{
+			for (int column = 0; column < columnCount; ++column)
+			{
+				grid.SetTileType(row, column, ETileType::Wall);
+			}
+		}
+		for (int column = ROOM_SIZE; column < columnCount; column += ROOM_SIZE)
+		{
+			for (int row = 0; row < rowCount; ++row)
+			{
+				grid.SetTileType(row, column, ETileType::Wall);
+			}
+		}
+
+		for (int row = ROOM_SIZE; row < rowCount; row += ROOM_SIZE)
+		{
+			for (int left = 0; left < columnCount; left += ROOM_SIZE)
+			{
+				const int width = std::min(ROOM_SIZE - 1, columnCount - left - 1);
+				if (width > 0)
+				{
+					grid.SetTileType(row, left + 1 + RandomInt(random, width), ETileType::Path);
+				}
+			}
+		}
+		for (int column = ROOM_SIZE; column < columnCount; column += ROOM_SIZE)
+		{
+			for (int top = 0; top < rowCount; top += ROOM_SIZE)
+			{
+				const int height = std::min(ROOM_SIZE - 1, rowCount - top - 1);
+				if (height > 0)
+				{
+					grid.SetTileType(top + 1 + RandomInt(random, height), column, ETileType::Path);
+				}
+			}
+		}
+	}
+
+	// 랜덤 벽 위에 ROOM_SIZE 이하 크기의 늪/물 웅덩이를 흩뿌린다. 웅덩이가 덮은 벽은 지형으로 바뀐다.
+	void GenerateTerrain(Grid& grid, uint32_t seed, std::mt19937& random)
+	{
+		const int rowCount = grid.GetRowCount();
+		const int columnCount = grid.GetColumnCount();
+		grid.GenerateRandomWalls(PathfindingConfig::WALL_DENSITY, seed);
+
+		const int patchCount = grid.GetCellCount() / (ROOM_SIZE * ROOM_SIZE);
+		for (int i = 0; i < patchCount; ++i)
+		{
+			const ETileType type = RandomInt(random, 2) == 0 ? ETileType::Swamp : ETileType::Water;
+			const int top = RandomInt(random, rowCount);
+			const int left = RandomInt(random, columnCount);
+			const int bottom = std::min(top + 1 + RandomInt(random, ROOM_SIZE), rowCount);
+			const int right = std::min(left + 1 + RandomInt(random, ROOM_SIZE), columnCount);
+			for (int row = top; row < bottom; ++row)
+			{
+				for (int column = left; column < right; ++column)
+				{
+					grid.SetTileType(row, column, type);
+				}
+			}
+		}
+	}
+
+	// 가장 큰 연결 영역의 셀들. 대각선은 두 직교 이웃이 모두 열려 있어야 하므로 4방향 연결과 같다.
+	std::vector<int> FindLargestComponent(const Grid& grid)
+	{
+		std::vector<int> labels(grid.GetCellCount(), -1);
+		std::vector<int> largest;
+		std::vector<int> component;
+		for (int seed = 0; seed < grid.GetCellCount(); ++seed)
+		{
+			if (!grid.IsWalkable(seed) || labels[seed] != -1)
+			{
+				continue;
+			}
+
+			component.clear();
+			component.push_back(seed);
+			labels[seed] = seed;
+			for (size_t i = 0; i < component.size(); ++i)
+			{
+				grid.ForEachNeighbor<false>(component[i],
+											[&](int neighbor, bool)
+											{
+												if (labels[neighbor] == -1)
+												{
+													labels[neighbor] = seed;
+													component.push_back(neighbor);
+												}
+											});
+			}
+			if (component.size() > largest.size())
+			{
+				std::swap(component, largest);
+			}
+		}
+		return largest;
+	}
+
+	std::vector<int> FindWalkableCells(const Grid& grid)
+	{
+		std::vector<int> cells;
+		for (int index = 0; index < grid.GetCellCount(); ++index)
+		{
+			if (grid.IsWalkable(index))
+			{
+				cells.push_back(index);
+			}
+		}
+		return cells;
+	}
+
+	// cells에서 시작/도착 셀을 고른다.
+	void GenerateQueries(Scenario& scenario, const std::vector<int>& cells, int queryCount, std::mt19937& random)
+	{
+		if (cells.empty())
+		{
+			return;
+		}
+
+		scenario.Queries.reserve(queryCount);
+		for (int i = 0; i < queryCount; ++i)
+		{
+			const int start = cells[RandomInt(random, static_cast<int>(cells.size()))];
+			const int end = cells[RandomInt(random, static_cast<int>(cells.size()))];
+			PathQuery query;
+			query.Start = {scenario.Map.ToRow(start), scenario.Map.ToColumn(start)};
+			query.End = {scenario.Map.ToRow(end), scenario.Map.ToColumn(end)};
+			scenario.Queries.push_back(query);
+		}
+	}
+} // namespace
+
+Scenario BuildScenario(EScenarioType::Type type, int size, int queryCount, uint32_t seed)
+{
+	using Clock = std::chrono::steady_clock;
+
+	Scenario scenario;
+	scenario.Name = EScenarioType::to_string(type);
+	scenario.Type = type;
+	scenario.Size = size;
+	scenario.Seed = seed;
+
+	const Clock::time_point begin = Clock::now();
+	scenario.Map.Resize(size, size);
+	std::mt19937 random(seed);
+	switch (type)
+	{
+	case EScenarioType::Random:
+		scenario.Map.GenerateRandomWalls(PathfindingConfig::WALL_DENSITY, seed);
+		break;
+	case EScenarioType::Islands:
+		scenario.Map.GenerateRandomWalls(ISLANDS_WALL_DENSITY, seed);
+		break;
+	case EScenarioType::Maze:
+		GenerateMaze(scenario.Map, random);
+		break;
+	case EScenarioType::Rooms:
+		GenerateRooms(scenario.Map, random);
+		break;
+	case EScenarioType::Terrain:
+		GenerateTerrain(scenario.Map, seed, random);
+		break;
+	default:
+		break;
+	}
+	scenario.LoadMilliseconds = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+
+	const std::vector<int> cells = type == EScenarioType::Islands ? FindWalkableCells(scenario.Map)
+																		: FindLargestComponent(scenario.Map);
+	GenerateQueries(scenario, cells, queryCount, random);
+	return scenario;
+}
+
+bool LoadScenario(const std::string& mapPath, const std::string& scenarioPath, int queryCount, uint32_t seed,
+				  Scenario& scenario, std::string& error)
+{
+	using Clock = std::chrono::steady_clock;
+
+	scenario.Name = mapPath.substr(mapPath.find_last_of("/\\") + 1);
+	scenario.Seed = seed;
+
+	const Clock::time_point begin = Clock::now();
+	const bool bMovingAIMap = mapPath.size() >= 4 && mapPath.compare(mapPath.size() - 4, 4, ".map") == 0;
+	if (bMovingAIMap)
+	{
+		if (!LoadMovingAIMap(mapPath, scenario.Map, error))
+		{
+			return false;
+		}
+	}
+	else
+	{
+		if (!scenario.File.Open(mapPath))
+		{
+			error = scenario.File.GetError();
+			return false;
+		}
+		scenario.Map = scenario.File.GetGrid();
+	}
+	scenario.LoadMilliseconds = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+	scenario.Size = std::max(scenario.Map.GetRowCount(), scenario.Map.GetColumnCount());
+
+	if (scenarioPath.empty())
+	{
+		std::mt19937 random(seed);
+		GenerateQueries(scenario, FindLargestComponent(scenario.Map), queryCount, random);
+		return true;
+	}
+
+	std::vector<MovingAIScenarioEntry> entries;
+	if (!LoadMovingAIScenario(scenarioPath, entries, error))
+	{
+		return false;
+	}
+	for (const MovingAIScenarioEntry& entry : entries)
+	{
+		if (!scenario.Map.IsInBounds(entry.Start.Row, entry.Start.Column)
+			|| !scenario.Map.IsInBounds(entry.End.Row, entry.End.Column))
+		{
+			error = "scenario " + entry.MapName + " does not fit the loaded map";
+			return false;
+		}
+		PathQuery query;
+		query.Start = entry.Start;
+		query.End = entry.End;
+		scenario.Queries.push_back(query);
+		scenario.OptimalCosts.push_back(entry.OptimalLength);
+	}
+	return true;
+}
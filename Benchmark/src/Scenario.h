@@ -0,0 +1,86 @@
+#pragma once
+#include "Pathfinding/Grid.h"
+#include "Pathfinding/MapFile.h"
+#include "Pathfinding/PathResult.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace EScenarioType
+{
+	enum Type
+	{
+		Random = 0,
+		Maze,
+		OpenField,
+		Rooms,
+		// 랜덤 벽과 늪/물 웅덩이. 셀 비용 레이어를 쓴다.
+		Terrain,
+		// Random과 같은 맵이지만 연결 영역과 상관없이 통과 가능한 셀끼리 쿼리한다. 경로가 없는 쿼리가 섞인다.
+		Islands,
+		NUM_TYPES
+	};
+
+	inline const char* to_string(EScenarioType::Type e)
+	{
+		switch (e)
+		{
+		case EScenarioType::Random:
+			return "Random";
+		case EScenarioType::Maze:
+			return "Maze";
+		case EScenarioType::OpenField:
+			return "OpenField";
+		case EScenarioType::Rooms:
+			return "Rooms";
+		case EScenarioType::Terrain:
+			return "Terrain";
+		case EScenarioType::Islands:
+			return "Islands";
+		default:
+			return "Unknown";
+		}
+	}
+	inline EScenarioType::Type from_string(const std::string& str)
+	{
+		if (str == "Random")
+			return EScenarioType::Random;
+		else if (str == "Maze")
+			return EScenarioType::Maze;
+		else if (str == "OpenField")
+			return EScenarioType::OpenField;
+		else if (str == "Rooms")
+			return EScenarioType::Rooms;
+		else if (str == "Terrain")
+			return EScenarioType::Terrain;
+		else if (str == "Islands")
+			return EScenarioType::Islands;
+		return EScenarioType::NUM_TYPES;
+	}
+
+} // namespace EScenarioType
+
+// 한 맵과 그 위에서 실행할 쿼리 묶음. 타입, 크기, 시드가 같으면 항상 같은 내용이 만들어진다.
+struct Scenario
+{
+	std::string Name;
+	EScenarioType::Type Type = EScenarioType::Random;
+	int Size = 0;
+	uint32_t Seed = 0;
+	// .pfmap을 읽은 경우 Map은 File의 메모리를 가리킨다.
+	MapFile File;
+	Grid Map;
+	// Islands가 아니면 시작/도착 셀은 항상 서로 도달 가능하다. Method는 실행할 때 정한다.
+	std::vector<PathQuery> Queries;
+	// .scen에서 읽은 최적 거리. 비어 있으면 비교하지 않는다.
+	std::vector<double> OptimalCosts;
+	// 맵을 만들거나 읽는 데 걸린 시간
+	double LoadMilliseconds = 0.0;
+};
+
+Scenario BuildScenario(EScenarioType::Type type, int size, int queryCount, uint32_t seed);
+// mapPath가 .map이면 MovingAI 형식으로 읽고, 아니면 .pfmap으로 보고 메모리에 맵한다.
+// scenarioPath가 비어 있으면 가장 큰 연결 영역에서 queryCount개의 쿼리를 만든다.
+bool LoadScenario(const std::string& mapPath, const std::string& scenarioPath, int queryCount, uint32_t seed,
+				  Scenario& scenario, std::string& error);
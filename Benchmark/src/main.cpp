@@ -0,0 +1,764 @@
+#include "BenchmarkReport.h"
+#include "MicroBenchmark.h"
+#include "Scenario.h"
+
+#include "Pathfinding/AStarSearch.h"
+#include "Pathfinding/BatchPathfinder.h"
+#include "Pathfinding/BidirectionalSearch.h"
+#include "Pathfinding/ConnectivityIndex.h"
+#include "Pathfinding/HierarchicalPathfinder.h"
+#include "Pathfinding/LandmarkTable.h"
+#include "Pathfinding/PathSmoothing.h"
+#include "Pathfinding/PathfindingTypes.h"
+#include "Pathfinding/SearchScheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+	// 마이크로벤치마크에서 시나리오마다 만드는 샘플 수
+	constexpr int MICRO_SAMPLE_COUNT = 20000;
+	// 프레임 예산 모드에서 SearchScheduler가 동시에 실행하는 요청 수
+	constexpr int SCHEDULED_ACTIVE_COUNT = 8;
+
+	struct BenchmarkOptions
+	{
+		std::vector<EScenarioType::Type> Scenarios;
+		std::vector<int> Sizes = {128, 256, 512};
+		std::vector<EHeuristicMethod::Type> Heuristics;
+		int QueryCount = 200;
+		uint32_t Seed = 1;
+		ESearchAlgorithm::Type Algorithm = ESearchAlgorithm::AStar;
+		// --algorithm Hierarchical. ESearchAlgorithm에 없는 HierarchicalPathfinder(HPA*)로 실행한다.
+		bool bHierarchical = false;
+		EOpenListType::Type OpenListType = EOpenListType::BinaryHeap;
+		// Bidirectional에서 2면 두 방향을 서로 다른 스레드에서 탐색한다.
+		int ThreadCount = 1;
+		// 켜면 맵마다 ConnectivityIndex를 만들어 서로 다른 영역을 잇는 쿼리를 탐색 없이 거절한다.
+		bool bUseConnectivity = false;
+		// 켜면 쿼리마다 BuildWaypoints까지 재고, 웨이포인트 수와 길이를 보고한다.
+		bool bBuildWaypoints = false;
+		// 0보다 크면 모든 쿼리를 SearchScheduler에 한 번에 제출하고 프레임마다 이 시간만큼 Update한다.
+		int FrameBudgetMicroseconds = 0;
+		// 비어 있지 않으면 모든 쿼리를 이 워커 수마다 BatchPathfinder로 한 번에 처리하고 처리량을 보고한다.
+		std::vector<int> BatchThreadCounts;
+		EReportFormat::Type Format = EReportFormat::Table;
+		// 지정하면 생성 시나리오 대신 이 맵(.map 또는 .pfmap)과 .scen 쿼리를 쓴다.
+		std::string MapPath;
+		std::string ScenarioPath;
+		// 비어 있지 않으면 쿼리 대신 이 마이크로벤치마크들을 실행한다.
+		std::vector<EMicroBenchmarkType::Type> MicroBenchmarks;
+	};
+
+	void PrintUsage()
+	{
+		std::cerr << "Usage: Benchmark [options]\n"
+					 "  --scenario <All|Random|Maze|OpenField|Rooms|Terrain|Islands> (default All)\n"
+					 "  --sizes <n,n,...>                               (default 128,256,512)\n"
+					 "  --heuristic <All|None|Manhattan|Euclidean|Octile|ALT> (default All)\n"
+					 "  --queries <n>                                   (default 200)\n"
+					 "  --seed <n>                                      (default 1)\n"
+					 "  --algorithm <AStar|JumpPointSearch|Bidirectional|ThetaStar|LazyThetaStar|Hierarchical>\n"
+					 "                                                  (default AStar)\n"
+					 "  --threads <1|2>                                 Bidirectional only (default 1)\n"
+					 "  --open-list <BinaryHeap|QuaternaryHeap|BucketQueue|PriorityQueue>\n"
+					 "  --connectivity <Off|On>                         reject unreachable queries (default Off)\n"
+					 "  --waypoints <Off|On>                            string-pull each path into waypoints\n"
+					 "                                                  (default Off)\n"
+					 "  --frame-budget <us>                             submit all queries to a SearchScheduler and\n"
+					 "                                                  update it with this budget per frame\n"
+					 "  --batch-threads <n,n,...>                       run all queries through a BatchPathfinder\n"
+					 "                                                  with each worker count\n"
+					 "  --format <Table|Csv|Json>                       (default Table)\n"
+					 "  --map <path.map|path.pfmap>                     run on a loaded map instead of generated ones\n"
+					 "  --scen <path.scen>                              MovingAI queries for --map (checked against\n"
+					 "                                                  their optimal lengths)\n"
+					 "  --micro <All|JumpScan|LineOfSight>              compare per-cell and bitboard wall tests\n"
+					 "                                                  instead of running queries\n";
+	}
+
+	bool ParseOptions(int argc, char** argv, BenchmarkOptions& options)
+	{
+		std::string scenario = "All";
+		std::string heuristic = "All";
+		for (int i = 1; i < argc; ++i)
+		{
+			const std::string option = argv[i];
+			if (i + 1 >= argc)
+			{
+				return false;
+			}
+			const std::string value = argv[++i];
+			if (option == "--scenario")
+			{
+				scenario = value;
+			}
+			else if (option == "--sizes")
+			{
+				options.Sizes.clear();
+				std::stringstream stream(value);
+				for (std::string size; std::getline(stream, size, ',');)
+				{
+					options.Sizes.push_back(std::atoi(size.c_str()));
+				}
+			}
+			else if (option == "--heuristic")
+			{
+				heuristic = value;
+			}
+			else if (option == "--queries")
+			{
+				options.QueryCount = std::atoi(value.c_str());
+			}
+			else if (option == "--seed")
+			{
+				options.Seed = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+			}
+			else if (option == "--algorithm")
+			{
+				// from_string은 모르는 이름을 기본값으로 돌려주므로 이름을 되돌려 확인한다.
+				options.bHierarchical = value == "Hierarchical";
+				options.Algorithm = ESearchAlgorithm::from_string(value);
+				if (!options.bHierarchical
+					&& (value != ESearchAlgorithm::to_string(options.Algorithm)
+						|| options.Algorithm == ESearchAlgorithm::DStarLite))
+				{
+					return false;
+				}
+			}
+			else if (option == "--frame-budget")
+			{
+				options.FrameBudgetMicroseconds = std::atoi(value.c_str());
+			}
+			else if (option == "--batch-threads")
+			{
+				options.BatchThreadCounts.clear();
+				std::stringstream stream(value);
+				for (std::string threadCount; std::getline(stream, threadCount, ',');)
+				{
+					options.BatchThreadCounts.push_back(std::atoi(threadCount.c_str()));
+				}
+				if (options.BatchThreadCounts.empty())
+				{
+					return false;
+				}
+			}
+			else if (option == "--threads")
+			{
+				options.ThreadCount = std::atoi(value.c_str());
+			}
+			else if (option == "--open-list")
+			{
+				options.OpenListType = EOpenListType::from_string(value);
+				if (value != EOpenListType::to_string(options.OpenListType))
+				{
+					return false;
+				}
+			}
+			else if (option == "--connectivity")
+			{
+				if (value != "On" && value != "Off")
+				{
+					return false;
+				}
+				options.bUseConnectivity = value == "On";
+			}
+			else if (option == "--waypoints")
+			{
+				if (value != "On" && value != "Off")
+				{
+					return false;
+				}
+				options.bBuildWaypoints = value == "On";
+			}
+			else if (option == "--map")
+			{
+				options.MapPath = value;
+			}
+			else if (option == "--scen")
+			{
+				options.ScenarioPath = value;
+			}
+			else if (option == "--micro")
+			{
+				options.MicroBenchmarks.clear();
+				for (int type = 0; type < EMicroBenchmarkType::NUM_TYPES; ++type)
+				{
+					const auto microType = static_cast<EMicroBenchmarkType::Type>(type);
+					if (value == "All" || value == EMicroBenchmarkType::to_string(microType))
+					{
+						options.MicroBenchmarks.push_back(microType);
+					}
+				}
+				if (options.MicroBenchmarks.empty())
+				{
+					return false;
+				}
+			}
+			else if (option == "--format")
+			{
+				options.Format = EReportFormat::from_string(value);
+				if (options.Format == EReportFormat::NUM_TYPES)
+				{
+					return false;
+				}
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		for (int i = 0; i < EScenarioType::NUM_TYPES; ++i)
+		{
+			const auto type = static_cast<EScenarioType::Type>(i);
+			if (scenario == "All" || scenario == EScenarioType::to_string(type))
+			{
+				options.Scenarios.push_back(type);
+			}
+		}
+		for (int i = 0; i < EHeuristicMethod::NUM_TYPES; ++i)
+		{
+			const auto method = static_cast<EHeuristicMethod::Type>(i);
+			if (heuristic == "All" || heuristic == EHeuristicMethod::to_string(method))
+			{
+				options.Heuristics.push_back(method);
+			}
+		}
+		auto isValidSize = [](int size) { return size > 2; };
+		const bool bValidSizes
+			= !options.Sizes.empty() && std::all_of(options.Sizes.begin(), options.Sizes.end(), isValidSize);
+		const bool bValidFiles = options.ScenarioPath.empty() || !options.MapPath.empty();
+		const bool bBidirectional = options.Algorithm == ESearchAlgorithm::Bidirectional;
+		const bool bValidThreads = options.ThreadCount == 1 || (options.ThreadCount == 2 && bBidirectional);
+		const bool bValidFrameBudget
+			= options.FrameBudgetMicroseconds == 0 || (options.FrameBudgetMicroseconds > 0 && !bBidirectional);
+		// BatchPathfinder는 워커마다 AStarSearch를 두므로 양방향 탐색과 프레임 예산 모드와는 함께 쓸 수 없다.
+		auto isValidThreadCount = [](int threadCount) { return threadCount > 0; };
+		const bool bValidBatch = options.BatchThreadCounts.empty()
+								 || (!bBidirectional && options.FrameBudgetMicroseconds == 0
+									 && std::all_of(options.BatchThreadCounts.begin(), options.BatchThreadCounts.end(),
+													isValidThreadCount));
+		// HPA*는 한 번에 한 쿼리를 끝까지 풀고 연결 영역 표를 쓰지 않는다.
+		const bool bValidHierarchical = !options.bHierarchical
+										|| (options.FrameBudgetMicroseconds == 0 && options.BatchThreadCounts.empty()
+											&& !options.bUseConnectivity);
+		return !options.Scenarios.empty() && !options.Heuristics.empty() && bValidSizes && bValidFiles && bValidThreads
+			   && bValidFrameBudget && bValidBatch && bValidHierarchical && options.QueryCount > 0;
+	}
+
+	double GetPercentile(const std::vector<double>& sortedValues, double percentile)
+	{
+		const size_t index = static_cast<size_t>(percentile * (sortedValues.size() - 1) + 0.5);
+		return sortedValues[std::min(index, sortedValues.size() - 1)];
+	}
+
+	// .scen의 거리는 소수점 아래 8자리까지 적혀 있고, float 누적 오차도 있으므로 상대 오차로 비교한다.
+	bool IsSameCost(const PathResult& result, double optimalCost)
+	{
+		if (!result.bFound)
+		{
+			return false;
+		}
+		return std::abs(result.Cost - optimalCost) <= 1e-4 * std::max(1.0, optimalCost);
+	}
+
+	// ALT 랜드마크는 AStarSearch만 쓴다. 나머지 탐색에서 ALT는 Octile로 동작한다.
+	void ConfigureSearch(AStarSearch& search, const BenchmarkOptions& options, const LandmarkTable* landmarks,
+						 const ConnectivityIndex* connectivity)
+	{
+		search.SetAlgorithm(options.Algorithm);
+		search.SetOpenListType(options.OpenListType);
+		search.SetLandmarks(landmarks);
+		search.SetConnectivity(connectivity);
+	}
+
+	void ConfigureSearch(BidirectionalSearch& search, const BenchmarkOptions& options,
+						 const LandmarkTable* /*landmarks*/, const ConnectivityIndex* connectivity)
+	{
+		search.SetParallel(options.ThreadCount == 2);
+		search.SetConnectivity(connectivity);
+	}
+
+	size_t GetSearchMemoryUsage(const AStarSearch& search)
+	{
+		return search.GetSearchSpace().GetMemoryUsage();
+	}
+
+	size_t GetSearchMemoryUsage(const BidirectionalSearch& search)
+	{
+		return search.GetMemoryUsage();
+	}
+
+	// 쿼리 결과를 모아 BenchmarkRow의 평균과 지연 시간 백분위를 채운다.
+	struct RowAccumulator
+	{
+		std::vector<double> Latencies;
+		double NodesExpanded = 0.0;
+		double PeakOpenListSize = 0.0;
+		double PathCost = 0.0;
+		double WaypointCount = 0.0;
+		double WaypointLength = 0.0;
+
+		void AddResult(BenchmarkRow& row, const PathResult& result)
+		{
+			if (result.bFound)
+			{
+				++row.FoundCount;
+				PathCost += result.Cost;
+				WaypointCount += static_cast<double>(result.Waypoints.size());
+				WaypointLength += GetWaypointPathLength(result.Waypoints);
+			}
+		}
+
+		void Finish(BenchmarkRow& row)
+		{
+			const double queryCount = static_cast<double>(Latencies.size());
+			row.QueriesPerSecond = row.TotalMilliseconds > 0.0 ? queryCount * 1000.0 / row.TotalMilliseconds : 0.0;
+			row.MeanNodesExpanded = NodesExpanded / queryCount;
+			row.MeanPeakOpenListSize = PeakOpenListSize / queryCount;
+			row.MeanPathCost = row.FoundCount > 0 ? PathCost / row.FoundCount : 0.0;
+			row.MeanWaypointCount = row.FoundCount > 0 ? WaypointCount / row.FoundCount : 0.0;
+			row.MeanWaypointLength = row.FoundCount > 0 ? WaypointLength / row.FoundCount : 0.0;
+
+			std::sort(Latencies.begin(), Latencies.end());
+			row.P50Microseconds = GetPercentile(Latencies, 0.50);
+			row.P90Microseconds = GetPercentile(Latencies, 0.90);
+			row.P99Microseconds = GetPercentile(Latencies, 0.99);
+			row.MaxMicroseconds = Latencies.back();
+		}
+	};
+
+	BenchmarkRow CreateRow(const Scenario& scenario, EHeuristicMethod::Type method)
+	{
+		BenchmarkRow row;
+		row.Scenario = scenario.Name;
+		row.Size = scenario.Size;
+		row.MapLoadMilliseconds = scenario.LoadMilliseconds;
+		row.Heuristic = EHeuristicMethod::to_string(method);
+		row.QueryCount = static_cast<int>(scenario.Queries.size());
+		return row;
+	}
+
+	// 전처리는 맵마다 한 번이므로 쿼리 지연 시간과 따로 잰다.
+	void Preprocess(const Scenario& scenario, bool bBuildLandmarks, const BenchmarkOptions& options,
+					LandmarkTable& landmarks, ConnectivityIndex& connectivity, BenchmarkRow& row)
+	{
+		using Clock = std::chrono::steady_clock;
+		if (bBuildLandmarks)
+		{
+			const Clock::time_point begin = Clock::now();
+			landmarks.Build(scenario.Map);
+			row.PreprocessMilliseconds = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+		}
+		if (options.bUseConnectivity)
+		{
+			const Clock::time_point begin = Clock::now();
+			connectivity.Build();
+			row.PreprocessMilliseconds += std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+		}
+	}
+
+	// .scen의 최적 거리는 8방향 이동 기준이므로 Manhattan(4방향)이나 직선 거리를 쓰는 Theta*와는 비교하지 않는다.
+	bool ShouldCheckOptimal(const Scenario& scenario, EHeuristicMethod::Type method, const BenchmarkOptions& options)
+	{
+		const bool bAnyAngle = options.Algorithm == ESearchAlgorithm::ThetaStar
+							   || options.Algorithm == ESearchAlgorithm::LazyThetaStar;
+		return !scenario.OptimalCosts.empty() && method != EHeuristicMethod::Manhattan && !bAnyAngle;
+	}
+
+	template <typename TSearch>
+	BenchmarkRow RunScenario(const Scenario& scenario, EHeuristicMethod::Type method, const BenchmarkOptions& options)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		BenchmarkRow row = CreateRow(scenario, method);
+		if (scenario.Queries.empty())
+		{
+			return row;
+		}
+
+		LandmarkTable landmarks;
+		ConnectivityIndex connectivity(scenario.Map);
+		Preprocess(scenario, method == EHeuristicMethod::ALT && std::is_same_v<TSearch, AStarSearch>, options,
+				   landmarks, connectivity, row);
+
+		TSearch search(scenario.Map);
+		ConfigureSearch(search, options, &landmarks, options.bUseConnectivity ? &connectivity : nullptr);
+
+		// 첫 쿼리에서 생기는 버퍼 할당은 측정에서 뺀다.
+		PathResult result;
+		search.Reset(scenario.Queries.front().Start, scenario.Queries.front().End, method);
+		search.Run();
+
+		RowAccumulator accumulator;
+		accumulator.Latencies.reserve(scenario.Queries.size());
+		const bool bCheckOptimal = ShouldCheckOptimal(scenario, method, options);
+		row.OptimalMismatchCount = bCheckOptimal ? 0 : -1;
+		for (size_t i = 0; i < scenario.Queries.size(); ++i)
+		{
+			const PathQuery& query = scenario.Queries[i];
+			const Clock::time_point begin = Clock::now();
+			search.Reset(query.Start, query.End, method);
+			// result의 용량을 재사용한다.
+			search.Run(result);
+			if (options.bBuildWaypoints)
+			{
+				BuildWaypoints(scenario.Map, result);
+			}
+			const double latency = std::chrono::duration<double, std::micro>(Clock::now() - begin).count();
+			accumulator.Latencies.push_back(latency);
+			row.TotalMilliseconds += latency / 1000.0;
+
+			const SearchStats& stats = search.GetStats();
+			accumulator.NodesExpanded += stats.NodesExpanded;
+			accumulator.PeakOpenListSize += static_cast<double>(stats.PeakOpenListSize);
+			row.MaxPeakOpenListSize = std::max(row.MaxPeakOpenListSize, stats.PeakOpenListSize);
+			accumulator.AddResult(row, result);
+			if (bCheckOptimal && !IsSameCost(result, scenario.OptimalCosts[i]))
+			{
+				++row.OptimalMismatchCount;
+			}
+		}
+
+		accumulator.Finish(row);
+		row.MemoryBytes = scenario.Map.GetMemoryUsage() + GetSearchMemoryUsage(search) + landmarks.GetMemoryUsage()
+						  + connectivity.GetMemoryUsage();
+		return row;
+	}
+
+	// 모든 쿼리를 한 번에 SearchScheduler에 제출하고, 모두 끝날 때까지 프레임마다 예산만큼 Update한다.
+	// 지연 시간은 제출부터 그 쿼리가 끝난 프레임까지 Update에 쓴 시간이다(프레임 사이의 대기는 없다).
+	BenchmarkRow RunScheduledScenario(const Scenario& scenario, EHeuristicMethod::Type method,
+									  const BenchmarkOptions& options)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		BenchmarkRow row = CreateRow(scenario, method);
+		if (scenario.Queries.empty())
+		{
+			return row;
+		}
+
+		LandmarkTable landmarks;
+		ConnectivityIndex connectivity(scenario.Map);
+		Preprocess(scenario, method == EHeuristicMethod::ALT, options, landmarks, connectivity, row);
+
+		SearchScheduler scheduler(scenario.Map, SCHEDULED_ACTIVE_COUNT);
+		scheduler.SetAlgorithm(options.Algorithm);
+		scheduler.SetOpenListType(options.OpenListType);
+		scheduler.SetLandmarks(&landmarks);
+		scheduler.SetConnectivity(options.bUseConnectivity ? &connectivity : nullptr);
+		scheduler.SetBuildWaypoints(options.bBuildWaypoints);
+
+		// 탐색 상태 할당과 첫 쿼리의 버퍼 할당은 측정에서 뺀다.
+		scheduler.Reserve();
+		PathQuery warmUp = scenario.Queries.front();
+		warmUp.Method = method;
+		const int warmUpHandle = scheduler.Submit(warmUp);
+		scheduler.Update({});
+		scheduler.Release(warmUpHandle);
+
+		std::vector<int> handles;
+		handles.reserve(scenario.Queries.size());
+		for (PathQuery query : scenario.Queries)
+		{
+			query.Method = method;
+			handles.push_back(scheduler.Submit(query));
+		}
+
+		RowAccumulator accumulator;
+		const SearchBudget frameBudget = {0, std::chrono::microseconds(options.FrameBudgetMicroseconds)};
+		std::vector<char> finished(handles.size(), 0);
+		size_t finishedCount = 0;
+		double elapsedMicroseconds = 0.0;
+		while (finishedCount < handles.size())
+		{
+			const Clock::time_point begin = Clock::now();
+			accumulator.NodesExpanded += scheduler.Update(frameBudget);
+			const double frameMicroseconds = std::chrono::duration<double, std::micro>(Clock::now() - begin).count();
+			elapsedMicroseconds += frameMicroseconds;
+			++row.FrameCount;
+			row.MaxFrameMicroseconds = std::max(row.MaxFrameMicroseconds, frameMicroseconds);
+			for (size_t i = 0; i < handles.size(); ++i)
+			{
+				if (!finished[i] && scheduler.GetState(handles[i]) == ESearchRequestState::Finished)
+				{
+					finished[i] = 1;
+					++finishedCount;
+					accumulator.Latencies.push_back(elapsedMicroseconds);
+				}
+			}
+		}
+		row.TotalMilliseconds = elapsedMicroseconds / 1000.0;
+
+		const bool bCheckOptimal = ShouldCheckOptimal(scenario, method, options);
+		row.OptimalMismatchCount = bCheckOptimal ? 0 : -1;
+		PathResult result;
+		for (size_t i = 0; i < handles.size(); ++i)
+		{
+			scheduler.GetResult(handles[i], result);
+			const SearchStats stats = scheduler.GetStats(handles[i]);
+			accumulator.PeakOpenListSize += static_cast<double>(stats.PeakOpenListSize);
+			row.MaxPeakOpenListSize = std::max(row.MaxPeakOpenListSize, stats.PeakOpenListSize);
+			accumulator.AddResult(row, result);
+			if (bCheckOptimal && !IsSameCost(result, scenario.OptimalCosts[i]))
+			{
+				++row.OptimalMismatchCount;
+			}
+		}
+
+		accumulator.Finish(row);
+		row.MemoryBytes = scenario.Map.GetMemoryUsage() + scheduler.GetMemoryUsage() + landmarks.GetMemoryUsage()
+						  + connectivity.GetMemoryUsage();
+		return row;
+	}
+
+	// 맵마다 HPA* 추상 그래프를 만들고(전처리) 쿼리마다 FindPath를 잰다. 휴리스틱은 Manhattan이면 4방향,
+	// 나머지는 8방향 이동을 고르는 데만 쓰인다. 결과는 최적이 아닐 수 있으므로 NotOpt가 0이 아닐 수 있다.
+	BenchmarkRow RunHierarchicalScenario(const Scenario& scenario, EHeuristicMethod::Type method,
+										 const BenchmarkOptions& options)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		BenchmarkRow row = CreateRow(scenario, method);
+		if (scenario.Queries.empty())
+		{
+			return row;
+		}
+
+		HierarchicalPathfinder pathfinder(scenario.Map);
+		const Clock::time_point buildBegin = Clock::now();
+		pathfinder.Build(method != EHeuristicMethod::Manhattan);
+		row.PreprocessMilliseconds = std::chrono::duration<double, std::milli>(Clock::now() - buildBegin).count();
+
+		// 첫 쿼리에서 생기는 버퍼 할당은 측정에서 뺀다.
+		pathfinder.FindPath(scenario.Queries.front().Start, scenario.Queries.front().End);
+
+		RowAccumulator accumulator;
+		accumulator.Latencies.reserve(scenario.Queries.size());
+		const bool bCheckOptimal = ShouldCheckOptimal(scenario, method, options);
+		row.OptimalMismatchCount = bCheckOptimal ? 0 : -1;
+		for (size_t i = 0; i < scenario.Queries.size(); ++i)
+		{
+			const PathQuery& query = scenario.Queries[i];
+			const Clock::time_point begin = Clock::now();
+			PathResult result = pathfinder.FindPath(query.Start, query.End);
+			if (options.bBuildWaypoints)
+			{
+				BuildWaypoints(scenario.Map, result);
+			}
+			const double latency = std::chrono::duration<double, std::micro>(Clock::now() - begin).count();
+			accumulator.Latencies.push_back(latency);
+			row.TotalMilliseconds += latency / 1000.0;
+
+			accumulator.NodesExpanded += result.Stats.NodesExpanded;
+			accumulator.PeakOpenListSize += static_cast<double>(result.Stats.PeakOpenListSize);
+			row.MaxPeakOpenListSize = std::max(row.MaxPeakOpenListSize, result.Stats.PeakOpenListSize);
+			accumulator.AddResult(row, result);
+			if (bCheckOptimal && !IsSameCost(result, scenario.OptimalCosts[i]))
+			{
+				++row.OptimalMismatchCount;
+			}
+		}
+
+		accumulator.Finish(row);
+		row.MemoryBytes = scenario.Map.GetMemoryUsage() + pathfinder.GetMemoryUsage();
+		return row;
+	}
+
+	// 모든 쿼리를 워커 수마다 BatchPathfinder::Run 한 번으로 처리하고, 워커 수마다 행을 하나씩 만든다.
+	// 처리량은 Run 전체의 벽시계 시간으로 재고, 지연 시간은 워커 안에서 탐색에 쓴 시간이다.
+	// BatchSpeedup은 처음 지정한 워커 수의 처리량 대비 배율이다.
+	std::vector<BenchmarkRow> RunBatchScenario(const Scenario& scenario, EHeuristicMethod::Type method,
+											   const BenchmarkOptions& options)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		BenchmarkRow preprocessRow = CreateRow(scenario, method);
+		if (scenario.Queries.empty())
+		{
+			return {preprocessRow};
+		}
+
+		LandmarkTable landmarks;
+		ConnectivityIndex connectivity(scenario.Map);
+		Preprocess(scenario, method == EHeuristicMethod::ALT, options, landmarks, connectivity, preprocessRow);
+
+		std::vector<PathQuery> queries = scenario.Queries;
+		for (PathQuery& query : queries)
+		{
+			query.Method = method;
+		}
+
+		std::vector<BenchmarkRow> rows;
+		std::vector<PathResult> results;
+		const bool bCheckOptimal = ShouldCheckOptimal(scenario, method, options);
+		for (int threadCount : options.BatchThreadCounts)
+		{
+			BatchPathfinder batch(scenario.Map, threadCount);
+			batch.SetAlgorithm(options.Algorithm);
+			batch.SetOpenListType(options.OpenListType);
+			batch.SetLandmarks(&landmarks);
+			batch.SetConnectivity(options.bUseConnectivity ? &connectivity : nullptr);
+			batch.SetBuildWaypoints(options.bBuildWaypoints);
+
+			// 어느 워커가 어떤 쿼리를 가져갈지 정해져 있지 않으므로, 한 번 전부 돌려 모든 워커의 버퍼 할당을 뺀다.
+			batch.Run(queries, results);
+
+			BenchmarkRow row = preprocessRow;
+			row.BatchThreadCount = batch.GetThreadCount();
+			const Clock::time_point begin = Clock::now();
+			batch.Run(queries, results);
+			row.TotalMilliseconds = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+
+			RowAccumulator accumulator;
+			accumulator.Latencies.reserve(results.size());
+			row.OptimalMismatchCount = bCheckOptimal ? 0 : -1;
+			size_t scratchBytes = 0;
+			for (size_t i = 0; i < results.size(); ++i)
+			{
+				const SearchStats& stats = results[i].Stats;
+				accumulator.Latencies.push_back(std::chrono::duration<double, std::micro>(stats.ElapsedTime).count());
+				accumulator.NodesExpanded += stats.NodesExpanded;
+				accumulator.PeakOpenListSize += static_cast<double>(stats.PeakOpenListSize);
+				row.MaxPeakOpenListSize = std::max(row.MaxPeakOpenListSize, stats.PeakOpenListSize);
+				scratchBytes = std::max(scratchBytes, stats.ScratchBytes);
+				accumulator.AddResult(row, results[i]);
+				if (bCheckOptimal && !IsSameCost(results[i], scenario.OptimalCosts[i]))
+				{
+					++row.OptimalMismatchCount;
+				}
+			}
+
+			accumulator.Finish(row);
+			const double baseQueriesPerSecond = rows.empty() ? row.QueriesPerSecond : rows.front().QueriesPerSecond;
+			row.BatchSpeedup = baseQueriesPerSecond > 0.0 ? row.QueriesPerSecond / baseQueriesPerSecond : 0.0;
+			// 워커마다 탐색 상태를 하나씩 가진다.
+			row.MemoryBytes = scenario.Map.GetMemoryUsage() + scratchBytes * row.BatchThreadCount
+							  + landmarks.GetMemoryUsage() + connectivity.GetMemoryUsage();
+			rows.push_back(row);
+		}
+		return rows;
+	}
+
+	BenchmarkRow RunScenario(const Scenario& scenario, EHeuristicMethod::Type method, const BenchmarkOptions& options)
+	{
+		if (options.bHierarchical)
+		{
+			return RunHierarchicalScenario(scenario, method, options);
+		}
+		if (options.Algorithm == ESearchAlgorithm::Bidirectional)
+		{
+			return RunScenario<BidirectionalSearch>(scenario, method, options);
+		}
+		if (options.FrameBudgetMicroseconds > 0)
+		{
+			return RunScheduledScenario(scenario, method, options);
+		}
+		return RunScenario<AStarSearch>(scenario, method, options);
+	}
+
+	long GetPeakResidentKilobytes()
+	{
+#if defined(__unix__) || defined(__APPLE__)
+		rusage usage = {};
+		getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+		return usage.ru_maxrss / 1024;
+#else
+		return usage.ru_maxrss;
+#endif
+#else
+		return 0;
+#endif
+	}
+} // namespace
+
+int main(int argc, char** argv)
+{
+	BenchmarkOptions options;
+	if (!ParseOptions(argc, argv, options))
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	std::vector<BenchmarkRow> rows;
+	std::vector<MicroBenchmarkRow> microRows;
+	auto runScenario = [&](const Scenario& scenario)
+	{
+		for (EMicroBenchmarkType::Type type : options.MicroBenchmarks)
+		{
+			microRows.push_back(RunMicroBenchmark(type, scenario, MICRO_SAMPLE_COUNT, options.Seed));
+		}
+		if (options.MicroBenchmarks.empty())
+		{
+			for (EHeuristicMethod::Type method : options.Heuristics)
+			{
+				if (!options.BatchThreadCounts.empty())
+				{
+					const std::vector<BenchmarkRow> batchRows = RunBatchScenario(scenario, method, options);
+					rows.insert(rows.end(), batchRows.begin(), batchRows.end());
+					continue;
+				}
+				rows.push_back(RunScenario(scenario, method, options));
+			}
+		}
+	};
+	if (!options.MapPath.empty())
+	{
+		Scenario scenario;
+		std::string error;
+		if (!LoadScenario(options.MapPath, options.ScenarioPath, options.QueryCount, options.Seed, scenario, error))
+		{
+			std::cerr << "Failed to load " << options.MapPath << ": " << error << "\n";
+			return 1;
+		}
+		runScenario(scenario);
+		options.Scenarios.clear();
+	}
+	for (EScenarioType::Type type : options.Scenarios)
+	{
+		for (int size : options.Sizes)
+		{
+			runScenario(BuildScenario(type, size, options.QueryCount, options.Seed));
+		}
+	}
+
+	BenchmarkMetadata metadata;
+	metadata.Seed = options.Seed;
+	metadata.QueryCount = options.QueryCount;
+	metadata.Algorithm = options.bHierarchical ? "Hierarchical" : ESearchAlgorithm::to_string(options.Algorithm);
+	metadata.ThreadCount = options.ThreadCount;
+	metadata.OpenListType = EOpenListType::to_string(options.OpenListType);
+	metadata.bUseConnectivity = options.bUseConnectivity;
+	metadata.bBuildWaypoints = options.bBuildWaypoints;
+	metadata.FrameBudgetMicroseconds = options.FrameBudgetMicroseconds;
+	metadata.PeakResidentKilobytes = GetPeakResidentKilobytes();
+	if (!options.MicroBenchmarks.empty())
+	{
+#if defined(__AVX2__)
+		const std::string scanPath = "AVX2";
+#else
+		const std::string scanPath = "Scalar";
+#endif
+		WriteMicroReport(std::cout, options.Format, metadata, scanPath, microRows);
+		return 0;
+	}
+	WriteReport(std::cout, options.Format, metadata, rows);
+	return 0;
+}
@@ -0,0 +1,503 @@
+#include "AStarSearch.h"
+
+#include "Pathfinding/CostFunctions.h"
+#include "Pathfinding/PathSmoothing.h"
+#include "Pathfinding/Profiling.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <type_traits>
+
+AStarSearch::AStarSearch(const Grid& grid)
+	: grid_(grid)
+	, jumpPointScanner_(grid)
+{
+}
+
+void AStarSearch::Reset(const GridPosition& start, const GridPosition& end, EHeuristicMethod::Type method)
+{
+	PATHFINDING_ZONE("AStarSearch::Reset");
+	startIndex_ = grid_.ToIndex(start.Row, start.Column);
+	endIndex_ = grid_.ToIndex(end.Row, end.Column);
+	end_ = end;
+	method_ = method;
+	bPathFound_ = false;
+	bestIndex_ = SearchSpace::INVALID_INDEX;
+	bestHCost_ = std::numeric_limits<float>::max();
+	stats_ = {};
+
+	activeAlgorithm_ = algorithm_;
+	const bool bUniformDiagonal = method != EHeuristicMethod::Manhattan && !grid_.HasTileCosts();
+	if (((activeAlgorithm_ == ESearchAlgorithm::JumpPointSearch || IsAnyAngle()) && !bUniformDiagonal)
+		|| activeAlgorithm_ == ESearchAlgorithm::DStarLite || activeAlgorithm_ == ESearchAlgorithm::Bidirectional)
+	{
+		activeAlgorithm_ = ESearchAlgorithm::AStar;
+	}
+	// 직선 거리 경로에서 Octile과 랜드마크 하한은 실제 비용보다 클 수 있다.
+	if (IsAnyAngle() && method != EHeuristicMethod::None)
+	{
+		method_ = EHeuristicMethod::Euclidean;
+	}
+
+	const bool bLandmarksReady
+		= landmarks_ && landmarks_->IsBuilt() && landmarks_->GetCellCount() == grid_.GetCellCount();
+	activeLandmarks_ = method_ == EHeuristicMethod::ALT && bLandmarksReady ? landmarks_ : nullptr;
+
+	// 행/열 비트보드는 처음 쓸 때 만들어지므로 탐색 시간에 섞이지 않도록 여기서 만들어 둔다.
+	if (activeAlgorithm_ == ESearchAlgorithm::JumpPointSearch)
+	{
+		jumpPointScanner_.SetEndIndex(endIndex_);
+	}
+	else if (IsAnyAngle())
+	{
+		grid_.GetBitboard();
+	}
+
+	activeOpenListType_ = openListType_;
+	if (activeOpenListType_ == EOpenListType::BucketQueue
+		&& (method != EHeuristicMethod::Manhattan || grid_.HasTileCosts()))
+	{
+		activeOpenListType_ = EOpenListType::BinaryHeap;
+	}
+
+	if (searchSpace_.GetCellCount() != grid_.GetCellCount())
+	{
+		searchSpace_.Resize(grid_.GetCellCount());
+	}
+	else
+	{
+		searchSpace_.Clear();
+	}
+
+	// 도달할 수 없는 쿼리는 Open List를 비워 두어 첫 Step 전에 이미 끝난 상태가 된다.
+	const bool bUnreachable = connectivity_ && connectivity_->GetCellCount() == grid_.GetCellCount()
+							  && !connectivity_->IsReachable(startIndex_, endIndex_);
+	// 비용을 기록한 셀은 Open으로 보이므로 도달할 수 없으면 시작 셀도 기록하지 않는다.
+	if (!bUnreachable)
+	{
+		searchSpace_.SetGCost(startIndex_, 0.0f);
+	}
+	const float startHCost = bUnreachable ? 0.0f : GetHeuristicCost(startIndex_);
+	VisitOpenList(
+		[&](auto& openList)
+		{
+			openList.Resize(grid_.GetCellCount());
+			openList.Clear();
+			if (!bUnreachable)
+			{
+				openList.Push({startHCost, startHCost, startIndex_});
+			}
+		});
+}
+
+void AStarSearch::Step()
+{
+	if (!bPathFound_)
+	{
+		VisitOpenList(
+			[this](auto& openList)
+			{
+				if (const float* tileCosts = grid_.GetTileCosts())
+				{
+					StepImpl(openList, WeightedCostModel{tileCosts});
+				}
+				else
+				{
+					StepImpl(openList, UniformCostModel{});
+				}
+			});
+	}
+}
+
+int AStarSearch::Advance(const SearchBudget& budget)
+{
+	PATHFINDING_ZONE("AStarSearch::Advance");
+	const int expandedBefore = stats_.NodesExpanded;
+	const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	if (!bPathFound_)
+	{
+		VisitOpenList(
+			[&](auto& openList)
+			{
+				if (const float* tileCosts = grid_.GetTileCosts())
+				{
+					AdvanceImpl(openList, WeightedCostModel{tileCosts}, budget);
+				}
+				else
+				{
+					AdvanceImpl(openList, UniformCostModel{}, budget);
+				}
+			});
+	}
+	stats_.ElapsedTime += std::chrono::steady_clock::now() - startTime;
+	PATHFINDING_PLOT("Nodes Expanded", stats_.NodesExpanded);
+	PATHFINDING_PLOT("Open List Size", GetOpenListSize());
+	PATHFINDING_PLOT("Duplicate Pushes", stats_.DuplicatePushCount);
+	return stats_.NodesExpanded - expandedBefore;
+}
+
+template <typename TOpenList, typename TCostModel>
+void AStarSearch::AdvanceImpl(TOpenList& openList, const TCostModel& costModel, const SearchBudget& budget)
+{
+	using Clock = std::chrono::steady_clock;
+	const bool bTimed = budget.MaxTime.count() > 0;
+	const Clock::time_point deadline = bTimed ? Clock::now() + budget.MaxTime : Clock::time_point{};
+	const int maxNodes = budget.MaxNodes > 0 ? budget.MaxNodes : std::numeric_limits<int>::max();
+	const int expandedBefore = stats_.NodesExpanded;
+	// PriorityQueue의 중복 항목을 꺼낸 Step은 확장하지 않으므로 Step 수가 아니라 확장 수로 센다.
+	for (int step = 1; !bPathFound_ && !openList.IsEmpty() && stats_.NodesExpanded - expandedBefore < maxNodes;
+		 ++step)
+	{
+		StepImpl(openList, costModel);
+		if (bTimed && step % TIME_CHECK_INTERVAL == 0 && Clock::now() >= deadline)
+		{
+			return;
+		}
+	}
+}
+
+template <typename TOpenList, typename TCostModel>
+void AStarSearch::StepImpl(TOpenList& openList, const TCostModel& costModel)
+{
+	PATHFINDING_HOT_ZONE("AStarSearch::Step");
+	if (openList.IsEmpty())
+	{
+		return;
+	}
+
+	stats_.PeakOpenListSize = std::max(stats_.PeakOpenListSize, openList.GetSize());
+	const OpenNode node = openList.Pop();
+	const int current = node.Index;
+	// PriorityQueue는 중복 항목을 가질 수 있다.
+	if (searchSpace_.IsClosed(current))
+	{
+		return;
+	}
+	if (activeAlgorithm_ == ESearchAlgorithm::LazyThetaStar)
+	{
+		UpdateLazyParent(current);
+	}
+	searchSpace_.SetClosed(current);
+	++stats_.NodesExpanded;
+	// None은 H가 항상 0이므로 부분 경로의 끝은 Octile 거리로 고른다.
+	const float hCost = method_ == EHeuristicMethod::None
+							? CalculateHeuristicCost(grid_.ToRow(current), grid_.ToColumn(current), end_.Row,
+													 end_.Column, EHeuristicMethod::Octile)
+							: node.HCost;
+	if (hCost < bestHCost_)
+	{
+		bestHCost_ = hCost;
+		bestIndex_ = current;
+	}
+	if (current == endIndex_)
+	{
+		bPathFound_ = true;
+		return;
+	}
+
+	// 랜드마크 사용 여부는 노드마다 한 번만 분기하고, 이웃마다 도는 Relax에서는 컴파일 시간에 정한다.
+	if (activeLandmarks_)
+	{
+		Expand<true>(current, openList, costModel);
+	}
+	else
+	{
+		Expand<false>(current, openList, costModel);
+	}
+}
+
+template <bool bUseLandmarks, typename TOpenList, typename TCostModel>
+void AStarSearch::Expand(int current, TOpenList& openList, const TCostModel& costModel)
+{
+	PATHFINDING_HOT_ZONE("AStarSearch::Expand");
+	if (activeAlgorithm_ == ESearchAlgorithm::JumpPointSearch)
+	{
+		ExpandJumpPoints<bUseLandmarks>(current, openList);
+	}
+	else if (activeAlgorithm_ == ESearchAlgorithm::ThetaStar)
+	{
+		ExpandAnyAngle<false>(current, openList);
+	}
+	else if (activeAlgorithm_ == ESearchAlgorithm::LazyThetaStar)
+	{
+		ExpandAnyAngle<true>(current, openList);
+	}
+	else if (method_ != EHeuristicMethod::Manhattan)
+	{
+		ExpandNeighbors<true, bUseLandmarks>(current, openList, costModel);
+	}
+	else
+	{
+		ExpandNeighbors<false, bUseLandmarks>(current, openList, costModel);
+	}
+}
+
+template <bool bAllowDiagonals, bool bUseLandmarks, typename TOpenList, typename TCostModel>
+void AStarSearch::ExpandNeighbors(int current, TOpenList& openList, const TCostModel& costModel)
+{
+	grid_.ForEachNeighbor<bAllowDiagonals>(
+		current,
+		[&](int neighbor, bool bDiagonal)
+		{
+			Relax<bUseLandmarks>(current, neighbor, costModel.GetMoveCost(current, neighbor, bDiagonal), openList);
+		});
+}
+
+template <bool bUseLandmarks, typename TOpenList>
+void AStarSearch::ExpandJumpPoints(int current, TOpenList& openList)
+{
+	const int row = grid_.ToRow(current);
+	const int column = grid_.ToColumn(current);
+	jumpPointScanner_.ForEachSuccessor(
+		current, searchSpace_.GetParent(current),
+		[&](int jumpPoint)
+		{
+			const int deltaRow = std::abs(grid_.ToRow(jumpPoint) - row);
+			const int deltaColumn = std::abs(grid_.ToColumn(jumpPoint) - column);
+			const float moveCost = std::min(deltaRow, deltaColumn) * PathfindingConfig::DIAGONAL_COST
+								   + std::abs(deltaRow - deltaColumn) * PathfindingConfig::ORTHOGONAL_COST;
+			Relax<bUseLandmarks>(current, jumpPoint, moveCost, openList);
+		});
+}
+
+template <bool bLazy, typename TOpenList>
+void AStarSearch::ExpandAnyAngle(int current, TOpenList& openList)
+{
+	const int parent = searchSpace_.GetParent(current);
+	const int parentRow = parent == SearchSpace::INVALID_INDEX ? 0 : grid_.ToRow(parent);
+	const int parentColumn = parent == SearchSpace::INVALID_INDEX ? 0 : grid_.ToColumn(parent);
+	grid_.ForEachNeighbor<true>(
+		current,
+		[&](int neighbor, bool bDiagonal)
+		{
+			// Relax도 Closed 셀을 거르지만 그 전에 시야 판정을 하지 않도록 먼저 거른다.
+			if (searchSpace_.IsClosed(neighbor))
+			{
+				return;
+			}
+			if (parent != SearchSpace::INVALID_INDEX
+				&& (bLazy
+					|| grid_.HasLineOfSight(parentRow, parentColumn, grid_.ToRow(neighbor), grid_.ToColumn(neighbor))))
+			{
+				Relax<false>(parent, neighbor, GetStraightLineCost(parent, neighbor), openList);
+			}
+			else
+			{
+				Relax<false>(current, neighbor,
+							 bDiagonal ? PathfindingConfig::DIAGONAL_COST : PathfindingConfig::ORTHOGONAL_COST,
+							 openList);
+			}
+		});
+}
+
+void AStarSearch::UpdateLazyParent(int current)
+{
+	const int parent = searchSpace_.GetParent(current);
+	if (parent == SearchSpace::INVALID_INDEX
+		|| grid_.HasLineOfSight(grid_.ToRow(parent), grid_.ToColumn(parent), grid_.ToRow(current),
+								grid_.ToColumn(current)))
+	{
+		return;
+	}
+	// current를 연 셀은 Closed이고 current와 이웃하므로 후보가 적어도 하나 있다.
+	float bestCost = std::numeric_limits<float>::max();
+	int bestParent = SearchSpace::INVALID_INDEX;
+	grid_.ForEachNeighbor<true>(
+		current,
+		[&](int neighbor, bool bDiagonal)
+		{
+			if (!searchSpace_.IsClosed(neighbor))
+			{
+				return;
+			}
+			const float cost = searchSpace_.GetGCost(neighbor)
+							   + (bDiagonal ? PathfindingConfig::DIAGONAL_COST : PathfindingConfig::ORTHOGONAL_COST);
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				bestParent = neighbor;
+			}
+		});
+	searchSpace_.SetGCost(current, bestCost);
+	searchSpace_.SetParent(current, bestParent);
+}
+
+template <bool bUseLandmarks, typename TOpenList>
+void AStarSearch::Relax(int current, int neighbor, float moveCost, TOpenList& openList)
+{
+	// 양자화된 랜드마크 하한은 일관되지 않을 수 있으므로 ALT에서는 Closed 셀도 더 싼 경로가 나오면 다시 연다.
+	// 같은 비용의 경로도 더하는 순서에 따라 float 반올림이 달라지므로 그 정도의 차이로는 다시 열지 않는다.
+	const bool bClosed = searchSpace_.IsClosed(neighbor);
+	if (bClosed && !bUseLandmarks)
+	{
+		return;
+	}
+	const float oldCost = searchSpace_.GetGCost(neighbor);
+	const float newCost = searchSpace_.GetGCost(current) + moveCost;
+	if constexpr (bUseLandmarks)
+	{
+		if (bClosed && newCost >= oldCost * (1.0f - REOPEN_TOLERANCE))
+		{
+			return;
+		}
+	}
+	if (newCost < oldCost)
+	{
+		float hCost = 0.0f;
+		{
+			PATHFINDING_HOT_ZONE("AStarSearch::Heuristic");
+			hCost = CalculateHeuristicCost(grid_.ToRow(neighbor), grid_.ToColumn(neighbor), end_.Row, end_.Column,
+										   method_);
+			if constexpr (bUseLandmarks)
+			{
+				hCost = std::max(hCost, activeLandmarks_->GetHeuristicCost(neighbor, endIndex_));
+			}
+		}
+		searchSpace_.SetGCost(neighbor, newCost);
+		searchSpace_.SetParent(neighbor, current);
+		++stats_.NodesGenerated;
+		if (bUseLandmarks && bClosed)
+		{
+			searchSpace_.Reopen(neighbor);
+			openList.Push({newCost + hCost, hCost, neighbor});
+			++stats_.ReopenedCount;
+			++stats_.DuplicatePushCount;
+		}
+		else if (oldCost == std::numeric_limits<float>::max())
+		{
+			openList.Push({newCost + hCost, hCost, neighbor});
+		}
+		else
+		{
+			openList.Update({newCost + hCost, hCost, neighbor});
+			if constexpr (std::is_same_v<TOpenList, PriorityQueue>)
+			{
+				++stats_.DuplicatePushCount;
+			}
+		}
+	}
+}
+
+float AStarSearch::GetStraightLineCost(int from, int to) const
+{
+	const float deltaRow = static_cast<float>(grid_.ToRow(to) - grid_.ToRow(from));
+	const float deltaColumn = static_cast<float>(grid_.ToColumn(to) - grid_.ToColumn(from));
+	return std::sqrt(deltaRow * deltaRow + deltaColumn * deltaColumn) * PathfindingConfig::ORTHOGONAL_COST;
+}
+
+float AStarSearch::GetHeuristicCost(int index) const
+{
+	const float hCost
+		= CalculateHeuristicCost(grid_.ToRow(index), grid_.ToColumn(index), end_.Row, end_.Column, method_);
+	return activeLandmarks_ ? std::max(hCost, activeLandmarks_->GetHeuristicCost(index, endIndex_)) : hCost;
+}
+
+PathResult AStarSearch::Run()
+{
+	PathResult result;
+	Run(result);
+	return result;
+}
+
+void AStarSearch::Run(PathResult& result)
+{
+	Advance(SearchBudget{});
+	BuildPath(result);
+}
+
+int AStarSearch::GetCurrentIndex() const
+{
+	if (bPathFound_)
+	{
+		return endIndex_;
+	}
+	return VisitOpenList([](const auto& openList)
+						 { return openList.IsEmpty() ? SearchSpace::INVALID_INDEX : openList.Top().Index; });
+}
+
+PathResult AStarSearch::BuildPath() const
+{
+	PathResult result;
+	BuildPath(result);
+	return result;
+}
+
+void AStarSearch::BuildPath(PathResult& result) const
+{
+	result.bFound = bPathFound_;
+	result.bPartial = false;
+	result.Cost = 0.0f;
+	result.Cells.clear();
+	result.Waypoints.clear();
+	if (bPathFound_)
+	{
+		BuildPathTo(endIndex_, result);
+	}
+	FillStats(result);
+}
+
+void AStarSearch::BuildPartialPath(PathResult& result) const
+{
+	BuildPath(result);
+	if (!bPathFound_ && bestIndex_ != SearchSpace::INVALID_INDEX)
+	{
+		result.bPartial = true;
+		BuildPathTo(bestIndex_, result);
+		FillStats(result);
+	}
+}
+
+void AStarSearch::FillStats(PathResult& result) const
+{
+	result.Stats = stats_;
+	result.Stats.PathCellCount = static_cast<int>(result.Cells.size());
+	result.Stats.PathCost = result.Cost;
+	result.Stats.ScratchBytes
+		= searchSpace_.GetMemoryUsage() + VisitOpenList([](const auto& openList) { return openList.GetMemoryUsage(); });
+}
+
+void AStarSearch::BuildPathTo(int target, PathResult& result) const
+{
+	PATHFINDING_ZONE("AStarSearch::BuildPath");
+	result.Cost = searchSpace_.GetGCost(target);
+	if (IsAnyAngle())
+	{
+		for (int index = target; index != SearchSpace::INVALID_INDEX; index = searchSpace_.GetParent(index))
+		{
+			result.Waypoints.push_back({grid_.ToRow(index), grid_.ToColumn(index)});
+		}
+		std::reverse(result.Waypoints.begin(), result.Waypoints.end());
+		result.Cells.push_back(result.Waypoints.front());
+		for (size_t i = 1; i < result.Waypoints.size(); ++i)
+		{
+			AppendLineCells(result.Waypoints[i - 1], result.Waypoints[i], result.Cells);
+		}
+		return;
+	}
+	for (int index = target; index != SearchSpace::INVALID_INDEX;)
+	{
+		const int parent = searchSpace_.GetParent(index);
+		GridPosition position = {grid_.ToRow(index), grid_.ToColumn(index)};
+		result.Cells.push_back(position);
+		if (parent == SearchSpace::INVALID_INDEX)
+		{
+			break;
+		}
+		// 부모가 인접하지 않은 경우(점프 포인트) 직선/대각선 위의 셀을 채운다.
+		const int stepRow = (grid_.ToRow(parent) > position.Row) - (grid_.ToRow(parent) < position.Row);
+		const int stepColumn = (grid_.ToColumn(parent) > position.Column) - (grid_.ToColumn(parent) < position.Column);
+		position.Row += stepRow;
+		position.Column += stepColumn;
+		while (grid_.ToIndex(position.Row, position.Column) != parent)
+		{
+			result.Cells.push_back(position);
+			position.Row += stepRow;
+			position.Column += stepColumn;
+		}
+		index = parent;
+	}
+	std::reverse(result.Cells.begin(), result.Cells.end());
+}
@@ -0,0 +1,179 @@
+#pragma once
+#include "Pathfinding/ConnectivityIndex.h"
+#include "Pathfinding/Grid.h"
+#include "Pathfinding/JumpPointScanner.h"
+#include "Pathfinding/LandmarkTable.h"
+#include "Pathfinding/OpenList.h"
+#include "Pathfinding/PathResult.h"
+#include "Pathfinding/PathfindingTypes.h"
+#include "Pathfinding/SearchSpace.h"
+
+#include <vector>
+
+class AStarSearch
+{
+private:
+	template <typename Func>
+	decltype(auto) VisitOpenList(Func&& func)
+	{
+		switch (activeOpenListType_)
+		{
+		case EOpenListType::QuaternaryHeap:
+			return func(quaternaryHeap_);
+		case EOpenListType::BucketQueue:
+			return func(bucketQueue_);
+		case EOpenListType::PriorityQueue:
+			return func(priorityQueue_);
+		default:
+			return func(binaryHeap_);
+		}
+	}
+	template <typename Func>
+	decltype(auto) VisitOpenList(Func&& func) const
+	{
+		switch (activeOpenListType_)
+		{
+		case EOpenListType::QuaternaryHeap:
+			return func(quaternaryHeap_);
+		case EOpenListType::BucketQueue:
+			return func(bucketQueue_);
+		case EOpenListType::PriorityQueue:
+			return func(priorityQueue_);
+		default:
+			return func(binaryHeap_);
+		}
+	}
+
+public:
+	explicit AStarSearch(const Grid& grid);
+
+	// 다음 Reset부터 적용된다.
+	void SetAlgorithm(ESearchAlgorithm::Type algorithm) { algorithm_ = algorithm; }
+	// JPS와 Theta*는 균일 비용의 8방향 이동에서만 동작하므로 Manhattan이나 셀 비용 레이어가 있는 Grid에서는
+	// A*로 대체된다. Theta*는 직선으로 이은 거리를 비용으로 쓰므로 휴리스틱도 Euclidean으로 바꾸고
+	// (None이면 그대로 Dijkstra), 격자 거리인 랜드마크 하한은 쓰지 않는다.
+	// D* Lite와 양방향 탐색은 DStarLite, BidirectionalSearch 클래스가 담당하므로 여기서는 A*로 동작한다.
+	ESearchAlgorithm::Type GetActiveAlgorithm() const { return activeAlgorithm_; }
+
+	// 다음 Reset부터 적용된다.
+	void SetOpenListType(EOpenListType::Type type) { openListType_ = type; }
+	// BucketQueue는 정수 비용(균일 비용 Manhattan)에서만 쓸 수 있으므로 실제로 사용 중인 타입은 다를 수 있다.
+	EOpenListType::Type GetActiveOpenListType() const { return activeOpenListType_; }
+
+	// ALT 휴리스틱에 쓸 랜드마크 표. 표의 수명은 호출한 쪽이 관리한다. 다음 Reset부터 적용된다.
+	// ALT는 표가 없거나 Grid와 크기가 다르면 Octile로 동작하고, 있으면 Octile과 랜드마크 하한 중 큰 값을 쓴다.
+	void SetLandmarks(const LandmarkTable* landmarks) { landmarks_ = landmarks; }
+	// 설정하면 Reset에서 시작과 도착 셀이 다른 영역이면 탐색 없이 바로 끝난다(경로 없음).
+	// 표의 수명은 호출한 쪽이 관리하며, Grid와 크기가 다르면 쓰지 않는다.
+	void SetConnectivity(const ConnectivityIndex* connectivity) { connectivity_ = connectivity; }
+
+	void Reset(const GridPosition& start, const GridPosition& end, EHeuristicMethod::Type method);
+	// 셀 비용 레이어가 없으면 UniformCostModel로, 있으면 WeightedCostModel로 확장한다.
+	void Step();
+	// 예산을 다 쓰거나 탐색이 끝날 때까지 확장하고, 이번에 확장한 노드 수를 돌려준다.
+	// 예산이 모두 0이면 끝날 때까지 진행한다. 멈춘 곳에서 다음 Advance나 Step이 이어 간다.
+	int Advance(const SearchBudget& budget);
+	// 경로를 찾거나 Open Set이 빌 때까지 Step을 반복한다.
+	PathResult Run();
+	// result의 기존 용량을 재사용한다.
+	void Run(PathResult& result);
+
+	bool IsFinished() const { return bPathFound_ || GetOpenListSize() == 0; }
+	bool IsPathFound() const { return bPathFound_; }
+
+	// 경로를 찾았으면 도착 셀, 아니면 다음에 확장될 셀. 없으면 INVALID_INDEX.
+	int GetCurrentIndex() const;
+	int GetParentIndex(int index) const { return searchSpace_.GetParent(index); }
+	bool IsClosed(int index) const { return searchSpace_.IsClosed(index); }
+	bool IsOpen(int index) const { return searchSpace_.IsOpen(index); }
+	// 켜 두면 IsOpen이나 IsClosed가 바뀌었을 수 있는 셀을 모은다(SearchSpace 참고). 시각화가 바뀐 셀만 다시 읽는 데 쓴다.
+	CellChangeLog& GetChangeLog() { return searchSpace_.GetChangeLog(); }
+	// JPS의 경우 점프 포인트 사이의 셀도 채워서 연속된 경로를 만든다.
+	// Theta*는 부모를 따라간 점들을 Waypoints에 담고, 그 선분들이 지나는 셀로 Cells를 채운다.
+	PathResult BuildPath() const;
+	// result의 기존 용량을 재사용한다.
+	void BuildPath(PathResult& result) const;
+	// 경로를 찾았으면 BuildPath와 같다. 아니면 지금까지 확장한 셀 중 도착 셀에 가장 가까운(휴리스틱이 가장 작은,
+	// None이면 Octile 거리) 셀까지의 경로를 bPartial로 만든다. 확장한 셀이 없으면 빈 결과이다.
+	void BuildPartialPath(PathResult& result) const;
+
+	size_t GetOpenListSize() const
+	{
+		return VisitOpenList([](const auto& openList) { return openList.GetSize(); });
+	}
+
+	template <typename Func>
+	void ForEachOpenNode(Func&& func) const
+	{
+		VisitOpenList([&](const auto& openList) { openList.ForEach([&](const OpenNode& node) { func(node.Index); }); });
+	}
+
+	const SearchSpace& GetSearchSpace() const { return searchSpace_; }
+	const SearchStats& GetStats() const { return stats_; }
+
+private:
+	// ALT에서 Closed 셀을 다시 여는 최소 상대 개선량
+	static constexpr float REOPEN_TOLERANCE = 1e-5f;
+	// Advance에서 시간 예산을 확인하는 간격(노드 수)
+	static constexpr int TIME_CHECK_INTERVAL = 16;
+
+	template <typename TOpenList, typename TCostModel>
+	void AdvanceImpl(TOpenList& openList, const TCostModel& costModel, const SearchBudget& budget);
+	template <typename TOpenList, typename TCostModel>
+	void StepImpl(TOpenList& openList, const TCostModel& costModel);
+	// bUseLandmarks면 ALT 휴리스틱을 쓰고 Closed 셀을 다시 열 수 있다.
+	template <bool bUseLandmarks, typename TOpenList, typename TCostModel>
+	void Expand(int current, TOpenList& openList, const TCostModel& costModel);
+	template <bool bAllowDiagonals, bool bUseLandmarks, typename TOpenList, typename TCostModel>
+	void ExpandNeighbors(int current, TOpenList& openList, const TCostModel& costModel);
+	template <bool bUseLandmarks, typename TOpenList>
+	void ExpandJumpPoints(int current, TOpenList& openList);
+	// Theta*: 부모와 이웃 사이에 시야가 트여 있으면 부모에서 바로 잇는다. bLazy면 시야 판정 없이 잇고,
+	// 이웃을 꺼낼 때 UpdateLazyParent에서 확인한다.
+	template <bool bLazy, typename TOpenList>
+	void ExpandAnyAngle(int current, TOpenList& openList);
+	// Lazy Theta*에서 부모가 보이지 않으면 Closed 이웃 중 가장 싼 셀을 부모로 삼는다.
+	void UpdateLazyParent(int current);
+	template <bool bUseLandmarks, typename TOpenList>
+	void Relax(int current, int neighbor, float moveCost, TOpenList& openList);
+	bool IsAnyAngle() const
+	{
+		return activeAlgorithm_ == ESearchAlgorithm::ThetaStar || activeAlgorithm_ == ESearchAlgorithm::LazyThetaStar;
+	}
+	// 두 셀 중심 사이의 직선 거리
+	float GetStraightLineCost(int from, int to) const;
+	// 시작 셀에서 target까지의 경로를 result에 채운다.
+	void BuildPathTo(int target, PathResult& result) const;
+	// stats_에 result의 경로 항목과 지금의 메모리 사용량을 더해 result.Stats에 담는다.
+	void FillStats(PathResult& result) const;
+	// Relax는 같은 계산을 직접 한다. 여기서는 시작 셀처럼 한 번만 필요한 곳에서 쓴다.
+	float GetHeuristicCost(int index) const;
+
+	const Grid& grid_;
+	SearchSpace searchSpace_;
+	JumpPointScanner jumpPointScanner_;
+
+	ESearchAlgorithm::Type algorithm_ = ESearchAlgorithm::AStar;
+	ESearchAlgorithm::Type activeAlgorithm_ = ESearchAlgorithm::AStar;
+
+	EOpenListType::Type openListType_ = EOpenListType::BinaryHeap;
+	EOpenListType::Type activeOpenListType_ = EOpenListType::BinaryHeap;
+	BinaryHeap binaryHeap_;
+	QuaternaryHeap quaternaryHeap_;
+	BucketQueue bucketQueue_;
+	PriorityQueue priorityQueue_;
+
+	int startIndex_ = SearchSpace::INVALID_INDEX;
+	int endIndex_ = SearchSpace::INVALID_INDEX;
+	GridPosition end_;
+	EHeuristicMethod::Type method_ = EHeuristicMethod::None;
+	const LandmarkTable* landmarks_ = nullptr;
+	// 이번 탐색에서 쓰는 랜드마크 표. ALT가 아니거나 쓸 수 없으면 nullptr.
+	const LandmarkTable* activeLandmarks_ = nullptr;
+	const ConnectivityIndex* connectivity_ = nullptr;
+	bool bPathFound_ = false;
+	// 지금까지 확장한 셀 중 도착 셀에 가장 가까운 셀. BuildPartialPath가 쓴다.
+	int bestIndex_ = SearchSpace::INVALID_INDEX;
+	float bestHCost_ = 0.0f;
+	SearchStats stats_;
+};
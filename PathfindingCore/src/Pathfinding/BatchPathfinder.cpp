@@ -0,0 +1,117 @@
+#include "BatchPathfinder.h"
+
+#include "Pathfinding/PathSmoothing.h"
+#include "Pathfinding/Profiling.h"
+
+#include <algorithm>
+#include <atomic>
+
+BatchPathfinder::BatchPathfinder(const Grid& grid, int threadCount)
+	: grid_(grid)
+	, threadPool_(ResolveThreadCount(threadCount))
+{
+	for (int i = 0; i < threadPool_.GetThreadCount(); ++i)
+	{
+		searches_.push_back(std::make_unique<AStarSearch>(grid_));
+	}
+}
+
+void BatchPathfinder::SetAlgorithm(ESearchAlgorithm::Type algorithm)
+{
+	algorithm_ = algorithm;
+	for (std::unique_ptr<AStarSearch>& search : searches_)
+	{
+		search->SetAlgorithm(algorithm);
+	}
+}
+
+void BatchPathfinder::SetOpenListType(EOpenListType::Type type)
+{
+	for (std::unique_ptr<AStarSearch>& search : searches_)
+	{
+		search->SetOpenListType(type);
+	}
+}
+
+void BatchPathfinder::SetLandmarks(const LandmarkTable* landmarks)
+{
+	for (std::unique_ptr<AStarSearch>& search : searches_)
+	{
+		search->SetLandmarks(landmarks);
+	}
+}
+
+void BatchPathfinder::SetConnectivity(const ConnectivityIndex* connectivity)
+{
+	for (std::unique_ptr<AStarSearch>& search : searches_)
+	{
+		search->SetConnectivity(connectivity);
+	}
+}
+
+std::vector<PathResult> BatchPathfinder::Run(const std::vector<PathQuery>& queries)
+{
+	std::vector<PathResult> results;
+	Run(queries, results);
+	return results;
+}
+
+void BatchPathfinder::Run(const std::vector<PathQuery>& queries, std::vector<PathResult>& results)
+{
+	PATHFINDING_ZONE("BatchPathfinder::Run");
+	results.resize(queries.size());
+
+	// 쿼리마다 비용 차이가 크므로 고정 분할 대신 작은 묶음 단위로 가져간다.
+	constexpr int CHUNK_SIZE = 4;
+	std::atomic<int> nextQuery = 0;
+	const int queryCount = static_cast<int>(queries.size());
+	// Run 동안 Grid는 바뀌지 않으므로 세대는 한 번만 읽는다.
+	const uint64_t cacheGeneration = cache_ ? cache_->GetGeneration() : 0;
+	threadPool_.RunOnAllWorkers(
+		[&](int workerIndex)
+		{
+			AStarSearch& search = *searches_[workerIndex];
+			while (true)
+			{
+				const int begin = nextQuery.fetch_add(CHUNK_SIZE, std::memory_order_relaxed);
+				if (begin >= queryCount)
+				{
+					return;
+				}
+				const int end = std::min(begin + CHUNK_SIZE, queryCount);
+				for (int i = begin; i < end; ++i)
+				{
+					const PathQuery& query = queries[i];
+					if (cache_ && cache_->Find(query, algorithm_, results[i]))
+					{
+						// 웨이포인트 없이 저장한 항목일 수 있다.
+						if (bBuildWaypoints_ && results[i].Waypoints.empty())
+						{
+							BuildWaypoints(grid_, results[i]);
+						}
+						continue;
+					}
+					search.Reset(query.Start, query.End, query.Method);
+					search.Advance(SearchBudget{});
+					search.BuildPath(results[i]);
+					if (bBuildWaypoints_)
+					{
+						BuildWaypoints(grid_, results[i]);
+					}
+					if (cache_)
+					{
+						cache_->Store(query, algorithm_, results[i], cacheGeneration);
+					}
+				}
+			}
+		});
+}
+
+int BatchPathfinder::ResolveThreadCount(int threadCount)
+{
+	if (threadCount > 0)
+	{
+		return threadCount;
+	}
+	return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
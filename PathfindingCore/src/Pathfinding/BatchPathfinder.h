@@ -0,0 +1,46 @@
+#pragma once
+#include "Pathfinding/AStarSearch.h"
+#include "Pathfinding/Grid.h"
+#include "Pathfinding/PathCache.h"
+#include "Pathfinding/PathResult.h"
+#include "Pathfinding/ThreadPool.h"
+
+#include <memory>
+#include <vector>
+
+// 하나의 정적인 맵에 대한 여러 독립 쿼리를 스레드 풀에서 나눠 처리한다.
+// Grid는 공유해서 읽기만 하고, 탐색 상태는 워커마다 따로 둔다.
+// Run이 실행되는 동안 Grid를 수정하면 안 된다.
+class BatchPathfinder
+{
+public:
+	// threadCount가 0 이하면 하드웨어 스레드 수를 사용한다.
+	explicit BatchPathfinder(const Grid& grid, int threadCount = 0);
+
+	int GetThreadCount() const { return threadPool_.GetThreadCount(); }
+	// AStarSearch::SetAlgorithm과 같다. D* Lite와 양방향 탐색은 A*로 동작한다.
+	void SetAlgorithm(ESearchAlgorithm::Type algorithm);
+	void SetOpenListType(EOpenListType::Type type);
+	// EHeuristicMethod::ALT 쿼리에 쓸 랜드마크 표. 모든 워커가 함께 읽는다.
+	void SetLandmarks(const LandmarkTable* landmarks);
+	// 서로 다른 영역을 잇는 쿼리를 탐색 없이 거절한다. 모든 워커가 함께 읽는다.
+	void SetConnectivity(const ConnectivityIndex* connectivity);
+	// 있으면 워커가 쿼리마다 먼저 캐시를 찾고, 탐색한 결과는 캐시에 넣는다. 모든 워커가 함께 쓴다.
+	void SetCache(PathCache* cache) { cache_ = cache; }
+	// 켜면 워커가 결과마다 BuildWaypoints까지 실행해 PathResult::Waypoints를 채운다. 캐시에서 찾은 결과도 같다.
+	void SetBuildWaypoints(bool bBuildWaypoints) { bBuildWaypoints_ = bBuildWaypoints; }
+
+	std::vector<PathResult> Run(const std::vector<PathQuery>& queries);
+	// results는 queries와 같은 크기로 맞춰진다. 기존 용량은 재사용한다.
+	void Run(const std::vector<PathQuery>& queries, std::vector<PathResult>& results);
+
+private:
+	static int ResolveThreadCount(int threadCount);
+
+	const Grid& grid_;
+	ThreadPool threadPool_;
+	std::vector<std::unique_ptr<AStarSearch>> searches_;
+	ESearchAlgorithm::Type algorithm_ = ESearchAlgorithm::AStar;
+	PathCache* cache_ = nullptr;
+	bool bBuildWaypoints_ = false;
+};
@@ -0,0 +1,376 @@
+#include "BidirectionalSearch.h"
+
+#include "Pathfinding/CostFunctions.h"
+#include "Pathfinding/Profiling.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+
+void BidirectionalSearch::PublishedCosts::Resize(int cellCount)
+{
+	// 값 초기화되므로 모든 셀이 세대 0(방문 안 함)으로 시작한다.
+	costs_ = std::make_unique<std::atomic<uint64_t>[]>(cellCount);
+	cellCount_ = cellCount;
+	generation_ = 0;
+}
+
+void BidirectionalSearch::PublishedCosts::Clear()
+{
+	++generation_;
+	if (generation_ == 0)
+	{
+		for (int i = 0; i < cellCount_; ++i)
+		{
+			costs_[i].store(0, std::memory_order_relaxed);
+		}
+		generation_ = 1;
+	}
+}
+
+void BidirectionalSearch::PublishedCosts::Store(int index, float cost)
+{
+	// 각 스레드는 자기 g를 기록한 뒤 상대 g를 읽는다. 둘 다 seq_cst여야 두 스레드가 동시에 같은 셀에 도착해도
+	// 적어도 한쪽은 상대 기록을 보고 만나는 경로를 찾는다.
+	const uint64_t packed = (static_cast<uint64_t>(generation_) << 32) | std::bit_cast<uint32_t>(cost);
+	costs_[index].store(packed, std::memory_order_seq_cst);
+}
+
+float BidirectionalSearch::PublishedCosts::Load(int index) const
+{
+	const uint64_t packed = costs_[index].load(std::memory_order_seq_cst);
+	if (static_cast<uint32_t>(packed >> 32) != generation_)
+	{
+		return PathfindingConfig::IMPASSABLE_COST;
+	}
+	return std::bit_cast<float>(static_cast<uint32_t>(packed));
+}
+
+BidirectionalSearch::BidirectionalSearch(const Grid& grid)
+	: grid_(grid)
+{
+}
+
+void BidirectionalSearch::SetParallel(bool bParallel)
+{
+	if (bParallel && !threadPool_)
+	{
+		threadPool_ = std::make_unique<ThreadPool>(2);
+	}
+	else if (!bParallel)
+	{
+		threadPool_.reset();
+	}
+}
+
+void BidirectionalSearch::Reset(const GridPosition& start, const GridPosition& end, EHeuristicMethod::Type method)
+{
+	PATHFINDING_ZONE("BidirectionalSearch::Reset");
+	startIndex_ = grid_.ToIndex(start.Row, start.Column);
+	endIndex_ = grid_.ToIndex(end.Row, end.Column);
+	start_ = start;
+	end_ = end;
+	method_ = method;
+	bFinished_ = false;
+	stats_ = {};
+	bestCost_.store(PathfindingConfig::IMPASSABLE_COST, std::memory_order_relaxed);
+	meetingIndex_ = SearchSpace::INVALID_INDEX;
+	bStopping_.store(false, std::memory_order_relaxed);
+	bPublishCosts_ = threadPool_ != nullptr;
+
+	forward_.Target = end;
+	forward_.PotentialSign = 1.0f;
+	backward_.Target = start;
+	backward_.PotentialSign = -1.0f;
+	auto resetSide = [&](Frontier& side, int sourceIndex, const GridPosition& source)
+	{
+		const int cellCount = grid_.GetCellCount();
+		if (side.Space.GetCellCount() != cellCount)
+		{
+			side.Space.Resize(cellCount);
+		}
+		else
+		{
+			side.Space.Clear();
+		}
+		side.OpenList.Resize(cellCount);
+		side.OpenList.Clear();
+		side.Stats = {};
+
+		side.Space.SetGCost(sourceIndex, 0.0f);
+		const float hCost
+			= CalculateHeuristicCost(source.Row, source.Column, side.Target.Row, side.Target.Column, method);
+		const float key = CalculateKey(side, sourceIndex, 0.0f);
+		side.OpenList.Push({key, hCost, sourceIndex});
+		side.TopKey.store(key, std::memory_order_relaxed);
+
+		if (bPublishCosts_)
+		{
+			if (side.Published.GetCellCount() != cellCount)
+			{
+				side.Published.Resize(cellCount);
+			}
+			side.Published.Clear();
+			side.Published.Store(sourceIndex, 0.0f);
+		}
+	};
+	resetSide(forward_, startIndex_, start);
+	resetSide(backward_, endIndex_, end);
+
+	if (startIndex_ == endIndex_)
+	{
+		OfferMeeting(0.0f, startIndex_);
+	}
+	else if (connectivity_ && connectivity_->GetCellCount() == grid_.GetCellCount()
+			 && !connectivity_->IsReachable(startIndex_, endIndex_))
+	{
+		// 도달할 수 없으면 AStarSearch처럼 빈 Open List로 끝난다. 출발 셀의 비용도 지워 Open으로 보이지 않게 한다.
+		forward_.OpenList.Clear();
+		backward_.OpenList.Clear();
+		forward_.Space.Clear();
+		backward_.Space.Clear();
+		bFinished_ = true;
+	}
+}
+
+void BidirectionalSearch::Step()
+{
+	PATHFINDING_HOT_ZONE("BidirectionalSearch::Step");
+	if (bFinished_)
+	{
+		return;
+	}
+
+	// 더 작은 쪽을 확장하면 두 프런티어가 비슷한 크기로 자란다.
+	const bool bForward = forward_.OpenList.GetSize() <= backward_.OpenList.GetSize();
+	Frontier& side = bForward ? forward_ : backward_;
+	const Frontier& other = bForward ? backward_ : forward_;
+
+	stats_.PeakOpenListSize = std::max(stats_.PeakOpenListSize, GetOpenListSize());
+	// 병렬 모드에서는 나중에 Run이 이어받을 수 있도록 g를 계속 공개한다.
+	const bool bExpanded = bPublishCosts_ ? ExpandNext<true>(side, other) : ExpandNext<false>(side, other);
+	stats_.NodesExpanded = forward_.Stats.NodesExpanded + backward_.Stats.NodesExpanded;
+	stats_.NodesGenerated = forward_.Stats.NodesGenerated + backward_.Stats.NodesGenerated;
+	if (!bExpanded)
+	{
+		bFinished_ = true;
+	}
+}
+
+PathResult BidirectionalSearch::Run()
+{
+	PathResult result;
+	Run(result);
+	return result;
+}
+
+void BidirectionalSearch::Run(PathResult& result)
+{
+	PATHFINDING_ZONE("BidirectionalSearch::Run");
+	const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	if (threadPool_ && bPublishCosts_ && !bFinished_)
+	{
+		// 워커 0은 Forward, 워커 1은 Backward. 한쪽이 끝나면 다른 쪽도 멈춘다.
+		threadPool_->RunOnAllWorkers(
+			[this](int workerIndex)
+			{
+				Frontier& side = workerIndex == 0 ? forward_ : backward_;
+				const Frontier& other = workerIndex == 0 ? backward_ : forward_;
+				while (!bStopping_.load(std::memory_order_relaxed) && ExpandNext<true>(side, other))
+				{
+				}
+				bStopping_.store(true, std::memory_order_relaxed);
+			});
+		bFinished_ = true;
+		stats_.NodesExpanded = forward_.Stats.NodesExpanded + backward_.Stats.NodesExpanded;
+		stats_.NodesGenerated = forward_.Stats.NodesGenerated + backward_.Stats.NodesGenerated;
+		stats_.PeakOpenListSize
+			= std::max(stats_.PeakOpenListSize, forward_.Stats.PeakOpenListSize + backward_.Stats.PeakOpenListSize);
+	}
+
+	while (!bFinished_)
+	{
+		Step();
+	}
+	stats_.ElapsedTime += std::chrono::steady_clock::now() - startTime;
+	BuildPath(result);
+}
+
+template <bool bParallel>
+bool BidirectionalSearch::ExpandNext(Frontier& side, const Frontier& other)
+{
+	if (const float* tileCosts = grid_.GetTileCosts())
+	{
+		return ExpandNext<bParallel>(side, other, WeightedCostModel{tileCosts});
+	}
+	return ExpandNext<bParallel>(side, other, UniformCostModel{});
+}
+
+template <bool bParallel, typename TCostModel>
+bool BidirectionalSearch::ExpandNext(Frontier& side, const Frontier& other, const TCostModel& costModel)
+{
+	BinaryHeap& openList = side.OpenList;
+	// 한쪽 Open List가 비면 그 방향에서 갈 수 있는 셀을 모두 확장했으므로 만날 수 있는 경로도 모두 확인했다.
+	if (openList.IsEmpty() || (!bParallel && other.OpenList.IsEmpty()))
+	{
+		return false;
+	}
+	const float otherTopKey
+		= bParallel ? other.TopKey.load(std::memory_order_relaxed) : other.OpenList.Top().FCost;
+	if (openList.Top().FCost + otherTopKey >= bestCost_.load(std::memory_order_relaxed))
+	{
+		return false;
+	}
+
+	side.Stats.PeakOpenListSize = std::max(side.Stats.PeakOpenListSize, openList.GetSize());
+	const OpenNode top = openList.Pop();
+	const int current = top.Index;
+	if constexpr (bParallel)
+	{
+		side.TopKey.store(top.FCost, std::memory_order_relaxed);
+	}
+	side.Space.SetClosed(current);
+	++side.Stats.NodesExpanded;
+
+	const float currentCost = side.Space.GetGCost(current);
+	auto relax = [&](int neighbor, bool bDiagonal)
+	{
+		if (side.Space.IsClosed(neighbor))
+		{
+			return;
+		}
+		const float oldCost = side.Space.GetGCost(neighbor);
+		const float newCost = currentCost + costModel.GetMoveCost(current, neighbor, bDiagonal);
+		if (newCost >= oldCost)
+		{
+			return;
+		}
+
+		side.Space.SetGCost(neighbor, newCost);
+		side.Space.SetParent(neighbor, current);
+		++side.Stats.NodesGenerated;
+		if constexpr (bParallel)
+		{
+			side.Published.Store(neighbor, newCost);
+		}
+		const float hCost = CalculateHeuristicCost(grid_.ToRow(neighbor), grid_.ToColumn(neighbor), side.Target.Row,
+												   side.Target.Column, method_);
+		const float key = CalculateKey(side, neighbor, newCost);
+		if (oldCost == PathfindingConfig::IMPASSABLE_COST)
+		{
+			openList.Push({key, hCost, neighbor});
+		}
+		else
+		{
+			openList.Update({key, hCost, neighbor});
+		}
+
+		// 상대 방향이 이미 방문한 셀이면 두 탐색을 잇는 경로가 생긴다.
+		const float otherCost = GetOtherCost<bParallel>(other, neighbor);
+		if (otherCost != PathfindingConfig::IMPASSABLE_COST
+			&& newCost + otherCost < bestCost_.load(std::memory_order_relaxed))
+		{
+			OfferMeeting(newCost + otherCost, neighbor);
+		}
+	};
+
+	if (method_ != EHeuristicMethod::Manhattan)
+	{
+		grid_.ForEachNeighbor<true>(current, relax);
+	}
+	else
+	{
+		grid_.ForEachNeighbor<false>(current, relax);
+	}
+	return true;
+}
+
+template <bool bParallel>
+float BidirectionalSearch::GetOtherCost(const Frontier& other, int index) const
+{
+	if constexpr (bParallel)
+	{
+		return other.Published.Load(index);
+	}
+	else
+	{
+		return other.Space.GetGCost(index);
+	}
+}
+
+float BidirectionalSearch::CalculateKey(const Frontier& side, int index, float gCost) const
+{
+	const int row = grid_.ToRow(index);
+	const int column = grid_.ToColumn(index);
+	const float potential = 0.5f
+							* (CalculateHeuristicCost(row, column, end_.Row, end_.Column, method_)
+							   - CalculateHeuristicCost(row, column, start_.Row, start_.Column, method_));
+	return gCost + side.PotentialSign * potential;
+}
+
+void BidirectionalSearch::OfferMeeting(float cost, int index)
+{
+	std::lock_guard<std::mutex> lock(meetingMutex_);
+	if (cost < bestCost_.load(std::memory_order_relaxed))
+	{
+		bestCost_.store(cost, std::memory_order_relaxed);
+		meetingIndex_ = index;
+	}
+}
+
+int BidirectionalSearch::GetCurrentIndex(ESearchDirection direction) const
+{
+	if (IsPathFound())
+	{
+		return meetingIndex_;
+	}
+	const BinaryHeap& openList = GetFrontier(direction).OpenList;
+	return openList.IsEmpty() ? SearchSpace::INVALID_INDEX : openList.Top().Index;
+}
+
+PathResult BidirectionalSearch::BuildPath() const
+{
+	PathResult result;
+	BuildPath(result);
+	return result;
+}
+
+void BidirectionalSearch::BuildPath(PathResult& result) const
+{
+	PATHFINDING_ZONE("BidirectionalSearch::BuildPath");
+	result.bFound = IsPathFound();
+	result.bPartial = false;
+	result.Cost = 0.0f;
+	result.Cells.clear();
+	result.Waypoints.clear();
+	result.Stats = stats_;
+	result.Stats.PathCellCount = 0;
+	result.Stats.PathCost = 0.0f;
+	result.Stats.ScratchBytes
+		= GetMemoryUsage() + forward_.OpenList.GetMemoryUsage() + backward_.OpenList.GetMemoryUsage();
+	if (!result.bFound)
+	{
+		return;
+	}
+
+	// 병렬 모드에서는 mu를 기록한 뒤에도 g가 더 줄었을 수 있으므로 지금의 g로 계산한다.
+	result.Cost = forward_.Space.GetGCost(meetingIndex_) + backward_.Space.GetGCost(meetingIndex_);
+	for (int index = meetingIndex_; index != SearchSpace::INVALID_INDEX; index = forward_.Space.GetParent(index))
+	{
+		result.Cells.push_back({grid_.ToRow(index), grid_.ToColumn(index)});
+	}
+	std::reverse(result.Cells.begin(), result.Cells.end());
+	for (int index = backward_.Space.GetParent(meetingIndex_); index != SearchSpace::INVALID_INDEX;
+		 index = backward_.Space.GetParent(index))
+	{
+		result.Cells.push_back({grid_.ToRow(index), grid_.ToColumn(index)});
+	}
+	result.Stats.PathCellCount = static_cast<int>(result.Cells.size());
+	result.Stats.PathCost = result.Cost;
+}
+
+size_t BidirectionalSearch::GetMemoryUsage() const
+{
+	return forward_.Space.GetMemoryUsage() + backward_.Space.GetMemoryUsage() + forward_.Published.GetMemoryUsage()
+		   + backward_.Published.GetMemoryUsage();
+}
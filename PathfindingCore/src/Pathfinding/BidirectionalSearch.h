@@ -0,0 +1,156 @@
+#pragma once
+#include "Pathfinding/ConnectivityIndex.h"
+#include "Pathfinding/Grid.h"
+#include "Pathfinding/OpenList.h"
+#include "Pathfinding/PathResult.h"
+#include "Pathfinding/PathfindingTypes.h"
+#include "Pathfinding/SearchSpace.h"
+#include "Pathfinding/ThreadPool.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+enum class ESearchDirection
+{
+	Forward,
+	Backward
+};
+
+// 양방향 A*: 시작 셀에서 도착 셀 방향(Forward)과 도착 셀에서 시작 셀 방향(Backward)의 두 탐색을 함께 키우고,
+// 두 탐색이 만나는 경로 중 가장 싼 것을 찾는다.
+//
+// 두 방향 모두 균형 포텐셜 p(v) = (h(v, 도착) - h(v, 시작)) / 2를 쓴다. Forward 키는 g + p, Backward 키는 g - p이다.
+// 그러면 두 탐색이 같은 축소 비용 그래프 위의 다익스트라가 되므로, 지금까지 찾은 가장 싼 경로 비용을 mu라고 할 때
+// 두 Open List의 최소 키 합이 mu 이상이면 더 싼 경로가 없다. 휴리스틱은 CalculateHeuristicCost를 그대로 쓰고,
+// 이동 비용이 대칭(CostFunctions.h)이라 두 방향의 비용이 같다.
+class BidirectionalSearch
+{
+public:
+	explicit BidirectionalSearch(const Grid& grid);
+
+	// 켜면 Run이 두 방향을 서로 다른 스레드에서 실행한다. Step은 항상 호출한 스레드에서 한 노드씩 진행한다.
+	// 다음 Reset부터 적용된다.
+	void SetParallel(bool bParallel);
+	bool IsParallel() const { return threadPool_ != nullptr; }
+	// 설정하면 Reset에서 시작과 도착 셀이 다른 영역이면 탐색 없이 바로 끝난다. 표의 수명은 호출한 쪽이 관리한다.
+	void SetConnectivity(const ConnectivityIndex* connectivity) { connectivity_ = connectivity; }
+
+	void Reset(const GridPosition& start, const GridPosition& end, EHeuristicMethod::Type method);
+	// Open List가 더 작은 방향에서 노드 하나를 확장한다.
+	void Step();
+	// 끝날 때까지 탐색한다. 병렬 모드면 두 스레드에서 실행한다.
+	PathResult Run();
+	// result의 기존 용량을 재사용한다.
+	void Run(PathResult& result);
+
+	bool IsFinished() const { return bFinished_; }
+	bool IsPathFound() const { return bFinished_ && meetingIndex_ != SearchSpace::INVALID_INDEX; }
+
+	// 경로를 찾았으면 두 탐색이 만난 셀, 아니면 그 방향에서 다음에 확장될 셀. 없으면 INVALID_INDEX.
+	int GetCurrentIndex(ESearchDirection direction) const;
+	// 그 방향의 탐색 트리에서 index의 부모. Forward는 시작 셀 쪽, Backward는 도착 셀 쪽으로 간다.
+	int GetParentIndex(ESearchDirection direction, int index) const
+	{
+		return GetFrontier(direction).Space.GetParent(index);
+	}
+	// 어느 한 방향에서라도 확장된 셀
+	bool IsClosed(int index) const { return forward_.Space.IsClosed(index) || backward_.Space.IsClosed(index); }
+	// 어느 한 방향의 Open List에 있는 셀
+	bool IsOpen(int index) const { return forward_.Space.IsOpen(index) || backward_.Space.IsOpen(index); }
+	// 방향마다 따로 모으므로 병렬 모드에서도 두 스레드가 같은 목록에 쓰지 않는다. 읽는 것은 Step 사이에 한다.
+	CellChangeLog& GetChangeLog(ESearchDirection direction)
+	{
+		return direction == ESearchDirection::Forward ? forward_.Space.GetChangeLog()
+													  : backward_.Space.GetChangeLog();
+	}
+	PathResult BuildPath() const;
+	// result의 기존 용량을 재사용한다.
+	void BuildPath(PathResult& result) const;
+
+	size_t GetOpenListSize() const { return forward_.OpenList.GetSize() + backward_.OpenList.GetSize(); }
+
+	template <typename Func>
+	void ForEachOpenNode(Func&& func) const
+	{
+		forward_.OpenList.ForEach([&](const OpenNode& node) { func(node.Index); });
+		backward_.OpenList.ForEach([&](const OpenNode& node) { func(node.Index); });
+	}
+
+	// 두 방향의 합. 병렬 모드의 PeakOpenListSize는 각 방향 최대값의 합이다.
+	const SearchStats& GetStats() const { return stats_; }
+	size_t GetMemoryUsage() const;
+
+private:
+	// 병렬 모드에서 상대 방향 스레드가 읽는 g 비용. (세대 << 32) | float 비트로 묶어 원자적으로 기록하므로
+	// 세대만 올리면 초기화된다.
+	class PublishedCosts
+	{
+	public:
+		void Resize(int cellCount);
+		void Clear();
+		void Store(int index, float cost);
+		float Load(int index) const;
+		int GetCellCount() const { return cellCount_; }
+		size_t GetMemoryUsage() const { return static_cast<size_t>(cellCount_) * sizeof(std::atomic<uint64_t>); }
+
+	private:
+		std::unique_ptr<std::atomic<uint64_t>[]> costs_;
+		int cellCount_ = 0;
+		uint32_t generation_ = 0;
+	};
+
+	struct Frontier
+	{
+		SearchSpace Space;
+		BinaryHeap OpenList;
+		PublishedCosts Published;
+		// 휴리스틱의 목표(상대 방향의 출발 셀)
+		GridPosition Target;
+		// 포텐셜 부호. Forward는 1, Backward는 -1.
+		float PotentialSign = 1.0f;
+		// 병렬 모드에서 마지막으로 꺼낸 키. 키는 줄어들지 않으므로 상대 스레드가 예전 값을 읽어도 하한이다.
+		std::atomic<float> TopKey = 0.0f;
+		SearchStats Stats;
+	};
+
+	const Frontier& GetFrontier(ESearchDirection direction) const
+	{
+		return direction == ESearchDirection::Forward ? forward_ : backward_;
+	}
+
+	// side에서 노드 하나를 확장한다. 이 방향이 끝났으면(더 싼 경로가 없거나 Open List가 비면) false.
+	template <bool bParallel, typename TCostModel>
+	bool ExpandNext(Frontier& side, const Frontier& other, const TCostModel& costModel);
+	template <bool bParallel>
+	bool ExpandNext(Frontier& side, const Frontier& other);
+	template <bool bParallel>
+	float GetOtherCost(const Frontier& other, int index) const;
+	void OfferMeeting(float cost, int index);
+	float CalculateKey(const Frontier& side, int index, float gCost) const;
+
+	const Grid& grid_;
+	GridPosition start_;
+	GridPosition end_;
+	Frontier forward_;
+	Frontier backward_;
+	std::unique_ptr<ThreadPool> threadPool_;
+	const ConnectivityIndex* connectivity_ = nullptr;
+
+	int startIndex_ = SearchSpace::INVALID_INDEX;
+	int endIndex_ = SearchSpace::INVALID_INDEX;
+	EHeuristicMethod::Type method_ = EHeuristicMethod::None;
+	bool bFinished_ = false;
+	// Reset할 때 병렬 모드였으면 Published에 g를 기록한다.
+	bool bPublishCosts_ = false;
+	SearchStats stats_;
+
+	// 지금까지 찾은 가장 싼 경로(mu)와 두 탐색이 만난 셀. 병렬 모드에서는 두 스레드가 함께 갱신한다.
+	std::mutex meetingMutex_;
+	std::atomic<float> bestCost_ = PathfindingConfig::IMPASSABLE_COST;
+	int meetingIndex_ = SearchSpace::INVALID_INDEX;
+	// 병렬 모드에서 한 방향이 끝나면 다른 방향도 멈춘다.
+	std::atomic<bool> bStopping_ = false;
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// 탐색 상태(Open, Closed 등)가 바뀐 셀의 목록. 시각화처럼 매번 모든 셀을 다시 읽지 않고 바뀐 셀만 따라가려는
+// 쪽이 켜 두고, 읽은 뒤 Clear한다. 꺼져 있거나 이미 모두 바뀐 것으로 기록했으면 Add는 분기 하나만 한다.
+//
+// 같은 셀이 여러 번 들어갈 수 있고 실제로는 바뀌지 않은 셀이 들어갈 수도 있다. 읽는 쪽은 셀의 현재 상태를
+// 다시 읽으므로 문제가 되지 않는다.
+class CellChangeLog
+{
+public:
+	void SetEnabled(bool bEnabled)
+	{
+		bEnabled_ = bEnabled;
+		MarkAllChanged();
+	}
+	bool IsEnabled() const { return bEnabled_; }
+
+	// 목록이 셀 수의 1/4을 넘으면 모든 셀을 다시 읽는 편이 싸므로 모두 바뀐 것으로 바꾼다.
+	void SetCellCount(int cellCount) { maxCount_ = static_cast<size_t>(cellCount) / 4; }
+
+	void Add(int index)
+	{
+		if (!bRecording_)
+		{
+			return;
+		}
+		if (cells_.size() >= maxCount_)
+		{
+			MarkAllChanged();
+			return;
+		}
+		cells_.push_back(index);
+	}
+	// Reset처럼 셀 전체가 바뀌었을 수 있는 경우
+	void MarkAllChanged()
+	{
+		bAllChanged_ = true;
+		bRecording_ = false;
+		cells_.clear();
+	}
+
+	// true면 GetCells 대신 모든 셀을 다시 읽어야 한다.
+	bool HasAllChanged() const { return bAllChanged_; }
+	const std::vector<int>& GetCells() const { return cells_; }
+	void Clear()
+	{
+		bAllChanged_ = false;
+		bRecording_ = bEnabled_;
+		cells_.clear();
+	}
+
+private:
+	std::vector<int> cells_;
+	size_t maxCount_ = 0;
+	bool bEnabled_ = false;
+	bool bAllChanged_ = true;
+	// bEnabled_ && !bAllChanged_. 탐색의 안쪽 루프에서 분기 하나로 거르기 위해 따로 둔다.
+	bool bRecording_ = false;
+};
@@ -0,0 +1,421 @@
+#include "ConnectivityIndex.h"
+
+#include "Pathfinding/Profiling.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace
+{
+	// 경로 절반 압축. 띠 안에서는 띠 안의 셀끼리만 합치므로 부모도 항상 같은 띠 안에 있다.
+	int FindRoot(std::vector<int>& parents, int index)
+	{
+		while (parents[index] != index)
+		{
+			parents[index] = parents[parents[index]];
+			index = parents[index];
+		}
+		return index;
+	}
+
+	void Unite(std::vector<int>& parents, int a, int b)
+	{
+		a = FindRoot(parents, a);
+		b = FindRoot(parents, b);
+		if (a != b)
+		{
+			parents[std::max(a, b)] = std::min(a, b);
+		}
+	}
+} // namespace
+
+ConnectivityIndex::ConnectivityIndex(const Grid& grid, int threadCount)
+	: grid_(grid)
+{
+	if (threadCount <= 0)
+	{
+		threadCount = static_cast<int>(std::thread::hardware_concurrency());
+	}
+	if (threadCount > 1)
+	{
+		threadPool_ = std::make_unique<ThreadPool>(threadCount);
+	}
+}
+
+void ConnectivityIndex::Build()
+{
+	PATHFINDING_ZONE("ConnectivityIndex::Build");
+	const int rowCount = grid_.GetRowCount();
+	const int columnCount = grid_.GetColumnCount();
+	const int cellCount = grid_.GetCellCount();
+	labels_.assign(cellCount, INVALID_LABEL);
+	componentSizes_.clear();
+	freeLabels_.clear();
+	if (cellCount == 0)
+	{
+		return;
+	}
+
+	const int stripCount = threadPool_ ? std::min(threadPool_->GetThreadCount(), rowCount) : 1;
+	auto getStripBegin = [&](int strip)
+	{ return static_cast<int>(static_cast<int64_t>(rowCount) * strip / stripCount); };
+	// job(firstRow, endRow)을 띠마다 한 워커에서 실행한다.
+	auto runOnStrips = [&](const auto& job)
+	{
+		if (stripCount == 1)
+		{
+			job(0, rowCount);
+			return;
+		}
+		threadPool_->RunOnAllWorkers(
+			[&](int workerIndex)
+			{
+				if (workerIndex < stripCount)
+				{
+					job(getStripBegin(workerIndex), getStripBegin(workerIndex + 1));
+				}
+			});
+	};
+
+	// 띠마다 왼쪽, 위 이웃과 합친다. 벽은 자기 자신을 가리킨 채로 남는다.
+	std::vector<int> parents(cellCount);
+	runOnStrips(
+		[&](int firstRow, int endRow)
+		{
+			for (int row = firstRow; row < endRow; ++row)
+			{
+				for (int column = 0; column < columnCount; ++column)
+				{
+					const int index = grid_.ToIndex(row, column);
+					parents[index] = index;
+					if (!grid_.IsWalkable(index))
+					{
+						continue;
+					}
+					if (column > 0 && grid_.IsWalkable(index - 1))
+					{
+						Unite(parents, index, index - 1);
+					}
+					if (row > firstRow && grid_.IsWalkable(index - columnCount))
+					{
+						Unite(parents, index, index - columnCount);
+					}
+				}
+			}
+		});
+	for (int strip = 1; strip < stripCount; ++strip)
+	{
+		const int firstIndex = grid_.ToIndex(getStripBegin(strip), 0);
+		for (int index = firstIndex; index < firstIndex + columnCount; ++index)
+		{
+			if (grid_.IsWalkable(index) && grid_.IsWalkable(index - columnCount))
+			{
+				Unite(parents, index, index - columnCount);
+			}
+		}
+	}
+
+	// 루트를 찾아 적는다. 여기서는 parents를 읽기만 하므로 압축하지 않는다.
+	runOnStrips(
+		[&](int firstRow, int endRow)
+		{
+			for (int index = firstRow * columnCount; index < endRow * columnCount; ++index)
+			{
+				if (grid_.IsWalkable(index))
+				{
+					int root = index;
+					while (parents[root] != root)
+					{
+						root = parents[root];
+					}
+					labels_[index] = root;
+				}
+			}
+		});
+	// 루트 셀의 parents 자리에 0부터 매긴 영역 번호를 적고, 모든 셀을 그 번호로 바꾼다.
+	for (int index = 0; index < cellCount; ++index)
+	{
+		if (labels_[index] == index)
+		{
+			parents[index] = AllocateLabel();
+		}
+	}
+	runOnStrips(
+		[&](int firstRow, int endRow)
+		{
+			for (int index = firstRow * columnCount; index < endRow * columnCount; ++index)
+			{
+				if (labels_[index] != INVALID_LABEL)
+				{
+					labels_[index] = parents[labels_[index]];
+				}
+			}
+		});
+	for (int label : labels_)
+	{
+		if (label != INVALID_LABEL)
+		{
+			++componentSizes_[label];
+		}
+	}
+}
+
+void ConnectivityIndex::OnTileChanged(int row, int column)
+{
+	const int index = grid_.ToIndex(row, column);
+	const bool bLabeled = labels_[index] != INVALID_LABEL;
+	if (grid_.IsWalkable(index) == bLabeled)
+	{
+		return;
+	}
+	if (bLabeled)
+	{
+		OnCellClosed(index);
+	}
+	else
+	{
+		OnCellOpened(index);
+	}
+}
+
+template <typename Func>
+void ConnectivityIndex::ForEachLabeledNeighbor(int index, Func&& func) const
+{
+	const int row = grid_.ToRow(index);
+	const int column = grid_.ToColumn(index);
+	const int columnCount = grid_.GetColumnCount();
+	if (IsLabeled(row - 1, column))
+	{
+		func(index - columnCount);
+	}
+	if (IsLabeled(row + 1, column))
+	{
+		func(index + columnCount);
+	}
+	if (IsLabeled(row, column - 1))
+	{
+		func(index - 1);
+	}
+	if (IsLabeled(row, column + 1))
+	{
+		func(index + 1);
+	}
+}
+
+void ConnectivityIndex::OnCellOpened(int index)
+{
+	// 가장 큰 이웃 영역에 넣고, 나머지 이웃 영역은 그 번호로 다시 칠한다.
+	int label = INVALID_LABEL;
+	ForEachLabeledNeighbor(index,
+						   [&](int neighbor)
+						   {
+							   const int neighborLabel = labels_[neighbor];
+							   if (label == INVALID_LABEL || componentSizes_[neighborLabel] > componentSizes_[label])
+							   {
+								   label = neighborLabel;
+							   }
+						   });
+	if (label == INVALID_LABEL)
+	{
+		label = AllocateLabel();
+	}
+	labels_[index] = label;
+	++componentSizes_[label];
+
+	ForEachLabeledNeighbor(index,
+						   [&](int neighbor)
+						   {
+							   const int neighborLabel = labels_[neighbor];
+							   if (neighborLabel != label)
+							   {
+								   componentSizes_[label] += componentSizes_[neighborLabel];
+								   ReleaseLabel(neighborLabel);
+								   Relabel(neighbor, neighborLabel, label);
+							   }
+						   });
+}
+
+void ConnectivityIndex::OnCellClosed(int index)
+{
+	const int label = labels_[index];
+	labels_[index] = INVALID_LABEL;
+	if (--componentSizes_[label] == 0)
+	{
+		ReleaseLabel(label);
+		return;
+	}
+
+	// 직교 이웃을 위, 오른쪽, 아래, 왼쪽 순서로 돌며, 앞 이웃과 그 사이의 대각선 셀이 열려 있으면 같은 묶음으로 본다.
+	// 묶음이 하나뿐이면 막힌 셀을 돌아가는 길이 있으므로 영역이 그대로다.
+	constexpr int SIDES[4][2] = {{-1, 0}, {0, 1}, {1, 0}, {0, -1}};
+	const int row = grid_.ToRow(index);
+	const int column = grid_.ToColumn(index);
+	bool bOpen[4];
+	for (int side = 0; side < 4; ++side)
+	{
+		bOpen[side] = IsLabeled(row + SIDES[side][0], column + SIDES[side][1]);
+	}
+	int groupSeeds[4];
+	int groupCount = 0;
+	for (int side = 0; side < 4; ++side)
+	{
+		const int previous = (side + 3) % 4;
+		const bool bJoined = bOpen[previous]
+							 && IsLabeled(row + SIDES[side][0] + SIDES[previous][0],
+										  column + SIDES[side][1] + SIDES[previous][1]);
+		if (bOpen[side] && !bJoined)
+		{
+			groupSeeds[groupCount++] = grid_.ToIndex(row + SIDES[side][0], column + SIDES[side][1]);
+		}
+	}
+	if (groupCount <= 1)
+	{
+		return;
+	}
+
+	// 묶음끼리 멀리 돌아서 이어져 있을 수 있으므로 묶음마다 한 셀씩 번갈아 칠해 나간다. 다른 묶음이 칠한 셀에 닿으면
+	// 두 묶음을 합치고, 다 칠했는데 다른 묶음에 닿지 못한 묶음은 떨어져 나간 것이므로 새 번호를 준다.
+	// 묶음이 하나만 남으면 멈추므로 작은 쪽 크기만큼만 칠하고, 남은 쪽은 기존 번호를 유지한다.
+	if (visitStamps_.size() != labels_.size() || visitGeneration_ > UINT32_MAX - 4)
+	{
+		visitStamps_.assign(labels_.size(), 0);
+		visitGeneration_ = 0;
+	}
+	const uint32_t firstStamp = visitGeneration_ + 1;
+	visitGeneration_ += 4;
+	int groupParents[4];
+	size_t queueHeads[4];
+	// 떨어져 나가 새 번호를 받은 묶음의 루트
+	bool bDetached[4] = {};
+	for (int group = 0; group < groupCount; ++group)
+	{
+		groupParents[group] = group;
+		queueHeads[group] = 0;
+		groupQueues_[group].clear();
+		groupQueues_[group].push_back(groupSeeds[group]);
+		visitStamps_[groupSeeds[group]] = firstStamp + group;
+	}
+	auto findGroup = [&](int group)
+	{
+		while (groupParents[group] != group)
+		{
+			group = groupParents[group];
+		}
+		return group;
+	};
+	auto isExhausted = [&](int root)
+	{
+		for (int group = 0; group < groupCount; ++group)
+		{
+			if (findGroup(group) == root && queueHeads[group] < groupQueues_[group].size())
+			{
+				return false;
+			}
+		}
+		return true;
+	};
+
+	int rootCount = groupCount;
+	while (rootCount > 1)
+	{
+		for (int group = 0; group < groupCount; ++group)
+		{
+			std::vector<int>& queue = groupQueues_[group];
+			if (queueHeads[group] == queue.size() || bDetached[findGroup(group)])
+			{
+				continue;
+			}
+			const int current = queue[queueHeads[group]++];
+			ForEachLabeledNeighbor(current,
+								   [&](int neighbor)
+								   {
+									   const uint32_t stamp = visitStamps_[neighbor];
+									   if (stamp < firstStamp && labels_[neighbor] == label)
+									   {
+										   visitStamps_[neighbor] = firstStamp + group;
+										   queue.push_back(neighbor);
+										   return;
+									   }
+									   if (stamp >= firstStamp)
+									   {
+										   const int root = findGroup(group);
+										   const int otherRoot = findGroup(static_cast<int>(stamp - firstStamp));
+										   if (root != otherRoot)
+										   {
+											   groupParents[otherRoot] = root;
+											   --rootCount;
+										   }
+									   }
+								   });
+		}
+
+		// 다 칠한 묶음은 떨어져 나간 영역이다.
+		for (int root = 0; root < groupCount && rootCount > 1; ++root)
+		{
+			if (groupParents[root] != root || bDetached[root] || !isExhausted(root))
+			{
+				continue;
+			}
+			const int newLabel = AllocateLabel();
+			for (int group = 0; group < groupCount; ++group)
+			{
+				if (findGroup(group) != root)
+				{
+					continue;
+				}
+				for (int cell : groupQueues_[group])
+				{
+					labels_[cell] = newLabel;
+				}
+				componentSizes_[newLabel] += static_cast<int>(groupQueues_[group].size());
+			}
+			componentSizes_[label] -= componentSizes_[newLabel];
+			bDetached[root] = true;
+			--rootCount;
+		}
+	}
+}
+
+void ConnectivityIndex::Relabel(int seed, int from, int to)
+{
+	queue_.clear();
+	queue_.push_back(seed);
+	labels_[seed] = to;
+	for (size_t i = 0; i < queue_.size(); ++i)
+	{
+		ForEachLabeledNeighbor(queue_[i],
+							   [&](int neighbor)
+							   {
+								   if (labels_[neighbor] == from)
+								   {
+									   labels_[neighbor] = to;
+									   queue_.push_back(neighbor);
+								   }
+							   });
+	}
+}
+
+int ConnectivityIndex::AllocateLabel()
+{
+	if (!freeLabels_.empty())
+	{
+		const int label = freeLabels_.back();
+		freeLabels_.pop_back();
+		return label;
+	}
+	componentSizes_.push_back(0);
+	return static_cast<int>(componentSizes_.size()) - 1;
+}
+
+void ConnectivityIndex::ReleaseLabel(int label)
+{
+	componentSizes_[label] = 0;
+	freeLabels_.push_back(label);
+}
+
+size_t ConnectivityIndex::GetMemoryUsage() const
+{
+	return labels_.capacity() * sizeof(int) + componentSizes_.capacity() * sizeof(int)
+		   + freeLabels_.capacity() * sizeof(int) + visitStamps_.capacity() * sizeof(uint32_t)
+		   + queue_.capacity() * sizeof(int);
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include "Pathfinding/Grid.h"
+#include "Pathfinding/ThreadPool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// 통과 가능한 셀마다 연결 영역 번호를 붙여 둔 표. 번호가 다른 두 셀 사이에는 경로가 없으므로
+// 탐색을 시작하기 전에 O(1)로 거절할 수 있다. 대각선은 두 직교 이웃이 모두 열려 있어야 하므로
+// 4방향 연결만 보면 되고, 8방향과 4방향(Manhattan) 탐색 모두에 맞다.
+//
+// Build는 행을 워커 수만큼의 띠로 나눠 띠마다 유니온 파인드로 합친 뒤, 띠 경계만 한 스레드에서 합치고
+// 다시 나눠서 영역 번호로 펼친다.
+//
+// 타일이 바뀌면 OnTileChanged로 알려 준다. 열린 셀은 이웃 영역을 합치고(작은 쪽의 번호를 바꾼다),
+// 막힌 셀은 주변 8칸만으로 이웃끼리 이어져 있으면 그대로 두고, 아니면 끊어졌을 수 있는 쪽만 다시 칠한다.
+class ConnectivityIndex
+{
+public:
+	static constexpr int INVALID_LABEL = -1;
+
+	// threadCount가 0 이하면 하드웨어 스레드 수를 사용한다. 1이면 스레드를 만들지 않는다.
+	explicit ConnectivityIndex(const Grid& grid, int threadCount = 1);
+
+	void Build();
+	// (row, column)의 통과 가능 여부가 바뀌었을 수 있을 때 호출한다. 바뀌지 않았으면(셀 비용만 바뀐 경우 등)
+	// 아무것도 하지 않는다. 여러 셀을 바꿨으면 셀마다 호출한다.
+	void OnTileChanged(int row, int column);
+
+	// Build한 Grid의 셀 수. Grid 크기가 바뀌었으면 다시 Build해야 한다.
+	int GetCellCount() const { return static_cast<int>(labels_.size()); }
+	int GetComponentCount() const
+	{
+		return static_cast<int>(componentSizes_.size() - freeLabels_.size());
+	}
+	// 벽이면 INVALID_LABEL
+	int GetLabel(int index) const { return labels_[index]; }
+
+	// 두 셀이 같은 영역에 있는지. 어느 한쪽이 벽이면 같은 셀이라도 false.
+	bool IsReachable(int startIndex, int endIndex) const
+	{
+		const int label = labels_[startIndex];
+		return label != INVALID_LABEL && label == labels_[endIndex];
+	}
+
+	size_t GetMemoryUsage() const;
+
+private:
+	// 표에 기록된 상태 기준의 통과 가능한 4방향 이웃마다 func(neighborIndex)를 호출한다.
+	template <typename Func>
+	void ForEachLabeledNeighbor(int index, Func&& func) const;
+	bool IsLabeled(int row, int column) const
+	{
+		return grid_.IsInBounds(row, column) && labels_[grid_.ToIndex(row, column)] != INVALID_LABEL;
+	}
+
+	void OnCellOpened(int index);
+	void OnCellClosed(int index);
+	// from 번호인 영역을 seed부터 칠해 to 번호로 바꾼다.
+	void Relabel(int seed, int from, int to);
+	int AllocateLabel();
+	void ReleaseLabel(int label);
+
+	const Grid& grid_;
+	std::unique_ptr<ThreadPool> threadPool_;
+
+	std::vector<int> labels_;
+	// 영역 번호별 셀 수. 쓰지 않는 번호는 freeLabels_에 있다.
+	std::vector<int> componentSizes_;
+	std::vector<int> freeLabels_;
+
+	// 다시 칠할 때 쓰는 작업 공간. 처음 필요할 때 만든다.
+	std::vector<uint32_t> visitStamps_;
+	uint32_t visitGeneration_ = 0;
+	std::vector<int> queue_;
+	// 막힌 셀 주변의 묶음(최대 4개)마다 칠한 셀
+	std::vector<int> groupQueues_[4];
+};
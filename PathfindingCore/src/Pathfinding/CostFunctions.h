@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Pathfinding/PathfindingTypes.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+inline float GetWalkCost(ETileType type)
+{
+	switch (type)
+	{
+	case ETileType::Path:
+		return PathfindingConfig::ORTHOGONAL_COST;
+	case ETileType::Wall:
+		return PathfindingConfig::IMPASSABLE_COST;
+	case ETileType::Swamp:
+		return PathfindingConfig::SWAMP_COST;
+	case ETileType::Water:
+		return PathfindingConfig::WATER_COST;
+	default:
+		return PathfindingConfig::ORTHOGONAL_COST;
+	}
+}
+
+// 탐색의 템플릿 인자로 쓰는 이동 비용 모델. GetMoveCost(current, neighbor, bDiagonal)은 current에서 이웃으로 가는 비용이다.
+// 모든 셀의 비용이 1이면 UniformCostModel을 써서 셀 비용 조회 없이 이동 거리만 쓴다.
+struct UniformCostModel
+{
+	float GetMoveCost(int /*current*/, int /*neighbor*/, bool bDiagonal) const
+	{
+		return bDiagonal ? PathfindingConfig::DIAGONAL_COST : PathfindingConfig::ORTHOGONAL_COST;
+	}
+};
+
+// 이동 거리에 두 셀 비용(Grid::GetTileCosts)의 평균을 곱한다. 방향에 관계없이 비용이 같다.
+struct WeightedCostModel
+{
+	const float* TileCosts;
+
+	float GetMoveCost(int current, int neighbor, bool bDiagonal) const
+	{
+		return (bDiagonal ? PathfindingConfig::DIAGONAL_COST : PathfindingConfig::ORTHOGONAL_COST)
+			   * (TileCosts[current] + TileCosts[neighbor]) * 0.5f;
+	}
+};
+
+inline float CalculateHeuristicCost(int rowStart, int columnStart, int rowEnd, int columnEnd,
+									EHeuristicMethod::Type method)
+{
+	const int deltaRow = std::abs(rowStart - rowEnd);
+	const int deltaCol = std::abs(columnStart - columnEnd);
+	switch (method)
+	{
+	case EHeuristicMethod::None:
+		return 0.0f;
+	case EHeuristicMethod::Manhattan:
+		return static_cast<float>(deltaRow + deltaCol);
+	case EHeuristicMethod::Euclidean:
+		return std::sqrt(static_cast<float>(deltaRow * deltaRow + deltaCol * deltaCol));
+	case EHeuristicMethod::Octile:
+	// 랜드마크 거리는 LandmarkTable이 따로 계산하고, 여기서는 기하 하한인 Octile을 쓴다.
+	case EHeuristicMethod::ALT:
+		return static_cast<float>(std::min(deltaRow, deltaCol)) * PathfindingConfig::DIAGONAL_COST
+			   + std::abs(static_cast<float>(deltaRow - deltaCol));
+	default:
+		return 0.0f;
+	}
+}
@@ -0,0 +1,260 @@
+#include "DStarLite.h"
+
+#include "Pathfinding/CostFunctions.h"
+#include "Pathfinding/Profiling.h"
+
+#include <algorithm>
+#include <chrono>
+
+DStarLite::DStarLite(const Grid& grid)
+	: grid_(grid)
+{
+}
+
+void DStarLite::Reset(const GridPosition& start, const GridPosition& end, EHeuristicMethod::Type method)
+{
+	PATHFINDING_ZONE("DStarLite::Reset");
+	startIndex_ = grid_.ToIndex(start.Row, start.Column);
+	endIndex_ = grid_.ToIndex(end.Row, end.Column);
+	start_ = start;
+	method_ = method;
+	bAllowDiagonals_ = method != EHeuristicMethod::Manhattan;
+	keyModifier_ = 0.0f;
+	stats_ = {};
+
+	const int cellCount = grid_.GetCellCount();
+	gCosts_.assign(cellCount, PathfindingConfig::IMPASSABLE_COST);
+	rhsCosts_.assign(cellCount, PathfindingConfig::IMPASSABLE_COST);
+	openList_.Resize(cellCount);
+	openList_.Clear();
+	changeLog_.SetCellCount(cellCount);
+	changeLog_.MarkAllChanged();
+
+	UpdateVertex(endIndex_);
+}
+
+void DStarLite::Step()
+{
+	PATHFINDING_HOT_ZONE("DStarLite::Step");
+	if (IsFinished())
+	{
+		return;
+	}
+
+	const OpenNode top = openList_.Top();
+	const int current = top.Index;
+	const OpenNode newKey = CalculateKey(current);
+	// 시작 셀이 움직인 뒤라면 예전 키가 작을 수 있다. 키만 고쳐서 다시 넣는다.
+	if (top.IsBetterThan(newKey))
+	{
+		openList_.Pop();
+		openList_.Push(newKey);
+		return;
+	}
+
+	stats_.PeakOpenListSize = std::max(stats_.PeakOpenListSize, openList_.GetSize());
+	++stats_.NodesExpanded;
+	changeLog_.Add(current);
+	if (gCosts_[current] > rhsCosts_[current])
+	{
+		gCosts_[current] = rhsCosts_[current];
+		openList_.Pop();
+	}
+	else
+	{
+		// 경로가 막혀 비용이 늘어난 셀. 이웃을 거쳐 다시 계산한다.
+		++stats_.ReopenedCount;
+		gCosts_[current] = PathfindingConfig::IMPASSABLE_COST;
+		UpdateVertex(current);
+	}
+	ForEachNeighbor(current, [this](int neighbor, bool) { UpdateVertex(neighbor); });
+}
+
+PathResult DStarLite::Run()
+{
+	PATHFINDING_ZONE("DStarLite::Run");
+	const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	while (!IsFinished())
+	{
+		Step();
+	}
+	stats_.ElapsedTime += std::chrono::steady_clock::now() - startTime;
+	return BuildPath();
+}
+
+bool DStarLite::IsFinished() const
+{
+	if (openList_.IsEmpty())
+	{
+		return true;
+	}
+	// 정확히 계산하면 시작 셀의 키와 같아야 할 키가 부동소수점 오차로 조금 크게 나올 수 있다.
+	// 그런 셀을 남겨 두면 경로가 순환하므로 상대 오차만큼 여유를 두고 더 확장한다.
+	const float startKey = CalculateKey(startIndex_).FCost;
+	if (openList_.Top().FCost <= startKey + startKey * KEY_TOLERANCE)
+	{
+		return false;
+	}
+	return gCosts_[startIndex_] == rhsCosts_[startIndex_];
+}
+
+void DStarLite::OnTileChanged(int row, int column)
+{
+	PATHFINDING_ZONE("DStarLite::OnTileChanged");
+	// 이 셀로 드나드는 간선과, 이 셀을 모서리로 두는 대각선 간선의 비용이 바뀐다.
+	for (int deltaRow = -1; deltaRow <= 1; ++deltaRow)
+	{
+		for (int deltaColumn = -1; deltaColumn <= 1; ++deltaColumn)
+		{
+			if (grid_.IsInBounds(row + deltaRow, column + deltaColumn))
+			{
+				UpdateVertex(grid_.ToIndex(row + deltaRow, column + deltaColumn));
+			}
+		}
+	}
+}
+
+void DStarLite::MoveStart(const GridPosition& start)
+{
+	keyModifier_ += CalculateHeuristicCost(start_.Row, start_.Column, start.Row, start.Column, method_);
+	start_ = start;
+	startIndex_ = grid_.ToIndex(start.Row, start.Column);
+}
+
+int DStarLite::GetCurrentIndex() const
+{
+	if (IsPathFound())
+	{
+		return startIndex_;
+	}
+	return openList_.IsEmpty() ? SearchSpace::INVALID_INDEX : openList_.Top().Index;
+}
+
+int DStarLite::GetNextIndex(int index) const
+{
+	if (index == endIndex_)
+	{
+		return SearchSpace::INVALID_INDEX;
+	}
+
+	int bestNeighbor = SearchSpace::INVALID_INDEX;
+	float bestCost = PathfindingConfig::IMPASSABLE_COST;
+	ForEachNeighbor(index,
+					[&](int neighbor, bool bDiagonal)
+					{
+						if (gCosts_[neighbor] == PathfindingConfig::IMPASSABLE_COST)
+						{
+							return;
+						}
+						const float moveCost = GetMoveCost(index, neighbor, bDiagonal);
+						if (gCosts_[neighbor] + moveCost < bestCost)
+						{
+							bestCost = gCosts_[neighbor] + moveCost;
+							bestNeighbor = neighbor;
+						}
+					});
+	return bestNeighbor;
+}
+
+PathResult DStarLite::BuildPath() const
+{
+	PathResult result;
+	BuildPath(result);
+	return result;
+}
+
+void DStarLite::BuildPath(PathResult& result) const
+{
+	PATHFINDING_ZONE("DStarLite::BuildPath");
+	result.bFound = false;
+	result.bPartial = false;
+	result.Cost = 0.0f;
+	result.Cells.clear();
+	result.Waypoints.clear();
+	result.Stats = stats_;
+	result.Stats.PathCellCount = 0;
+	result.Stats.PathCost = 0.0f;
+	result.Stats.ScratchBytes = (gCosts_.capacity() + rhsCosts_.capacity()) * sizeof(float)
+								+ openList_.GetMemoryUsage() + changeLog_.GetCells().capacity() * sizeof(int);
+	if (!IsPathFound())
+	{
+		return;
+	}
+
+	int index = startIndex_;
+	result.Cells.push_back(start_);
+	// g가 확정된 상태라면 다음 셀로 갈수록 g가 줄어들지만, 혹시 모를 순환을 막는다.
+	for (int stepCount = 0; index != endIndex_ && stepCount < grid_.GetCellCount(); ++stepCount)
+	{
+		const int next = GetNextIndex(index);
+		if (next == SearchSpace::INVALID_INDEX)
+		{
+			return;
+		}
+		const bool bDiagonal = grid_.ToRow(next) != grid_.ToRow(index) && grid_.ToColumn(next) != grid_.ToColumn(index);
+		result.Cost += GetMoveCost(index, next, bDiagonal);
+		result.Cells.push_back({grid_.ToRow(next), grid_.ToColumn(next)});
+		index = next;
+	}
+	result.bFound = index == endIndex_;
+	if (result.bFound)
+	{
+		result.Stats.PathCellCount = static_cast<int>(result.Cells.size());
+		result.Stats.PathCost = result.Cost;
+	}
+}
+
+float DStarLite::CalculateHeuristic(int index) const
+{
+	return CalculateHeuristicCost(start_.Row, start_.Column, grid_.ToRow(index), grid_.ToColumn(index), method_);
+}
+
+OpenNode DStarLite::CalculateKey(int index) const
+{
+	const float cost = std::min(gCosts_[index], rhsCosts_[index]);
+	if (cost == PathfindingConfig::IMPASSABLE_COST)
+	{
+		return {cost, cost, index};
+	}
+	return {cost + CalculateHeuristic(index) + keyModifier_, cost, index};
+}
+
+float DStarLite::CalculateRhs(int index) const
+{
+	if (!grid_.IsWalkable(index))
+	{
+		return PathfindingConfig::IMPASSABLE_COST;
+	}
+	if (index == endIndex_)
+	{
+		return 0.0f;
+	}
+
+	float rhs = PathfindingConfig::IMPASSABLE_COST;
+	ForEachNeighbor(index,
+					[&](int neighbor, bool bDiagonal)
+					{
+						if (gCosts_[neighbor] == PathfindingConfig::IMPASSABLE_COST)
+						{
+							return;
+						}
+						const float moveCost = GetMoveCost(index, neighbor, bDiagonal);
+						rhs = std::min(rhs, gCosts_[neighbor] + moveCost);
+					});
+	return rhs;
+}
+
+void DStarLite::UpdateVertex(int index)
+{
+	rhsCosts_[index] = CalculateRhs(index);
+	changeLog_.Add(index);
+	if (openList_.Contains(index))
+	{
+		openList_.Remove(index);
+	}
+	if (gCosts_[index] != rhsCosts_[index])
+	{
+		openList_.Push(CalculateKey(index));
+		++stats_.NodesGenerated;
+	}
+}
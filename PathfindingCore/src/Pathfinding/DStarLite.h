@@ -0,0 +1,104 @@
+#pragma once
+#include "Pathfinding/CellChangeLog.h"
+#include "Pathfinding/Grid.h"
+#include "Pathfinding/OpenList.h"
+#include "Pathfinding/PathResult.h"
+#include "Pathfinding/PathfindingTypes.h"
+#include "Pathfinding/SearchSpace.h"
+
+#include <cstddef>
+#include <vector>
+
+// D* Lite: 도착 셀에서 시작 셀 방향으로 탐색하고, 타일이 바뀌거나 시작 셀이 움직여도 탐색 상태를
+// 버리지 않고 영향을 받은 부분만 다시 계산한다.
+// 셀마다 g(확정된 거리)와 rhs(이웃의 g로 한 단계 앞서 계산한 거리)를 두고, 둘이 다른 셀만 Open List에 둔다.
+class DStarLite
+{
+public:
+	explicit DStarLite(const Grid& grid);
+
+	void Reset(const GridPosition& start, const GridPosition& end, EHeuristicMethod::Type method);
+	void Step();
+	// 시작 셀까지의 경로가 확정될 때까지 Step을 반복한다.
+	PathResult Run();
+
+	bool IsFinished() const;
+	bool IsPathFound() const { return IsFinished() && gCosts_[startIndex_] != PathfindingConfig::IMPASSABLE_COST; }
+
+	// 타일(벽 또는 셀 비용)을 바꾼 뒤 호출한다. 그 셀과 주변 셀만 다시 Open List에 넣고, 실제 수리는 이후의 Step/Run에서 한다.
+	void OnTileChanged(int row, int column);
+	// 에이전트가 이동했을 때 호출한다. 기존 탐색 결과를 그대로 재사용한다.
+	void MoveStart(const GridPosition& start);
+
+	// 경로를 찾았으면 시작 셀, 아니면 다음에 확장될 셀. 없으면 INVALID_INDEX.
+	int GetCurrentIndex() const;
+	// index에서 도착 셀 쪽으로 가장 싼 이웃. 없으면 INVALID_INDEX.
+	int GetNextIndex(int index) const;
+	// g가 확정된(g == rhs) 셀. A*의 Closed 셀에 해당한다.
+	bool IsConsistent(int index) const
+	{
+		return gCosts_[index] != PathfindingConfig::IMPASSABLE_COST && gCosts_[index] == rhsCosts_[index];
+	}
+	bool IsOpen(int index) const { return openList_.Contains(index); }
+	// 켜 두면 g나 rhs를 다시 계산한 셀을 모은다. Reset은 모든 셀이 바뀐 것으로 기록한다.
+	CellChangeLog& GetChangeLog() { return changeLog_; }
+	PathResult BuildPath() const;
+	// result의 기존 용량을 재사용한다.
+	void BuildPath(PathResult& result) const;
+
+	size_t GetOpenListSize() const { return openList_.GetSize(); }
+
+	template <typename Func>
+	void ForEachOpenNode(Func&& func) const
+	{
+		openList_.ForEach([&](const OpenNode& node) { func(node.Index); });
+	}
+
+	// Reset 이후 확장한 셀 수. 재계획 비용을 비교할 때 쓴다.
+	int GetExpandedCount() const { return stats_.NodesExpanded; }
+	// Reset 이후의 누적. 타일을 바꿔 수리한 비용도 더해진다.
+	const SearchStats& GetStats() const { return stats_; }
+
+private:
+	static constexpr float KEY_TOLERANCE = 1e-5f;
+
+	// 셀 비용 레이어는 탐색 도중 생기거나 사라질 수 있으므로 비용 모델을 템플릿으로 고정하지 않는다.
+	float GetMoveCost(int index, int neighbor, bool bDiagonal) const
+	{
+		return (bDiagonal ? PathfindingConfig::DIAGONAL_COST : PathfindingConfig::ORTHOGONAL_COST)
+			   * (grid_.GetTileCost(index) + grid_.GetTileCost(neighbor)) * 0.5f;
+	}
+
+	template <typename Func>
+	void ForEachNeighbor(int index, Func&& func) const
+	{
+		if (bAllowDiagonals_)
+		{
+			grid_.ForEachNeighbor<true>(index, func);
+		}
+		else
+		{
+			grid_.ForEachNeighbor<false>(index, func);
+		}
+	}
+
+	float CalculateHeuristic(int index) const;
+	OpenNode CalculateKey(int index) const;
+	float CalculateRhs(int index) const;
+	void UpdateVertex(int index);
+
+	const Grid& grid_;
+	std::vector<float> gCosts_;
+	std::vector<float> rhsCosts_;
+	BinaryHeap openList_;
+	CellChangeLog changeLog_;
+
+	int startIndex_ = SearchSpace::INVALID_INDEX;
+	int endIndex_ = SearchSpace::INVALID_INDEX;
+	GridPosition start_;
+	EHeuristicMethod::Type method_ = EHeuristicMethod::None;
+	bool bAllowDiagonals_ = true;
+	// 시작 셀이 움직일 때마다 누적되는 키 보정값. 이미 Open List에 있는 키를 다시 계산하지 않기 위해 쓴다.
+	float keyModifier_ = 0.0f;
+	SearchStats stats_;
+};
@@ -0,0 +1,207 @@
+#include "Grid.h"
+
+#include <algorithm>
+#include <random>
+#include <utility>
+
+Grid::Grid(int rowCount, int columnCount)
+{
+	Resize(rowCount, columnCount);
+}
+
+Grid::Grid(const Grid& other)
+	: rowCount_(other.rowCount_)
+	, columnCount_(other.columnCount_)
+	, ownedBits_(other.ownedBits_)
+	, walkableBits_(other.bExternal_ ? other.walkableBits_ : ownedBits_.data())
+	, bExternal_(other.bExternal_)
+	, ownedTileCosts_(other.ownedTileCosts_)
+	, tileCosts_(other.bExternalTileCosts_ || !other.tileCosts_ ? other.tileCosts_ : ownedTileCosts_.data())
+	, bExternalTileCosts_(other.bExternalTileCosts_)
+{
+	// 아직 만들지 않은 비트보드는 복사본에서도 처음 쓸 때 만든다.
+	if (other.bBitboardBuilt_.load(std::memory_order_acquire))
+	{
+		bitboard_ = other.bitboard_;
+		bBitboardBuilt_.store(true, std::memory_order_release);
+	}
+}
+
+Grid& Grid::operator=(const Grid& other)
+{
+	if (this != &other)
+	{
+		rowCount_ = other.rowCount_;
+		columnCount_ = other.columnCount_;
+		ownedBits_ = other.ownedBits_;
+		walkableBits_ = other.bExternal_ ? other.walkableBits_ : ownedBits_.data();
+		bExternal_ = other.bExternal_;
+		if (other.bBitboardBuilt_.load(std::memory_order_acquire))
+		{
+			bitboard_ = other.bitboard_;
+			bBitboardBuilt_.store(true, std::memory_order_release);
+		}
+		else
+		{
+			ResetBitboard();
+		}
+		ownedTileCosts_ = other.ownedTileCosts_;
+		tileCosts_ = other.bExternalTileCosts_ || !other.tileCosts_ ? other.tileCosts_ : ownedTileCosts_.data();
+		bExternalTileCosts_ = other.bExternalTileCosts_;
+	}
+	return *this;
+}
+
+Grid::Grid(Grid&& other) noexcept
+	: rowCount_(other.rowCount_)
+	, columnCount_(other.columnCount_)
+	, ownedBits_(std::move(other.ownedBits_))
+	, walkableBits_(other.walkableBits_)
+	, bExternal_(other.bExternal_)
+	, bitboard_(std::move(other.bitboard_))
+	, bBitboardBuilt_(other.bBitboardBuilt_.load(std::memory_order_acquire))
+	, ownedTileCosts_(std::move(other.ownedTileCosts_))
+	, tileCosts_(other.tileCosts_)
+	, bExternalTileCosts_(other.bExternalTileCosts_)
+{
+	other.rowCount_ = 0;
+	other.columnCount_ = 0;
+	other.walkableBits_ = nullptr;
+	other.bExternal_ = false;
+	other.ResetBitboard();
+	other.tileCosts_ = nullptr;
+	other.bExternalTileCosts_ = false;
+}
+
+Grid& Grid::operator=(Grid&& other) noexcept
+{
+	if (this != &other)
+	{
+		rowCount_ = other.rowCount_;
+		columnCount_ = other.columnCount_;
+		// vector를 이동해도 버퍼 주소는 그대로이므로 포인터를 옮겨도 된다.
+		ownedBits_ = std::move(other.ownedBits_);
+		walkableBits_ = other.walkableBits_;
+		bExternal_ = other.bExternal_;
+		bitboard_ = std::move(other.bitboard_);
+		bBitboardBuilt_.store(other.bBitboardBuilt_.load(std::memory_order_acquire), std::memory_order_release);
+		ownedTileCosts_ = std::move(other.ownedTileCosts_);
+		tileCosts_ = other.tileCosts_;
+		bExternalTileCosts_ = other.bExternalTileCosts_;
+		other.rowCount_ = 0;
+		other.columnCount_ = 0;
+		other.ownedBits_.clear();
+		other.walkableBits_ = nullptr;
+		other.bExternal_ = false;
+		other.ResetBitboard();
+		other.ownedTileCosts_.clear();
+		other.tileCosts_ = nullptr;
+		other.bExternalTileCosts_ = false;
+	}
+	return *this;
+}
+
+void Grid::Resize(int rowCount, int columnCount)
+{
+	rowCount_ = rowCount;
+	columnCount_ = columnCount;
+
+	const int cellCount = GetCellCount();
+	ownedBits_.assign(GetWordCount(rowCount, columnCount), ~0ull);
+	if (cellCount % 64 != 0)
+	{
+		// 마지막 워드의 남는 비트는 벽으로 둔다.
+		ownedBits_.back() = (1ull << (cellCount % 64)) - 1;
+	}
+	walkableBits_ = ownedBits_.data();
+	bExternal_ = false;
+	ResetBitboard();
+	ClearTileCosts();
+}
+
+void Grid::AttachExternalBits(uint64_t* words, int rowCount, int columnCount)
+{
+	rowCount_ = rowCount;
+	columnCount_ = columnCount;
+	ownedBits_.clear();
+	ownedBits_.shrink_to_fit();
+	walkableBits_ = words;
+	bExternal_ = true;
+	ResetBitboard();
+	ClearTileCosts();
+}
+
+void Grid::GenerateRandomWalls(float density, uint32_t seed)
+{
+	// 분포 클래스는 표준 라이브러리 구현마다 결과가 다르므로 mt19937 출력을 직접 쓴다.
+	std::mt19937 random(seed);
+	for (int i = 0; i < rowCount_ * columnCount_ * density; ++i)
+	{
+		const int randRow = static_cast<int>(random() % rowCount_);
+		const int randCol = static_cast<int>(random() % columnCount_);
+		SetTileType(randRow, randCol, ETileType::Wall);
+	}
+}
+
+void Grid::SetTileType(int row, int column, ETileType type)
+{
+	const int index = ToIndex(row, column);
+	const uint64_t mask = 1ull << (index & 63);
+	if (bBitboardBuilt_.load(std::memory_order_relaxed))
+	{
+		bitboard_.Set(row, column, type != ETileType::Wall);
+	}
+	if (type == ETileType::Wall)
+	{
+		walkableBits_[index >> 6] &= ~mask;
+		return;
+	}
+
+	walkableBits_[index >> 6] |= mask;
+	// 비용 레이어가 없으면 Path는 이미 비용 1이므로 레이어를 만들지 않는다.
+	if (type != ETileType::Path || tileCosts_)
+	{
+		SetTileCost(row, column, GetWalkCost(type));
+	}
+}
+
+void Grid::SetTileCost(int row, int column, float cost)
+{
+	if (!tileCosts_)
+	{
+		ownedTileCosts_.assign(GetCellCount(), PathfindingConfig::ORTHOGONAL_COST);
+		tileCosts_ = ownedTileCosts_.data();
+		bExternalTileCosts_ = false;
+	}
+	tileCosts_[ToIndex(row, column)] = std::max(cost, PathfindingConfig::ORTHOGONAL_COST);
+}
+
+void Grid::AttachExternalTileCosts(float* costs)
+{
+	ownedTileCosts_.clear();
+	ownedTileCosts_.shrink_to_fit();
+	tileCosts_ = costs;
+	bExternalTileCosts_ = costs != nullptr;
+}
+
+void Grid::BuildBitboard() const
+{
+	std::lock_guard<std::mutex> lock(bitboardMutex_);
+	if (!bBitboardBuilt_.load(std::memory_order_relaxed))
+	{
+		bitboard_.Build(walkableBits_, rowCount_, columnCount_);
+		bBitboardBuilt_.store(true, std::memory_order_release);
+	}
+}
+
+void Grid::ResetBitboard()
+{
+	// 빈 비트보드로 바꿔 메모리를 돌려준다.
+	bitboard_ = GridBitboard();
+	bBitboardBuilt_.store(false, std::memory_order_release);
+}
+
+void Grid::ClearTileCosts()
+{
+	AttachExternalTileCosts(nullptr);
+}
@@ -0,0 +1,190 @@
+#pragma once
+#include "Pathfinding/CostFunctions.h"
+#include "Pathfinding/GridBitboard.h"
+#include "Pathfinding/PathfindingTypes.h"
+
+#include <cstddef>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// 셀은 row * ColumnCount + column 인덱스로 접근한다.
+// 통과 가능 여부는 셀당 1비트로 저장한다. 셀 i는 i / 64번째 워드의 i % 64번째 비트이다.
+//
+// 비트는 Grid가 직접 소유하거나, AttachExternalBits로 외부 메모리(메모리 맵 파일 등)를 그대로 가리킬 수 있다.
+// 외부 메모리를 가리키는 Grid를 복사하면 같은 메모리를 공유한다. 행/열 비트보드(GridBitboard)는 Grid마다 따로
+// 가지므로, 공유 중인 한쪽에서 SetTileType을 호출하면 다른 쪽의 비트보드는 갱신되지 않는다.
+// 비트보드는 JPS나 시야 판정이 처음 필요로 할 때 만든다. 그래서 맵 파일을 열거나 맵을 만들 때는 비트를 복사하지 않는다.
+//
+// 셀 비용 레이어는 선택이다. 없으면 모든 셀의 비용이 1이고, 있으면 이웃으로 이동하는 비용은
+// 이동 거리(1 또는 √2)에 두 셀 비용의 평균을 곱한 값이다. 비트와 마찬가지로 외부 메모리를 가리킬 수 있다.
+class Grid
+{
+public:
+	Grid() = default;
+	Grid(int rowCount, int columnCount);
+	Grid(const Grid& other);
+	Grid& operator=(const Grid& other);
+	Grid(Grid&& other) noexcept;
+	Grid& operator=(Grid&& other) noexcept;
+
+	// 소유한 비트로 되돌아가며 모든 셀을 통과 가능으로 초기화한다. 셀 비용 레이어는 버린다.
+	void Resize(int rowCount, int columnCount);
+	// words는 GetWordCount(rowCount, columnCount)개 이상이어야 하고 Grid보다 오래 살아 있어야 한다.
+	// 마지막 워드의 남는 비트는 0(벽)이어야 한다. 셀 비용 레이어는 버린다.
+	void AttachExternalBits(uint64_t* words, int rowCount, int columnCount);
+	bool IsExternal() const { return bExternal_; }
+	static size_t GetWordCount(int rowCount, int columnCount)
+	{
+		return (static_cast<size_t>(rowCount) * columnCount + 63) / 64;
+	}
+	const uint64_t* GetWords() const { return walkableBits_; }
+
+	// 같은 시드면 어느 플랫폼에서든 같은 맵을 만든다.
+	void GenerateRandomWalls(float density, uint32_t seed);
+
+	int GetRowCount() const { return rowCount_; }
+	int GetColumnCount() const { return columnCount_; }
+	int GetCellCount() const { return rowCount_ * columnCount_; }
+	bool IsInBounds(int row, int column) const
+	{
+		return row >= 0 && row < rowCount_ && column >= 0 && column < columnCount_;
+	}
+
+	int ToIndex(int row, int column) const { return row * columnCount_ + column; }
+	int ToRow(int index) const { return index / columnCount_; }
+	int ToColumn(int index) const { return index % columnCount_; }
+
+	bool IsWalkable(int index) const { return (walkableBits_[index >> 6] >> (index & 63)) & 1; }
+	bool IsWalkable(int row, int column) const { return IsWalkable(ToIndex(row, column)); }
+
+	// 셀 비용이 지형 비용 이상이면 그 지형으로 본다.
+	ETileType GetTileType(int row, int column) const
+	{
+		if (!IsWalkable(row, column))
+		{
+			return ETileType::Wall;
+		}
+		const float cost = GetTileCost(ToIndex(row, column));
+		if (cost >= PathfindingConfig::WATER_COST)
+		{
+			return ETileType::Water;
+		}
+		return cost >= PathfindingConfig::SWAMP_COST ? ETileType::Swamp : ETileType::Path;
+	}
+	// Swamp/Water는 통과 가능으로 만들고 셀 비용을 GetWalkCost(type)으로 설정한다.
+	void SetTileType(int row, int column, ETileType type);
+
+	// 통과 가능 비트를 행 단위와 열 단위로 묶은 사본. 처음 부를 때 만들고(여러 스레드가 동시에 불러도 한 번),
+	// 그 뒤로는 비트가 바뀌는 곳에서 함께 갱신된다. 만드는 동안 SetTileType을 부르면 안 된다.
+	const GridBitboard& GetBitboard() const
+	{
+		if (!bBitboardBuilt_.load(std::memory_order_acquire))
+		{
+			BuildBitboard();
+		}
+		return bitboard_;
+	}
+	// 두 셀 중심을 잇는 선분이 닿는 셀이 모두 통과 가능한지 (GridBitboard::HasLineOfSight)
+	bool HasLineOfSight(int fromRow, int fromColumn, int toRow, int toColumn) const
+	{
+		return GetBitboard().HasLineOfSight(fromRow, fromColumn, toRow, toColumn);
+	}
+
+	bool HasTileCosts() const { return tileCosts_ != nullptr; }
+	// 레이어가 없으면 nullptr
+	const float* GetTileCosts() const { return tileCosts_; }
+	float GetTileCost(int index) const { return tileCosts_ ? tileCosts_[index] : PathfindingConfig::ORTHOGONAL_COST; }
+	// 레이어가 없으면 모든 셀을 1로 채워 만든다. 휴리스틱이 실제 비용을 넘지 않도록 1보다 작은 값은 1로 올린다.
+	void SetTileCost(int row, int column, float cost);
+	// costs는 GetCellCount()개 이상이고 모두 1 이상이어야 하며 Grid보다 오래 살아 있어야 한다.
+	void AttachExternalTileCosts(float* costs);
+	// 레이어를 버리고 균일 비용으로 돌아간다.
+	void ClearTileCosts();
+
+	// 통과 가능한 이웃마다 func(neighborIndex, bDiagonal)을 호출한다. 힙 할당이 없다.
+	// 대각선은 인접한 두 직교 방향이 모두 통과 가능할 때만 (코너 컷팅 방지).
+	template <bool bAllowDiagonals, typename Func>
+	void ForEachNeighbor(int index, Func&& func) const
+	{
+		const int row = ToRow(index);
+		const int column = index - row * columnCount_;
+		const int up = index - columnCount_;
+		const int down = index + columnCount_;
+
+		const bool bCanUp = row > 0 && IsWalkable(up);
+		const bool bCanDown = row + 1 < rowCount_ && IsWalkable(down);
+		const bool bCanLeft = column > 0 && IsWalkable(index - 1);
+		const bool bCanRight = column + 1 < columnCount_ && IsWalkable(index + 1);
+
+		if (bCanUp)
+		{
+			func(up, false);
+		}
+		if (bCanDown)
+		{
+			func(down, false);
+		}
+		if (bCanLeft)
+		{
+			func(index - 1, false);
+		}
+		if (bCanRight)
+		{
+			func(index + 1, false);
+		}
+
+		if constexpr (bAllowDiagonals)
+		{
+			if (bCanUp && bCanLeft && IsWalkable(up - 1))
+			{
+				func(up - 1, true);
+			}
+			if (bCanUp && bCanRight && IsWalkable(up + 1))
+			{
+				func(up + 1, true);
+			}
+			if (bCanDown && bCanLeft && IsWalkable(down - 1))
+			{
+				func(down - 1, true);
+			}
+			if (bCanDown && bCanRight && IsWalkable(down + 1))
+			{
+				func(down + 1, true);
+			}
+		}
+	}
+
+	// 외부 메모리를 가리키는 경우에도 그 크기를 포함한다. 비트보드는 만든 뒤에만 포함한다.
+	size_t GetMemoryUsage() const
+	{
+		const size_t bitBytes = IsExternal() ? GetWordCount(rowCount_, columnCount_) * sizeof(uint64_t)
+											 : ownedBits_.capacity() * sizeof(uint64_t);
+		const size_t costBytes = bExternalTileCosts_ ? static_cast<size_t>(GetCellCount()) * sizeof(float)
+													 : ownedTileCosts_.capacity() * sizeof(float);
+		const size_t bitboardBytes = bBitboardBuilt_.load(std::memory_order_acquire) ? bitboard_.GetMemoryUsage() : 0;
+		return bitBytes + costBytes + bitboardBytes;
+	}
+
+private:
+	void BuildBitboard() const;
+	// 비트 전체가 바뀌었을 때 부른다. 다음 GetBitboard가 다시 만든다.
+	void ResetBitboard();
+
+	int rowCount_ = 0;
+	int columnCount_ = 0;
+	std::vector<uint64_t> ownedBits_;
+	// ownedBits_ 또는 외부 메모리
+	uint64_t* walkableBits_ = nullptr;
+	bool bExternal_ = false;
+	// GetBitboard가 처음 불릴 때 bitboardMutex_ 안에서 만든다.
+	mutable GridBitboard bitboard_;
+	mutable std::atomic<bool> bBitboardBuilt_ = false;
+	mutable std::mutex bitboardMutex_;
+
+	std::vector<float> ownedTileCosts_;
+	// ownedTileCosts_, 외부 메모리 또는 nullptr(균일 비용)
+	float* tileCosts_ = nullptr;
+	bool bExternalTileCosts_ = false;
+};
@@ -0,0 +1,177 @@
+#include "GridBitboard.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+
+namespace
+{
+// 64x64 비트 행렬을 제자리에서 전치한다. 전치 후 matrix[j]의 비트 i는 전치 전 matrix[i]의 비트 j이다.
+void Transpose64(uint64_t* matrix)
+{
+	uint64_t mask = 0x00000000FFFFFFFFull;
+	for (int width = 32; width != 0; width >>= 1, mask ^= mask << width)
+	{
+		for (int k = 0; k < 64; k = (k + width + 1) & ~width)
+		{
+			const uint64_t swap = ((matrix[k] >> width) ^ matrix[k + width]) & mask;
+			matrix[k] ^= swap << width;
+			matrix[k + width] ^= swap;
+		}
+	}
+}
+
+int GetWordsPerLine(int cellsPerLine)
+{
+	return (cellsPerLine + 63) / 64;
+}
+} // namespace
+
+void GridBitboard::Board::Resize(int lineCount, int cellsPerLine)
+{
+	Stride = GetWordsPerLine(cellsPerLine) + 2;
+	Words.assign(static_cast<size_t>(lineCount + 2) * Stride + GUARD_WORDS * 2, 0);
+}
+
+void GridBitboard::Build(const uint64_t* linearBits, int rowCount, int columnCount)
+{
+	rowCount_ = rowCount;
+	columnCount_ = columnCount;
+	rowBoard_.Resize(rowCount, columnCount);
+	columnBoard_.Resize(columnCount, rowCount);
+
+	// 행마다 선형 비트에서 64칸씩 잘라 온다. 선형 배열의 마지막 워드 뒤는 읽지 않는다.
+	const int wordsPerRow = GetWordsPerLine(columnCount);
+	const size_t linearWordCount = (static_cast<size_t>(rowCount) * columnCount + 63) / 64;
+	for (int row = 0; row < rowCount; ++row)
+	{
+		uint64_t* line = rowBoard_.GetLine(row);
+		for (int word = 0; word < wordsPerRow; ++word)
+		{
+			const size_t position = static_cast<size_t>(row) * columnCount + static_cast<size_t>(word) * 64;
+			const size_t source = position >> 6;
+			const int shift = static_cast<int>(position & 63);
+			uint64_t bits = linearBits[source] >> shift;
+			if (shift != 0 && source + 1 < linearWordCount)
+			{
+				bits |= linearBits[source + 1] << (64 - shift);
+			}
+			const int remaining = columnCount - word * 64;
+			if (remaining < 64)
+			{
+				bits &= (1ull << remaining) - 1;
+			}
+			line[word] = bits;
+		}
+	}
+
+	// 열 단위는 64x64 블록마다 전치해서 만든다.
+	const int wordsPerColumn = GetWordsPerLine(rowCount);
+	uint64_t block[64];
+	for (int rowBlock = 0; rowBlock < wordsPerColumn; ++rowBlock)
+	{
+		for (int columnBlock = 0; columnBlock < wordsPerRow; ++columnBlock)
+		{
+			const int firstRow = rowBlock * 64;
+			const int blockRows = std::min(64, rowCount - firstRow);
+			std::fill(block, block + 64, 0);
+			for (int i = 0; i < blockRows; ++i)
+			{
+				block[i] = rowBoard_.GetLine(firstRow + i)[columnBlock];
+			}
+			Transpose64(block);
+			const int firstColumn = columnBlock * 64;
+			const int blockColumns = std::min(64, columnCount - firstColumn);
+			for (int j = 0; j < blockColumns; ++j)
+			{
+				columnBoard_.GetLine(firstColumn + j)[rowBlock] = block[j];
+			}
+		}
+	}
+}
+
+void GridBitboard::Set(int row, int column, bool bWalkable)
+{
+	uint64_t& rowWord = rowBoard_.GetLine(row)[column >> 6];
+	uint64_t& columnWord = columnBoard_.GetLine(column)[row >> 6];
+	const uint64_t rowMask = 1ull << (column & 63);
+	const uint64_t columnMask = 1ull << (row & 63);
+	if (bWalkable)
+	{
+		rowWord |= rowMask;
+		columnWord |= columnMask;
+	}
+	else
+	{
+		rowWord &= ~rowMask;
+		columnWord &= ~columnMask;
+	}
+}
+
+bool GridBitboard::IsSpanWalkable(EAxis axis, int line, int first, int last) const
+{
+	for (int position = first; position <= last; position += 64)
+	{
+		const int count = last - position + 1;
+		const uint64_t mask = count >= 64 ? ~0ull : (1ull << count) - 1;
+		if ((LoadForward(axis, line, position) & mask) != mask)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool GridBitboard::HasLineOfSight(int fromRow, int fromColumn, int toRow, int toColumn) const
+{
+	if (!IsInBounds(fromRow, fromColumn) || !IsInBounds(toRow, toColumn))
+	{
+		return false;
+	}
+	// 선분이 길게 뻗은 방향의 줄을 따라 읽어야 줄마다 읽는 칸이 많고 줄 수는 적다.
+	// 셀을 닫힌 정사각형으로 보므로 행과 열을 바꿔도 닿는 셀은 같다.
+	if (std::abs(toColumn - fromColumn) >= std::abs(toRow - fromRow))
+	{
+		return HasLineOfSightAlong(EAxis::Rows, fromRow, fromColumn, toRow, toColumn);
+	}
+	return HasLineOfSightAlong(EAxis::Columns, fromColumn, fromRow, toColumn, toRow);
+}
+
+bool GridBitboard::HasLineOfSightAlong(EAxis axis, int fromLine, int fromPosition, int toLine, int toPosition) const
+{
+	if (fromLine > toLine)
+	{
+		std::swap(fromLine, toLine);
+		std::swap(fromPosition, toPosition);
+	}
+	const int deltaLine = toLine - fromLine;
+	const int deltaPosition = toPosition - fromPosition;
+	if (deltaLine == 0)
+	{
+		return IsSpanWalkable(axis, fromLine, std::min(fromPosition, toPosition), std::max(fromPosition, toPosition));
+	}
+
+	// 셀 (l, p)는 [l, l + 1] x [p, p + 1]이고 선분은 두 셀 중심을 잇는다. 줄 좌표 y에서 선분의 위치 좌표는
+	// x(y) = fromPosition + 0.5 + (y - fromLine - 0.5) * deltaPosition / deltaLine 이므로, 양변에 2 * deltaLine을
+	// 곱한 정수 분자로 계산한다. 셀 중심의 x는 정수가 아니고 모든 x가 0보다 크므로 분자도 양수이다.
+	const long long denominator = 2ll * deltaLine;
+	auto getNumerator = [&](int y)
+	{ return (2ll * fromPosition + 1) * deltaLine + (2ll * y - 2ll * fromLine - 1) * deltaPosition; };
+
+	for (int line = fromLine; line <= toLine; ++line)
+	{
+		// 이 줄에서 선분이 차지하는 구간의 양 끝. 첫 줄과 마지막 줄은 셀 중심에서 시작하고 끝난다.
+		const long long startNumerator = line == fromLine ? (2ll * fromPosition + 1) * deltaLine : getNumerator(line);
+		const long long endNumerator = line == toLine ? (2ll * toPosition + 1) * deltaLine : getNumerator(line + 1);
+		const long long lowNumerator = std::min(startNumerator, endNumerator);
+		const long long highNumerator = std::max(startNumerator, endNumerator);
+		// 낮은 쪽 끝이 칸 경계 위에 있으면 경계 바로 앞 칸에도 닿는다.
+		const int first = static_cast<int>(lowNumerator / denominator - (lowNumerator % denominator == 0 ? 1 : 0));
+		const int last = static_cast<int>(highNumerator / denominator);
+		if (!IsSpanWalkable(axis, line, first, last))
+		{
+			return false;
+		}
+	}
+	return true;
+}
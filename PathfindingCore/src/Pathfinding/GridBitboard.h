@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Grid의 통과 가능 비트를 행 단위와 열 단위로 다시 묶은 비트보드. Grid가 소유하고 타일이 바뀔 때 함께 갱신한다.
+// 줄(행 또는 열)마다 워드 경계에서 시작하고 줄 앞뒤에 0(벽) 워드가 있으며, 격자 바깥쪽에도 0인 줄이 하나씩 있다.
+// 그래서 격자에서 한 칸 벗어난 곳을 읽어도 분기 없이 벽으로 읽힌다.
+//
+// 열 단위는 행 단위를 전치한 것이므로 세로 스캔도 가로 스캔과 같은 코드로 64칸(AVX2면 256칸)씩 처리할 수 있다.
+class GridBitboard
+{
+public:
+	// Rows는 행을 따라 가로로, Columns는 열을 따라 세로로 읽는다.
+	enum class EAxis
+	{
+		Rows,
+		Columns
+	};
+
+	// linearBits는 Grid와 같은 배치(셀 i가 i / 64번째 워드의 i % 64번째 비트)이다.
+	void Build(const uint64_t* linearBits, int rowCount, int columnCount);
+	void Set(int row, int column, bool bWalkable);
+
+	// row, column은 격자에서 한 칸 밖(-1, 개수)까지 허용하고 그곳은 벽이다.
+	bool IsWalkable(int row, int column) const
+	{
+		const uint64_t* line = GetLine(EAxis::Rows, row);
+		return (line[column >> 6] >> (column & 63)) & 1;
+	}
+
+	// line번째 줄의 position부터 64칸. 비트 i가 position + i번째 칸이다.
+	// line은 -1부터 개수까지, position은 -64부터 개수까지 허용한다.
+	uint64_t LoadForward(EAxis axis, int line, int position) const
+	{
+		const uint64_t* words = GetLine(axis, line) + (position >> 6);
+		const int shift = position & 63;
+		// shift가 0일 때 64비트 시프트가 되지 않도록 두 번에 나눠 민다.
+		return (words[0] >> shift) | ((words[1] << 1) << (63 - shift));
+	}
+	// position까지 64칸. 비트 63이 position, 비트 63 - i가 position - i번째 칸이다.
+	uint64_t LoadBackward(EAxis axis, int line, int position) const
+	{
+		return LoadForward(axis, line, position - 63);
+	}
+
+#if defined(__AVX2__)
+	// LoadForward의 256칸 버전. 줄 끝을 넘어 다음 줄을 읽을 수 있지만 그 앞에 항상 0 워드가 있다.
+	__m256i LoadForward256(EAxis axis, int line, int position) const
+	{
+		const uint64_t* words = GetLine(axis, line) + (position >> 6);
+		const __m128i shift = _mm_cvtsi32_si128(position & 63);
+		const __m128i inverseShift = _mm_cvtsi32_si128(64 - (position & 63));
+		const __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words));
+		const __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + 1));
+		return _mm256_or_si256(_mm256_srl_epi64(low, shift), _mm256_sll_epi64(high, inverseShift));
+	}
+#endif
+
+	bool IsInBounds(int row, int column) const
+	{
+		return row >= 0 && row < rowCount_ && column >= 0 && column < columnCount_;
+	}
+	// line번째 줄의 [first, last] 칸이 모두 통과 가능한지. 범위는 격자 안이어야 한다.
+	bool IsSpanWalkable(EAxis axis, int line, int first, int last) const;
+	// 두 셀 중심을 잇는 선분이 닿는 모든 셀(경계만 스치는 셀 포함)이 통과 가능한지. 선분이 격자 꼭짓점을 지나면
+	// 그 꼭짓점의 네 셀을 모두 보므로, 시야가 있으면 코너 컷팅 없이 직선으로 움직일 수 있다. 격자 밖이면 false.
+	bool HasLineOfSight(int fromRow, int fromColumn, int toRow, int toColumn) const;
+
+	size_t GetMemoryUsage() const
+	{
+		return (rowBoard_.Words.capacity() + columnBoard_.Words.capacity()) * sizeof(uint64_t);
+	}
+
+private:
+	// 가장 먼 256칸 읽기가 배열 밖으로 나가지 않도록 배열 앞뒤에 두는 0 워드 수
+	static constexpr int GUARD_WORDS = 4;
+
+	struct Board
+	{
+		std::vector<uint64_t> Words;
+		// 줄 하나의 워드 수. 앞뒤 0 워드를 포함한다.
+		int Stride = 0;
+
+		void Resize(int lineCount, int cellsPerLine);
+		// line번째 줄의 첫 데이터 워드. line은 -1부터 줄 수까지.
+		uint64_t* GetLine(int line) { return Words.data() + GUARD_WORDS + (line + 1) * Stride + 1; }
+		const uint64_t* GetLine(int line) const { return Words.data() + GUARD_WORDS + (line + 1) * Stride + 1; }
+	};
+
+	// axis 방향의 줄마다 선분이 지나는 구간을 읽는다. 위치는 줄 안의 칸 번호이다.
+	bool HasLineOfSightAlong(EAxis axis, int fromLine, int fromPosition, int toLine, int toPosition) const;
+
+	const uint64_t* GetLine(EAxis axis, int line) const
+	{
+		return axis == EAxis::Rows ? rowBoard_.GetLine(line) : columnBoard_.GetLine(line);
+	}
+
+	Board rowBoard_;
+	Board columnBoard_;
+	int rowCount_ = 0;
+	int columnCount_ = 0;
+};
@@ -0,0 +1,602 @@
+#include "HierarchicalPathfinder.h"
+
+#include "Pathfinding/PathfindingTypes.h"
+#include "Pathfinding/Profiling.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <limits>
+
+namespace
+{
+	constexpr float INFINITE_COST = std::numeric_limits<float>::max();
+	// 이보다 긴 입구는 양 끝에 두 개의 전이 지점을 둔다.
+	constexpr int MAX_SINGLE_TRANSITION_WIDTH = 6;
+}
+
+HierarchicalPathfinder::HierarchicalPathfinder(const Grid& grid, int clusterSize)
+	: grid_(grid)
+	, clusterSize_(std::max(clusterSize, 2))
+{
+}
+
+void HierarchicalPathfinder::Build(bool bAllowDiagonals)
+{
+	PATHFINDING_ZONE("HierarchicalPathfinder::Build");
+	bAllowDiagonals_ = bAllowDiagonals;
+	builtRowCount_ = grid_.GetRowCount();
+	builtColumnCount_ = grid_.GetColumnCount();
+	clusterRowCount_ = (grid_.GetRowCount() + clusterSize_ - 1) / clusterSize_;
+	clusterColumnCount_ = (grid_.GetColumnCount() + clusterSize_ - 1) / clusterSize_;
+
+	clusters_.assign(clusterRowCount_ * clusterColumnCount_, Cluster());
+	for (int clusterRow = 0; clusterRow < clusterRowCount_; ++clusterRow)
+	{
+		for (int clusterColumn = 0; clusterColumn < clusterColumnCount_; ++clusterColumn)
+		{
+			Cluster& cluster = clusters_[clusterRow * clusterColumnCount_ + clusterColumn];
+			cluster.Top = clusterRow * clusterSize_;
+			cluster.Left = clusterColumn * clusterSize_;
+			cluster.RowCount = std::min(clusterSize_, grid_.GetRowCount() - cluster.Top);
+			cluster.ColumnCount = std::min(clusterSize_, grid_.GetColumnCount() - cluster.Left);
+		}
+	}
+
+	nodes_.clear();
+	freeNodes_.clear();
+	verticalBorderNodes_.assign(clusterRowCount_ * clusterColumnCount_, {});
+	horizontalBorderNodes_.assign(clusterRowCount_ * clusterColumnCount_, {});
+
+	localDistances_.resize(clusterSize_ * clusterSize_);
+	localParents_.resize(clusterSize_ * clusterSize_);
+	localOpenList_.Resize(clusterSize_ * clusterSize_);
+
+	for (int clusterRow = 0; clusterRow < clusterRowCount_; ++clusterRow)
+	{
+		for (int clusterColumn = 0; clusterColumn < clusterColumnCount_; ++clusterColumn)
+		{
+			RebuildVerticalBorder(clusterRow, clusterColumn);
+			RebuildHorizontalBorder(clusterRow, clusterColumn);
+		}
+	}
+	for (int cluster = 0; cluster < static_cast<int>(clusters_.size()); ++cluster)
+	{
+		RebuildIntraEdges(cluster);
+	}
+}
+
+bool HierarchicalPathfinder::IsBuilt() const
+{
+	return !clusters_.empty() && builtRowCount_ == grid_.GetRowCount() && builtColumnCount_ == grid_.GetColumnCount();
+}
+
+int HierarchicalPathfinder::OnTileChanged(int row, int column)
+{
+	if (!IsBuilt() || !grid_.IsInBounds(row, column))
+	{
+		return 0;
+	}
+	const int clusterRow = row / clusterSize_;
+	const int clusterColumn = column / clusterSize_;
+	const Cluster& cluster = clusters_[GetClusterIndex(row, column)];
+
+	// 경계 위의 셀이면 그 경계의 입구와, 경계를 공유하는 이웃 클러스터도 다시 계산한다.
+	std::vector<int> dirtyClusters = {GetClusterIndex(row, column)};
+	if (row == cluster.Top && clusterRow > 0)
+	{
+		RebuildHorizontalBorder(clusterRow - 1, clusterColumn);
+		dirtyClusters.push_back(GetClusterIndex(row - 1, column));
+	}
+	if (row == cluster.Top + cluster.RowCount - 1 && clusterRow + 1 < clusterRowCount_)
+	{
+		RebuildHorizontalBorder(clusterRow, clusterColumn);
+		dirtyClusters.push_back(GetClusterIndex(row + 1, column));
+	}
+	if (column == cluster.Left && clusterColumn > 0)
+	{
+		RebuildVerticalBorder(clusterRow, clusterColumn - 1);
+		dirtyClusters.push_back(GetClusterIndex(row, column - 1));
+	}
+	if (column == cluster.Left + cluster.ColumnCount - 1 && clusterColumn + 1 < clusterColumnCount_)
+	{
+		RebuildVerticalBorder(clusterRow, clusterColumn);
+		dirtyClusters.push_back(GetClusterIndex(row, column + 1));
+	}
+
+	for (int dirtyCluster : dirtyClusters)
+	{
+		RebuildIntraEdges(dirtyCluster);
+	}
+	return static_cast<int>(dirtyClusters.size());
+}
+
+size_t HierarchicalPathfinder::GetAbstractEdgeCount() const
+{
+	size_t count = 0;
+	for (const AbstractNode& node : nodes_)
+	{
+		count += node.Edges.size();
+	}
+	return count;
+}
+
+size_t HierarchicalPathfinder::GetMemoryUsage() const
+{
+	size_t bytes = clusters_.capacity() * sizeof(Cluster) + nodes_.capacity() * sizeof(AbstractNode)
+				   + freeNodes_.capacity() * sizeof(int)
+				   + (verticalBorderNodes_.capacity() + horizontalBorderNodes_.capacity()) * sizeof(std::vector<int>);
+	for (const Cluster& cluster : clusters_)
+	{
+		bytes += cluster.Nodes.capacity() * sizeof(int);
+	}
+	for (const AbstractNode& node : nodes_)
+	{
+		bytes += node.Edges.capacity() * sizeof(AbstractEdge);
+	}
+	for (const std::vector<int>& borderNodes : verticalBorderNodes_)
+	{
+		bytes += borderNodes.capacity() * sizeof(int);
+	}
+	for (const std::vector<int>& borderNodes : horizontalBorderNodes_)
+	{
+		bytes += borderNodes.capacity() * sizeof(int);
+	}
+	return bytes + GetScratchMemoryUsage();
+}
+
+size_t HierarchicalPathfinder::GetScratchMemoryUsage() const
+{
+	return (localDistances_.capacity() + abstractGCosts_.capacity() + goalCosts_.capacity()) * sizeof(float)
+		   + (localParents_.capacity() + abstractParents_.capacity()) * sizeof(int) + localOpenList_.GetMemoryUsage()
+		   + abstractOpenList_.GetMemoryUsage();
+}
+
+void HierarchicalPathfinder::RebuildVerticalBorder(int clusterRow, int clusterColumn)
+{
+	std::vector<int>& borderNodes = verticalBorderNodes_[clusterRow * clusterColumnCount_ + clusterColumn];
+	for (int node : borderNodes)
+	{
+		RemoveNode(node);
+	}
+	borderNodes.clear();
+	if (clusterColumn + 1 >= clusterColumnCount_)
+	{
+		return;
+	}
+
+	const int leftCluster = clusterRow * clusterColumnCount_ + clusterColumn;
+	const int rightCluster = leftCluster + 1;
+	const Cluster& cluster = clusters_[leftCluster];
+	const int leftColumn = cluster.Left + cluster.ColumnCount - 1;
+
+	int runStart = -1;
+	for (int row = cluster.Top; row <= cluster.Top + cluster.RowCount; ++row)
+	{
+		const bool bOpen = row < cluster.Top + cluster.RowCount && grid_.IsWalkable(row, leftColumn)
+						   && grid_.IsWalkable(row, leftColumn + 1);
+		if (bOpen && runStart < 0)
+		{
+			runStart = row;
+		}
+		else if (!bOpen && runStart >= 0)
+		{
+			const int runEnd = row - 1;
+			if (runEnd - runStart + 1 < MAX_SINGLE_TRANSITION_WIDTH)
+			{
+				const int middle = (runStart + runEnd) / 2;
+				AddEntrance(borderNodes, grid_.ToIndex(middle, leftColumn), leftCluster,
+							grid_.ToIndex(middle, leftColumn + 1), rightCluster);
+			}
+			else
+			{
+				AddEntrance(borderNodes, grid_.ToIndex(runStart, leftColumn), leftCluster,
+							grid_.ToIndex(runStart, leftColumn + 1), rightCluster);
+				AddEntrance(borderNodes, grid_.ToIndex(runEnd, leftColumn), leftCluster,
+							grid_.ToIndex(runEnd, leftColumn + 1), rightCluster);
+			}
+			runStart = -1;
+		}
+	}
+}
+
+void HierarchicalPathfinder::RebuildHorizontalBorder(int clusterRow, int clusterColumn)
+{
+	std::vector<int>& borderNodes = horizontalBorderNodes_[clusterRow * clusterColumnCount_ + clusterColumn];
+	for (int node : borderNodes)
+	{
+		RemoveNode(node);
+	}
+	borderNodes.clear();
+	if (clusterRow + 1 >= clusterRowCount_)
+	{
+		return;
+	}
+
+	const int topCluster = clusterRow * clusterColumnCount_ + clusterColumn;
+	const int bottomCluster = topCluster + clusterColumnCount_;
+	const Cluster& cluster = clusters_[topCluster];
+	const int topRow = cluster.Top + cluster.RowCount - 1;
+
+	int runStart = -1;
+	for (int column = cluster.Left; column <= cluster.Left + cluster.ColumnCount; ++column)
+	{
+		const bool bOpen = column < cluster.Left + cluster.ColumnCount && grid_.IsWalkable(topRow, column)
+						   && grid_.IsWalkable(topRow + 1, column);
+		if (bOpen && runStart < 0)
+		{
+			runStart = column;
+		}
+		else if (!bOpen && runStart >= 0)
+		{
+			const int runEnd = column - 1;
+			if (runEnd - runStart + 1 < MAX_SINGLE_TRANSITION_WIDTH)
+			{
+				const int middle = (runStart + runEnd) / 2;
+				AddEntrance(borderNodes, grid_.ToIndex(topRow, middle), topCluster, grid_.ToIndex(topRow + 1, middle),
+							bottomCluster);
+			}
+			else
+			{
+				AddEntrance(borderNodes, grid_.ToIndex(topRow, runStart), topCluster,
+							grid_.ToIndex(topRow + 1, runStart), bottomCluster);
+				AddEntrance(borderNodes, grid_.ToIndex(topRow, runEnd), topCluster, grid_.ToIndex(topRow + 1, runEnd),
+							bottomCluster);
+			}
+			runStart = -1;
+		}
+	}
+}
+
+void HierarchicalPathfinder::AddEntrance(std::vector<int>& borderNodes, int cellA, int clusterA, int cellB,
+										 int clusterB)
+{
+	const int nodeA = AddNode(cellA, clusterA);
+	const int nodeB = AddNode(cellB, clusterB);
+	const float cost
+		= PathfindingConfig::ORTHOGONAL_COST * (grid_.GetTileCost(cellA) + grid_.GetTileCost(cellB)) * 0.5f;
+	nodes_[nodeA].Edges.push_back({nodeB, cost, true});
+	nodes_[nodeB].Edges.push_back({nodeA, cost, true});
+	borderNodes.push_back(nodeA);
+	borderNodes.push_back(nodeB);
+}
+
+void HierarchicalPathfinder::RebuildIntraEdges(int cluster)
+{
+	const std::vector<int>& clusterNodes = clusters_[cluster].Nodes;
+	for (int node : clusterNodes)
+	{
+		// 다른 클러스터로 가는 간선(입구)만 남긴다.
+		std::vector<AbstractEdge>& edges = nodes_[node].Edges;
+		edges.erase(std::remove_if(edges.begin(), edges.end(),
+								   [](const AbstractEdge& edge) { return !edge.bInterCluster; }),
+					edges.end());
+	}
+
+	for (int node : clusterNodes)
+	{
+		SearchCluster(cluster, nodes_[node].CellIndex, INVALID_INDEX);
+		for (int other : clusterNodes)
+		{
+			if (other == node)
+			{
+				continue;
+			}
+			const float distance = GetLocalDistance(cluster, nodes_[other].CellIndex);
+			if (distance != INFINITE_COST)
+			{
+				nodes_[node].Edges.push_back({other, distance, false});
+			}
+		}
+	}
+}
+
+int HierarchicalPathfinder::AddNode(int cellIndex, int cluster)
+{
+	int node;
+	if (!freeNodes_.empty())
+	{
+		node = freeNodes_.back();
+		freeNodes_.pop_back();
+	}
+	else
+	{
+		node = static_cast<int>(nodes_.size());
+		nodes_.emplace_back();
+	}
+	nodes_[node].CellIndex = cellIndex;
+	nodes_[node].Cluster = cluster;
+	nodes_[node].bAlive = true;
+	nodes_[node].Edges.clear();
+	clusters_[cluster].Nodes.push_back(node);
+	return node;
+}
+
+void HierarchicalPathfinder::RemoveNode(int node)
+{
+	std::vector<int>& clusterNodes = clusters_[nodes_[node].Cluster].Nodes;
+	clusterNodes.erase(std::find(clusterNodes.begin(), clusterNodes.end(), node));
+	nodes_[node].bAlive = false;
+	nodes_[node].Edges.clear();
+	freeNodes_.push_back(node);
+}
+
+void HierarchicalPathfinder::SearchCluster(int cluster, int sourceCell, int targetCell)
+{
+	const Cluster& bounds = clusters_[cluster];
+	auto toLocal = [&](int cellIndex)
+	{ return (grid_.ToRow(cellIndex) - bounds.Top) * bounds.ColumnCount + grid_.ToColumn(cellIndex) - bounds.Left; };
+	auto isInside = [&](int cellIndex)
+	{
+		const int row = grid_.ToRow(cellIndex);
+		const int column = grid_.ToColumn(cellIndex);
+		return row >= bounds.Top && row < bounds.Top + bounds.RowCount && column >= bounds.Left
+			   && column < bounds.Left + bounds.ColumnCount;
+	};
+
+	std::fill(localDistances_.begin(), localDistances_.end(), INFINITE_COST);
+	localOpenList_.Clear();
+
+	const int sourceLocal = toLocal(sourceCell);
+	localDistances_[sourceLocal] = 0.0f;
+	localParents_[sourceLocal] = INVALID_INDEX;
+	localOpenList_.Push({0.0f, 0.0f, sourceLocal});
+
+	while (!localOpenList_.IsEmpty())
+	{
+		stats_.PeakOpenListSize = std::max(stats_.PeakOpenListSize, localOpenList_.GetSize());
+		const int currentLocal = localOpenList_.Pop().Index;
+		++stats_.NodesExpanded;
+		const int currentCell = grid_.ToIndex(bounds.Top + currentLocal / bounds.ColumnCount,
+											  bounds.Left + currentLocal % bounds.ColumnCount);
+		if (currentCell == targetCell)
+		{
+			return;
+		}
+
+		auto relax = [&](int neighbor, bool bDiagonal)
+		{
+			if (!isInside(neighbor))
+			{
+				return;
+			}
+			const int neighborLocal = toLocal(neighbor);
+			const float oldDistance = localDistances_[neighborLocal];
+			const float moveCost = (bDiagonal ? PathfindingConfig::DIAGONAL_COST : PathfindingConfig::ORTHOGONAL_COST)
+								   * (grid_.GetTileCost(currentCell) + grid_.GetTileCost(neighbor)) * 0.5f;
+			const float newDistance = localDistances_[currentLocal] + moveCost;
+			if (newDistance < oldDistance)
+			{
+				localDistances_[neighborLocal] = newDistance;
+				localParents_[neighborLocal] = currentLocal;
+				++stats_.NodesGenerated;
+				if (oldDistance == INFINITE_COST)
+				{
+					localOpenList_.Push({newDistance, 0.0f, neighborLocal});
+				}
+				else
+				{
+					localOpenList_.Update({newDistance, 0.0f, neighborLocal});
+				}
+			}
+		};
+		if (bAllowDiagonals_)
+		{
+			grid_.ForEachNeighbor<true>(currentCell, relax);
+		}
+		else
+		{
+			grid_.ForEachNeighbor<false>(currentCell, relax);
+		}
+	}
+}
+
+float HierarchicalPathfinder::GetLocalDistance(int cluster, int cellIndex) const
+{
+	const Cluster& bounds = clusters_[cluster];
+	const int local
+		= (grid_.ToRow(cellIndex) - bounds.Top) * bounds.ColumnCount + grid_.ToColumn(cellIndex) - bounds.Left;
+	return localDistances_[local];
+}
+
+void HierarchicalPathfinder::AppendLocalPath(int cluster, int sourceCell, int targetCell,
+											 std::vector<GridPosition>& cells)
+{
+	SearchCluster(cluster, sourceCell, targetCell);
+
+	const Cluster& bounds = clusters_[cluster];
+	const size_t segmentStart = cells.size();
+	int local
+		= (grid_.ToRow(targetCell) - bounds.Top) * bounds.ColumnCount + grid_.ToColumn(targetCell) - bounds.Left;
+	while (local != INVALID_INDEX)
+	{
+		cells.push_back({bounds.Top + local / bounds.ColumnCount, bounds.Left + local % bounds.ColumnCount});
+		local = localParents_[local];
+	}
+	std::reverse(cells.begin() + segmentStart, cells.end());
+}
+
+float HierarchicalPathfinder::EstimateCost(int fromCell, int toCell) const
+{
+	const int deltaRow = std::abs(grid_.ToRow(fromCell) - grid_.ToRow(toCell));
+	const int deltaColumn = std::abs(grid_.ToColumn(fromCell) - grid_.ToColumn(toCell));
+	if (!bAllowDiagonals_)
+	{
+		return static_cast<float>(deltaRow + deltaColumn);
+	}
+	return std::min(deltaRow, deltaColumn) * PathfindingConfig::DIAGONAL_COST
+		   + std::abs(deltaRow - deltaColumn) * PathfindingConfig::ORTHOGONAL_COST;
+}
+
+PathResult HierarchicalPathfinder::FindPath(const GridPosition& start, const GridPosition& end)
+{
+	PATHFINDING_ZONE("HierarchicalPathfinder::FindPath");
+	const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	stats_ = {};
+	PathResult result;
+	RunQuery(start, end, result);
+	stats_.ElapsedTime = std::chrono::steady_clock::now() - startTime;
+	result.Stats = stats_;
+	result.Stats.PathCellCount = static_cast<int>(result.Cells.size());
+	result.Stats.PathCost = result.Cost;
+	result.Stats.ScratchBytes = GetScratchMemoryUsage();
+	return result;
+}
+
+void HierarchicalPathfinder::RunQuery(const GridPosition& start, const GridPosition& end, PathResult& result)
+{
+	if (!IsBuilt() || !grid_.IsInBounds(start.Row, start.Column) || !grid_.IsInBounds(end.Row, end.Column)
+		|| !grid_.IsWalkable(start.Row, start.Column) || !grid_.IsWalkable(end.Row, end.Column))
+	{
+		return;
+	}
+
+	const int startCell = grid_.ToIndex(start.Row, start.Column);
+	const int endCell = grid_.ToIndex(end.Row, end.Column);
+	const int startCluster = GetClusterIndex(start.Row, start.Column);
+	const int endCluster = GetClusterIndex(end.Row, end.Column);
+
+	// 시작/도착 셀을 임시 노드로 추상 그래프에 연결한다.
+	const int nodeCount = static_cast<int>(nodes_.size());
+	const int startNode = nodeCount;
+	const int goalNode = nodeCount + 1;
+
+	std::vector<AbstractEdge> startEdges;
+	float directCost = INFINITE_COST;
+	SearchCluster(startCluster, startCell, INVALID_INDEX);
+	for (int node : clusters_[startCluster].Nodes)
+	{
+		const float distance = GetLocalDistance(startCluster, nodes_[node].CellIndex);
+		if (distance != INFINITE_COST)
+		{
+			startEdges.push_back({node, distance, false});
+		}
+	}
+	if (startCluster == endCluster)
+	{
+		directCost = GetLocalDistance(startCluster, endCell);
+	}
+
+	goalCosts_.assign(nodeCount, INFINITE_COST);
+	SearchCluster(endCluster, endCell, INVALID_INDEX);
+	for (int node : clusters_[endCluster].Nodes)
+	{
+		goalCosts_[node] = GetLocalDistance(endCluster, nodes_[node].CellIndex);
+	}
+
+	abstractGCosts_.assign(nodeCount + 2, INFINITE_COST);
+	abstractParents_.assign(nodeCount + 2, INVALID_INDEX);
+	abstractOpenList_.Resize(nodeCount + 2);
+	abstractOpenList_.Clear();
+
+	auto cellOf = [&](int node)
+	{
+		if (node == startNode)
+		{
+			return startCell;
+		}
+		return node == goalNode ? endCell : nodes_[node].CellIndex;
+	};
+	auto relax = [&](int from, int to, float cost)
+	{
+		const float oldCost = abstractGCosts_[to];
+		const float newCost = abstractGCosts_[from] + cost;
+		if (newCost < oldCost)
+		{
+			const float hCost = EstimateCost(cellOf(to), endCell);
+			abstractGCosts_[to] = newCost;
+			abstractParents_[to] = from;
+			++stats_.NodesGenerated;
+			// 간선 비용은 float로 누적한 클러스터 내부 거리라 휴리스틱보다 아주 조금 작을 수 있다. 그러면 이미
+			// 꺼낸 노드가 다시 싸지므로, 힙에 없는 노드는 Update 대신 다시 넣는다.
+			if (abstractOpenList_.Contains(to))
+			{
+				abstractOpenList_.Update({newCost + hCost, hCost, to});
+			}
+			else
+			{
+				if (oldCost != INFINITE_COST)
+				{
+					++stats_.ReopenedCount;
+				}
+				abstractOpenList_.Push({newCost + hCost, hCost, to});
+			}
+		}
+	};
+
+	abstractGCosts_[startNode] = 0.0f;
+	abstractOpenList_.Push({EstimateCost(startCell, endCell), EstimateCost(startCell, endCell), startNode});
+	while (!abstractOpenList_.IsEmpty())
+	{
+		stats_.PeakOpenListSize = std::max(stats_.PeakOpenListSize, abstractOpenList_.GetSize());
+		const OpenNode top = abstractOpenList_.Pop();
+		++stats_.NodesExpanded;
+		const int current = top.Index;
+		// 같은 클러스터 안의 직접 경로보다 나아질 수 없으면 멈춘다.
+		if (current == goalNode || top.FCost >= directCost)
+		{
+			break;
+		}
+		if (current == startNode)
+		{
+			for (const AbstractEdge& edge : startEdges)
+			{
+				relax(current, edge.Target, edge.Cost);
+			}
+			continue;
+		}
+		for (const AbstractEdge& edge : nodes_[current].Edges)
+		{
+			relax(current, edge.Target, edge.Cost);
+		}
+		if (goalCosts_[current] != INFINITE_COST)
+		{
+			relax(current, goalNode, goalCosts_[current]);
+		}
+	}
+
+	const float abstractCost = abstractGCosts_[goalNode];
+	if (directCost == INFINITE_COST && abstractCost == INFINITE_COST)
+	{
+		return;
+	}
+
+	result.bFound = true;
+	if (directCost <= abstractCost)
+	{
+		result.Cost = directCost;
+		AppendLocalPath(startCluster, startCell, endCell, result.Cells);
+		return;
+	}
+
+	result.Cost = abstractCost;
+	std::vector<int> abstractPath;
+	for (int node = goalNode; node != INVALID_INDEX; node = abstractParents_[node])
+	{
+		abstractPath.push_back(node);
+	}
+	std::reverse(abstractPath.begin(), abstractPath.end());
+
+	result.Cells.push_back(start);
+	for (size_t i = 1; i < abstractPath.size(); ++i)
+	{
+		const int from = abstractPath[i - 1];
+		const int to = abstractPath[i];
+		const int fromCell = cellOf(from);
+		const int toCell = cellOf(to);
+		const int cluster = from == startNode ? startCluster : to == goalNode ? endCluster : nodes_[from].Cluster;
+		if (fromCell == toCell)
+		{
+			continue;
+		}
+		if (from != startNode && to != goalNode && nodes_[from].Cluster != nodes_[to].Cluster)
+		{
+			// 입구: 인접한 두 셀
+			result.Cells.push_back({grid_.ToRow(toCell), grid_.ToColumn(toCell)});
+			continue;
+		}
+		// 구간의 첫 셀은 이전 구간의 마지막 셀과 같으므로 제외한다.
+		result.Cells.pop_back();
+		AppendLocalPath(cluster, fromCell, toCell, result.Cells);
+	}
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include "Pathfinding/Grid.h"
+#include "Pathfinding/OpenList.h"
+#include "Pathfinding/PathResult.h"
+
+#include <cstddef>
+#include <vector>
+
+// HPA*: 격자를 정사각형 클러스터로 나누고, 클러스터 경계의 입구(entrance)를 추상 노드로 만든다.
+// 같은 클러스터 안의 추상 노드 사이 거리를 미리 계산해 두고, 쿼리는 추상 그래프를 탐색한 뒤
+// 필요한 구간만 클러스터 내부 탐색으로 풀어낸다. 결과는 최적 경로에 가깝지만 보장되지는 않는다.
+class HierarchicalPathfinder
+{
+public:
+	static constexpr int DEFAULT_CLUSTER_SIZE = 16;
+
+	explicit HierarchicalPathfinder(const Grid& grid, int clusterSize = DEFAULT_CLUSTER_SIZE);
+
+	// 전체 추상 그래프를 만든다. Grid 크기가 바뀌었을 때도 다시 호출해야 한다.
+	void Build(bool bAllowDiagonals);
+	// Build 이후 Grid 크기가 바뀌지 않았는지
+	bool IsBuilt() const;
+	// Grid의 타일 하나(벽 또는 셀 비용)가 바뀐 뒤 호출한다. 다시 계산한 클러스터 수를 반환한다.
+	// IsBuilt가 아니면 아무것도 하지 않고 0을 반환한다.
+	int OnTileChanged(int row, int column);
+
+	// IsBuilt가 아니면 찾지 못한 결과를 반환한다. Stats의 확장 수와 Open List 크기는 추상 그래프 탐색과
+	// 시작/도착 클러스터 및 경로를 풀어내는 클러스터 내부 탐색을 합한 값이다.
+	PathResult FindPath(const GridPosition& start, const GridPosition& end);
+
+	int GetClusterCount() const { return static_cast<int>(clusters_.size()); }
+	int GetAbstractNodeCount() const { return static_cast<int>(nodes_.size() - freeNodes_.size()); }
+	size_t GetAbstractEdgeCount() const;
+	size_t GetMemoryUsage() const;
+
+private:
+	struct AbstractEdge
+	{
+		int Target;
+		float Cost;
+		// 입구 간선(다른 클러스터로 넘어감). false면 클러스터 내부 간선
+		bool bInterCluster;
+	};
+
+	struct AbstractNode
+	{
+		int CellIndex = -1;
+		int Cluster = -1;
+		bool bAlive = false;
+		std::vector<AbstractEdge> Edges;
+	};
+
+	struct Cluster
+	{
+		int Top = 0;
+		int Left = 0;
+		int RowCount = 0;
+		int ColumnCount = 0;
+		std::vector<int> Nodes;
+	};
+
+	int GetClusterIndex(int row, int column) const
+	{
+		return (row / clusterSize_) * clusterColumnCount_ + column / clusterSize_;
+	}
+
+	// 세로 경계: (clusterRow, clusterColumn)과 오른쪽 클러스터 사이
+	void RebuildVerticalBorder(int clusterRow, int clusterColumn);
+	// 가로 경계: (clusterRow, clusterColumn)과 아래쪽 클러스터 사이
+	void RebuildHorizontalBorder(int clusterRow, int clusterColumn);
+	void AddEntrance(std::vector<int>& borderNodes, int cellA, int clusterA, int cellB, int clusterB);
+	void RebuildIntraEdges(int cluster);
+
+	int AddNode(int cellIndex, int cluster);
+	void RemoveNode(int node);
+
+	// 클러스터 안에서만 이동하는 다익스트라. targetCell에 도달하면 멈춘다(INVALID_INDEX면 전체 탐색).
+	void SearchCluster(int cluster, int sourceCell, int targetCell);
+	float GetLocalDistance(int cluster, int cellIndex) const;
+	void AppendLocalPath(int cluster, int sourceCell, int targetCell, std::vector<GridPosition>& cells);
+
+	float EstimateCost(int fromCell, int toCell) const;
+	// 통계를 채우지 않는 본체. result는 비어 있는 상태로 받는다.
+	void RunQuery(const GridPosition& start, const GridPosition& end, PathResult& result);
+	size_t GetScratchMemoryUsage() const;
+
+	static constexpr int INVALID_INDEX = -1;
+
+	const Grid& grid_;
+	int clusterSize_;
+	// Build 당시의 Grid 크기
+	int builtRowCount_ = 0;
+	int builtColumnCount_ = 0;
+	int clusterRowCount_ = 0;
+	int clusterColumnCount_ = 0;
+	bool bAllowDiagonals_ = true;
+
+	std::vector<Cluster> clusters_;
+	std::vector<AbstractNode> nodes_;
+	std::vector<int> freeNodes_;
+	std::vector<std::vector<int>> verticalBorderNodes_;
+	std::vector<std::vector<int>> horizontalBorderNodes_;
+
+	// SearchCluster 스크래치 (클러스터 로컬 인덱스)
+	std::vector<float> localDistances_;
+	std::vector<int> localParents_;
+	BinaryHeap localOpenList_;
+
+	// 추상 그래프 탐색 스크래치
+	std::vector<float> abstractGCosts_;
+	std::vector<int> abstractParents_;
+	std::vector<float> goalCosts_;
+	BinaryHeap abstractOpenList_;
+
+	// FindPath마다 초기화한다.
+	SearchStats stats_;
+};
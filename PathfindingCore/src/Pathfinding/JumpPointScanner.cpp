@@ -0,0 +1,171 @@
+#include "JumpPointScanner.h"
+
+#include <bit>
+
+#if defined(__AVX2__)
+namespace
+{
+// 64칸을 막힘 없이 지났으면 긴 구간일 가능성이 높으므로, 그때부터는 256칸에 벽도 강제 이웃도 도착 셀도 없는 동안
+// 한 번에 건너뛴다. 줄 끝의 0 워드에서 반드시 멈춘다. 남은 부분은 호출한 쪽이 64칸씩 다시 본다.
+int SkipClearForward(const GridBitboard& bitboard, GridBitboard::EAxis axis, int line, int position, int endPosition)
+{
+	const __m256i allOnes = _mm256_set1_epi64x(-1);
+	auto loadForced = [&](int side)
+	{
+		return _mm256_andnot_si256(bitboard.LoadForward256(axis, side, position - 1),
+								   bitboard.LoadForward256(axis, side, position));
+	};
+	while (endPosition < position || endPosition >= position + 256)
+	{
+		const __m256i blocked = _mm256_xor_si256(bitboard.LoadForward256(axis, line, position), allOnes);
+		const __m256i stops = _mm256_or_si256(blocked, _mm256_or_si256(loadForced(line - 1), loadForced(line + 1)));
+		if (!_mm256_testz_si256(stops, stops))
+		{
+			break;
+		}
+		position += 256;
+	}
+	return position;
+}
+
+// SkipClearForward와 같지만 [position - 255, position] 구간을 본다.
+int SkipClearBackward(const GridBitboard& bitboard, GridBitboard::EAxis axis, int line, int position, int endPosition)
+{
+	const __m256i allOnes = _mm256_set1_epi64x(-1);
+	auto loadForced = [&](int side, int first)
+	{
+		return _mm256_andnot_si256(bitboard.LoadForward256(axis, side, first + 1),
+								   bitboard.LoadForward256(axis, side, first));
+	};
+	while (endPosition > position || endPosition <= position - 256)
+	{
+		const int first = position - 255;
+		const __m256i blocked = _mm256_xor_si256(bitboard.LoadForward256(axis, line, first), allOnes);
+		const __m256i stops
+			= _mm256_or_si256(blocked, _mm256_or_si256(loadForced(line - 1, first), loadForced(line + 1, first)));
+		if (!_mm256_testz_si256(stops, stops))
+		{
+			break;
+		}
+		position -= 256;
+	}
+	return position;
+}
+} // namespace
+#endif
+
+int JumpPointScanner::Jump(int row, int column, int dRow, int dColumn) const
+{
+	if (dRow == 0 || dColumn == 0)
+	{
+		return JumpStraight(row, column, dRow, dColumn);
+	}
+
+	while (IsWalkable(row, column))
+	{
+		const int index = grid_.ToIndex(row, column);
+		if (index == endIndex_)
+		{
+			return index;
+		}
+		// 대각선 이동 중에는 직선 방향으로 점프 포인트가 보이면 멈춘다.
+		if (JumpStraight(row, column + dColumn, 0, dColumn) != INVALID_INDEX
+			|| JumpStraight(row + dRow, column, dRow, 0) != INVALID_INDEX)
+		{
+			return index;
+		}
+		if (!IsWalkable(row, column + dColumn) || !IsWalkable(row + dRow, column))
+		{
+			return INVALID_INDEX;
+		}
+		row += dRow;
+		column += dColumn;
+	}
+	return INVALID_INDEX;
+}
+
+int JumpPointScanner::JumpStraight(int row, int column, int dRow, int dColumn) const
+{
+	if (!IsWalkable(row, column))
+	{
+		return INVALID_INDEX;
+	}
+	// 가로 이동은 행 비트보드, 세로 이동은 열 비트보드에서 같은 방식으로 훑는다.
+	if (dColumn != 0)
+	{
+		const int endPosition = row == endRow_ ? endColumn_ : INVALID_INDEX;
+		const int stop = dColumn > 0 ? ScanForward(GridBitboard::EAxis::Rows, row, column, endPosition)
+									 : ScanBackward(GridBitboard::EAxis::Rows, row, column, endPosition);
+		return stop == INVALID_INDEX ? INVALID_INDEX : grid_.ToIndex(row, stop);
+	}
+	const int endPosition = column == endColumn_ ? endRow_ : INVALID_INDEX;
+	const int stop = dRow > 0 ? ScanForward(GridBitboard::EAxis::Columns, column, row, endPosition)
+							  : ScanBackward(GridBitboard::EAxis::Columns, column, row, endPosition);
+	return stop == INVALID_INDEX ? INVALID_INDEX : grid_.ToIndex(stop, column);
+}
+
+int JumpPointScanner::ScanForward(GridBitboard::EAxis axis, int line, int position, int endPosition) const
+{
+	const GridBitboard& bitboard = *bitboard_;
+	const bool bHasEnd = endPosition != INVALID_INDEX;
+	for (;;)
+	{
+		const uint64_t blocked = ~bitboard.LoadForward(axis, line, position);
+		// 지나온 쪽 옆 칸이 벽이고 현재 옆 칸이 열려 있으면 강제 이웃이 생긴다.
+		uint64_t stops = (bitboard.LoadForward(axis, line - 1, position)
+						  & ~bitboard.LoadForward(axis, line - 1, position - 1))
+						 | (bitboard.LoadForward(axis, line + 1, position)
+							& ~bitboard.LoadForward(axis, line + 1, position - 1));
+		if (bHasEnd && endPosition >= position && endPosition - position < 64)
+		{
+			stops |= 1ull << (endPosition - position);
+		}
+		// 첫 벽 앞의 멈출 곳만 본다. 벽이 없으면 마스크는 모든 비트이다.
+		stops &= (blocked & (0 - blocked)) - 1;
+		if (stops != 0)
+		{
+			return position + std::countr_zero(stops);
+		}
+		if (blocked != 0)
+		{
+			return INVALID_INDEX;
+		}
+		position += 64;
+#if defined(__AVX2__)
+		position = SkipClearForward(bitboard, axis, line, position, endPosition);
+#endif
+	}
+}
+
+int JumpPointScanner::ScanBackward(GridBitboard::EAxis axis, int line, int position, int endPosition) const
+{
+	const GridBitboard& bitboard = *bitboard_;
+	const bool bHasEnd = endPosition != INVALID_INDEX;
+	for (;;)
+	{
+		// 비트 63이 position이고 낮은 비트로 갈수록 진행 방향이다.
+		const uint64_t blocked = ~bitboard.LoadBackward(axis, line, position);
+		uint64_t stops = (bitboard.LoadBackward(axis, line - 1, position)
+						  & ~bitboard.LoadBackward(axis, line - 1, position + 1))
+						 | (bitboard.LoadBackward(axis, line + 1, position)
+							& ~bitboard.LoadBackward(axis, line + 1, position + 1));
+		if (bHasEnd && endPosition <= position && position - endPosition < 64)
+		{
+			stops |= 1ull << (63 - (position - endPosition));
+		}
+		if (blocked != 0)
+		{
+			// 첫 벽(가장 높은 비트)보다 위쪽만 본다.
+			stops &= (~0ull << (63 - std::countl_zero(blocked))) << 1;
+			return stops != 0 ? position - std::countl_zero(stops) : INVALID_INDEX;
+		}
+		if (stops != 0)
+		{
+			return position - std::countl_zero(stops);
+		}
+		position -= 64;
+#if defined(__AVX2__)
+		position = SkipClearBackward(bitboard, axis, line, position, endPosition);
+#endif
+	}
+}
@@ -0,0 +1,171 @@
+#pragma once
+#include "Pathfinding/Grid.h"
+
+#include <cstdlib>
+
+// 코너 컷팅을 허용하지 않는 8방향, 균일 비용 격자용 Jump Point Search 후속 노드 생성기.
+// 직선 이동은 옆 칸의 벽이 끝나는 지점에서, 대각선 이동은 직선 방향으로 점프 포인트가
+// 보이는 지점에서 멈춘다.
+//
+// 직선 스캔은 Grid의 행/열 비트보드에서 한 번에 64칸(AVX2로 빌드하면 막힌 곳이 없는 구간은 256칸)씩 읽고,
+// 옆 줄의 "앞 칸은 벽, 이번 칸은 열림" 비트와 진행 줄의 첫 벽을 비트 연산으로 찾는다.
+class JumpPointScanner
+{
+public:
+	explicit JumpPointScanner(const Grid& grid)
+		: grid_(grid)
+	{
+	}
+
+	// 탐색마다 Jump 전에 부른다. Grid의 행/열 비트보드가 아직 없으면 여기서 만든다.
+	void SetEndIndex(int endIndex)
+	{
+		bitboard_ = &grid_.GetBitboard();
+		endIndex_ = endIndex;
+		endRow_ = endIndex == INVALID_INDEX ? INVALID_INDEX : grid_.ToRow(endIndex);
+		endColumn_ = endIndex == INVALID_INDEX ? INVALID_INDEX : grid_.ToColumn(endIndex);
+	}
+
+	// (row, column)에서 (dRow, dColumn) 방향으로 점프한다. 점프 포인트가 없으면 INVALID_INDEX.
+	int Jump(int row, int column, int dRow, int dColumn) const;
+
+	// 부모 방향으로 가지치기한 이웃 방향마다 점프해서 func(jumpPointIndex)를 호출한다.
+	template <typename Func>
+	void ForEachSuccessor(int index, int parentIndex, Func&& func) const
+	{
+		const int row = grid_.ToRow(index);
+		const int column = grid_.ToColumn(index);
+
+		auto tryJump = [&](int dRow, int dColumn)
+		{
+			const int jumpPoint = Jump(row + dRow, column + dColumn, dRow, dColumn);
+			if (jumpPoint != INVALID_INDEX)
+			{
+				func(jumpPoint);
+			}
+		};
+
+		if (parentIndex == INVALID_INDEX)
+		{
+			// 시작 노드는 코너 컷팅 규칙을 지키는 모든 방향으로 점프한다.
+			const bool bCanUp = IsWalkable(row - 1, column);
+			const bool bCanDown = IsWalkable(row + 1, column);
+			const bool bCanLeft = IsWalkable(row, column - 1);
+			const bool bCanRight = IsWalkable(row, column + 1);
+			tryJump(-1, 0);
+			tryJump(1, 0);
+			tryJump(0, -1);
+			tryJump(0, 1);
+			if (bCanUp && bCanLeft)
+			{
+				tryJump(-1, -1);
+			}
+			if (bCanUp && bCanRight)
+			{
+				tryJump(-1, 1);
+			}
+			if (bCanDown && bCanLeft)
+			{
+				tryJump(1, -1);
+			}
+			if (bCanDown && bCanRight)
+			{
+				tryJump(1, 1);
+			}
+			return;
+		}
+
+		const int dRow = Sign(row - grid_.ToRow(parentIndex));
+		const int dColumn = Sign(column - grid_.ToColumn(parentIndex));
+		if (dRow != 0 && dColumn != 0)
+		{
+			const bool bCanVertical = IsWalkable(row + dRow, column);
+			const bool bCanHorizontal = IsWalkable(row, column + dColumn);
+			if (bCanVertical)
+			{
+				tryJump(dRow, 0);
+			}
+			if (bCanHorizontal)
+			{
+				tryJump(0, dColumn);
+			}
+			if (bCanVertical && bCanHorizontal)
+			{
+				tryJump(dRow, dColumn);
+			}
+		}
+		else if (dColumn != 0)
+		{
+			const bool bCanNext = IsWalkable(row, column + dColumn);
+			const bool bCanUp = IsWalkable(row - 1, column);
+			const bool bCanDown = IsWalkable(row + 1, column);
+			if (bCanNext)
+			{
+				tryJump(0, dColumn);
+				if (bCanUp)
+				{
+					tryJump(-1, dColumn);
+				}
+				if (bCanDown)
+				{
+					tryJump(1, dColumn);
+				}
+			}
+			if (bCanUp)
+			{
+				tryJump(-1, 0);
+			}
+			if (bCanDown)
+			{
+				tryJump(1, 0);
+			}
+		}
+		else
+		{
+			const bool bCanNext = IsWalkable(row + dRow, column);
+			const bool bCanLeft = IsWalkable(row, column - 1);
+			const bool bCanRight = IsWalkable(row, column + 1);
+			if (bCanNext)
+			{
+				tryJump(dRow, 0);
+				if (bCanLeft)
+				{
+					tryJump(dRow, -1);
+				}
+				if (bCanRight)
+				{
+					tryJump(dRow, 1);
+				}
+			}
+			if (bCanLeft)
+			{
+				tryJump(0, -1);
+			}
+			if (bCanRight)
+			{
+				tryJump(0, 1);
+			}
+		}
+	}
+
+private:
+	static constexpr int INVALID_INDEX = -1;
+
+	static int Sign(int value) { return (value > 0) - (value < 0); }
+
+	// 격자에서 한 칸 밖까지는 벽으로 읽힌다.
+	bool IsWalkable(int row, int column) const { return bitboard_->IsWalkable(row, column); }
+
+	int JumpStraight(int row, int column, int dRow, int dColumn) const;
+	// line번째 줄을 position부터 위치가 늘어나는(ScanForward) 또는 줄어드는(ScanBackward) 쪽으로 훑어서
+	// 멈출 위치를 찾는다. 멈출 곳 없이 벽에 막히면 INVALID_INDEX. endPosition은 도착 셀이 이 줄에 없으면 INVALID_INDEX.
+	int ScanForward(GridBitboard::EAxis axis, int line, int position, int endPosition) const;
+	int ScanBackward(GridBitboard::EAxis axis, int line, int position, int endPosition) const;
+
+	const Grid& grid_;
+	// SetEndIndex에서 받아 둔 grid_의 비트보드. 비트보드는 Grid 안에 있으므로 주소가 바뀌지 않는다.
+	const GridBitboard* bitboard_ = nullptr;
+	int endIndex_ = INVALID_INDEX;
+	int endRow_ = INVALID_INDEX;
+	int endColumn_ = INVALID_INDEX;
+};
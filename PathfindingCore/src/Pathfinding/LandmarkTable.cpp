@@ -0,0 +1,154 @@
+#include "LandmarkTable.h"
+
+#include "Pathfinding/CostFunctions.h"
+#include "Pathfinding/OpenList.h"
+#include "Pathfinding/Profiling.h"
+#include "Pathfinding/SearchSpace.h"
+
+#include <cmath>
+
+void LandmarkTable::Build(const Grid& grid, int landmarkCount)
+{
+	PATHFINDING_ZONE("LandmarkTable::Build");
+	Clear();
+	const int cellCount = grid.GetCellCount();
+	cellCount_ = cellCount;
+
+	SearchSpace searchSpace;
+	searchSpace.Resize(cellCount);
+	BinaryHeap openList;
+	openList.Resize(cellCount);
+	// 확장한 순서대로 기록한 셀. 다익스트라이므로 마지막 셀이 가장 멀다.
+	std::vector<int> reachedCells;
+
+	auto search = [&](int source, const auto& costModel)
+	{
+		searchSpace.Clear();
+		openList.Clear();
+		reachedCells.clear();
+		searchSpace.SetGCost(source, 0.0f);
+		openList.Push({0.0f, 0.0f, source});
+		while (!openList.IsEmpty())
+		{
+			const int current = openList.Pop().Index;
+			searchSpace.SetClosed(current);
+			reachedCells.push_back(current);
+			const float currentCost = searchSpace.GetGCost(current);
+			grid.ForEachNeighbor<true>(
+				current,
+				[&](int neighbor, bool bDiagonal)
+				{
+					if (searchSpace.IsClosed(neighbor))
+					{
+						return;
+					}
+					const float oldCost = searchSpace.GetGCost(neighbor);
+					const float newCost = currentCost + costModel.GetMoveCost(current, neighbor, bDiagonal);
+					if (newCost >= oldCost)
+					{
+						return;
+					}
+					searchSpace.SetGCost(neighbor, newCost);
+					if (oldCost == PathfindingConfig::IMPASSABLE_COST)
+					{
+						openList.Push({newCost, 0.0f, neighbor});
+					}
+					else
+					{
+						openList.Update({newCost, 0.0f, neighbor});
+					}
+				});
+		}
+	};
+	auto searchFrom = [&](int source)
+	{
+		if (const float* tileCosts = grid.GetTileCosts())
+		{
+			search(source, WeightedCostModel{tileCosts});
+		}
+		else
+		{
+			search(source, UniformCostModel{});
+		}
+	};
+
+	// 작은 고립 영역에 랜드마크를 두지 않도록 통과 가능 셀의 과반이 연결된 영역을 찾는다.
+	// 이미 도달한 셀은 건너뛰므로 셀마다 한 번만 탐색한다.
+	int walkableCount = 0;
+	for (int index = 0; index < cellCount; ++index)
+	{
+		walkableCount += grid.IsWalkable(index);
+	}
+	std::vector<bool> bReached(cellCount, false);
+	int seed = SearchSpace::INVALID_INDEX;
+	size_t seedReachedCount = 0;
+	for (int index = 0; index < cellCount && seedReachedCount * 2 < static_cast<size_t>(walkableCount); ++index)
+	{
+		if (!grid.IsWalkable(index) || bReached[index])
+		{
+			continue;
+		}
+		searchFrom(index);
+		for (int cell : reachedCells)
+		{
+			bReached[cell] = true;
+		}
+		if (reachedCells.size() > seedReachedCount)
+		{
+			seed = index;
+			seedReachedCount = reachedCells.size();
+		}
+	}
+	if (seed == SearchSpace::INVALID_INDEX)
+	{
+		return;
+	}
+
+	// 첫 랜드마크는 시작점에서 가장 먼 셀, 이후에는 기존 랜드마크들과의 최소 거리가 가장 큰 셀을 고른다.
+	landmarkCount = std::min(landmarkCount, static_cast<int>(seedReachedCount));
+	searchFrom(seed);
+	int nextLandmark = reachedCells.back();
+
+	distances_.assign(static_cast<size_t>(cellCount) * landmarkCount, UNREACHABLE);
+	scales_.assign(landmarkCount, 1.0f);
+	std::vector<float> minDistances(cellCount, PathfindingConfig::IMPASSABLE_COST);
+	for (int i = 0; i < landmarkCount; ++i)
+	{
+		landmarks_.push_back(nextLandmark);
+		searchFrom(nextLandmark);
+
+		const float maxDistance = searchSpace.GetGCost(reachedCells.back());
+		if (maxDistance > 0.0f)
+		{
+			scales_[i] = maxDistance / static_cast<float>(UNREACHABLE - 1);
+		}
+		float farthestDistance = 0.0f;
+		for (int cell : reachedCells)
+		{
+			const float distance = searchSpace.GetGCost(cell);
+			distances_[static_cast<size_t>(cell) * landmarkCount + i]
+				= static_cast<uint16_t>(std::lround(distance / scales_[i]));
+			minDistances[cell] = std::min(minDistances[cell], distance);
+			if (minDistances[cell] > farthestDistance)
+			{
+				farthestDistance = minDistances[cell];
+				nextLandmark = cell;
+			}
+		}
+	}
+}
+
+void LandmarkTable::Clear()
+{
+	landmarks_.clear();
+	distances_.clear();
+	distances_.shrink_to_fit();
+	scales_.clear();
+	cellCount_ = 0;
+}
+
+size_t LandmarkTable::GetMemoryUsage() const
+{
+	return distances_.capacity() * sizeof(uint16_t) + scales_.capacity() * sizeof(float)
+		   + landmarks_.capacity() * sizeof(int);
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include "Pathfinding/Grid.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+// ALT(A*, Landmarks, Triangle inequality) 휴리스틱의 전처리 결과.
+// 랜드마크 L마다 모든 셀까지의 최단 거리 d를 구해 두면, 삼각 부등식에 의해 |d(L, 목표) - d(L, v)|가
+// v에서 목표까지 거리의 하한이 된다. 벽이 많은 맵에서는 기하 휴리스틱보다 훨씬 정확하다.
+//
+// 거리는 랜드마크마다 (최대 거리 / 65534) 단위로 반올림한 uint16으로 저장한다(셀당 랜드마크 수 * 2바이트).
+// 반올림 오차만큼 한 단위를 빼서 하한을 유지하지만, 그 때문에 일관성(consistency)은 보장되지 않으므로
+// 이 휴리스틱을 쓰는 탐색은 Closed 셀을 다시 열 수 있어야 한다.
+//
+// 8방향 이동과 Build 시점의 벽/셀 비용을 기준으로 하므로 맵이 바뀌면 다시 Build해야 한다.
+class LandmarkTable
+{
+public:
+	static constexpr int DEFAULT_LANDMARK_COUNT = 8;
+
+	// 가장 큰 연결 영역에서 서로 가장 먼 셀들을 차례로 랜드마크로 고르고 거리 표를 만든다.
+	void Build(const Grid& grid, int landmarkCount = DEFAULT_LANDMARK_COUNT);
+	void Clear();
+
+	bool IsBuilt() const { return !landmarks_.empty(); }
+	// Build한 Grid의 셀 수. 다른 크기의 Grid에는 쓸 수 없다.
+	int GetCellCount() const { return cellCount_; }
+	const std::vector<int>& GetLandmarks() const { return landmarks_; }
+
+	// index에서 goalIndex까지 거리의 하한. 어느 랜드마크에서도 두 셀이 모두 도달 가능하지 않으면 0.
+	float GetHeuristicCost(int index, int goalIndex) const
+	{
+		const int landmarkCount = static_cast<int>(landmarks_.size());
+		const uint16_t* cellDistances = &distances_[static_cast<size_t>(index) * landmarkCount];
+		const uint16_t* goalDistances = &distances_[static_cast<size_t>(goalIndex) * landmarkCount];
+		float hCost = 0.0f;
+		for (int i = 0; i < landmarkCount; ++i)
+		{
+			if (cellDistances[i] == UNREACHABLE || goalDistances[i] == UNREACHABLE)
+			{
+				continue;
+			}
+			// 두 값의 반올림 오차 합이 최대 한 단위이므로 한 단위를 뺀다.
+			const int difference = std::abs(cellDistances[i] - goalDistances[i]) - 1;
+			hCost = std::max(hCost, static_cast<float>(difference) * scales_[i]);
+		}
+		return hCost;
+	}
+
+	size_t GetMemoryUsage() const;
+
+private:
+	static constexpr uint16_t UNREACHABLE = 0xFFFF;
+
+	std::vector<int> landmarks_;
+	// 셀 우선 배치([셀][랜드마크])라 휴리스틱 한 번에 두 셀의 연속된 값만 읽는다.
+	std::vector<uint16_t> distances_;
+	// 랜드마크별 양자화 단위
+	std::vector<float> scales_;
+	int cellCount_ = 0;
+};
@@ -0,0 +1,283 @@
+#include "MapFile.h"
+
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MapFile::~MapFile()
+{
+	Close();
+}
+
+MapFile::MapFile(MapFile&& other) noexcept
+{
+	*this = std::move(other);
+}
+
+MapFile& MapFile::operator=(MapFile&& other) noexcept
+{
+	if (this != &other)
+	{
+		Close();
+		// 맵된 주소는 그대로이므로 Grid도 같은 메모리를 계속 가리킨다.
+		data_ = std::exchange(other.data_, nullptr);
+		size_ = std::exchange(other.size_, 0);
+#ifdef _WIN32
+		fileHandle_ = std::exchange(other.fileHandle_, nullptr);
+		mappingHandle_ = std::exchange(other.mappingHandle_, nullptr);
+#endif
+		header_ = other.header_;
+		grid_ = std::move(other.grid_);
+		error_ = std::move(other.error_);
+	}
+	return *this;
+}
+
+bool MapFile::Open(const std::string& path)
+{
+	Close();
+	if (!Map(path))
+	{
+		return false;
+	}
+	if (!Validate())
+	{
+		Close();
+		return false;
+	}
+
+	uint64_t* words = reinterpret_cast<uint64_t*>(static_cast<char*>(data_) + header_.WalkableOffset);
+	grid_.AttachExternalBits(words, header_.RowCount, header_.ColumnCount);
+	if (header_.Flags & MapFileHeader::FLAG_TILE_COSTS)
+	{
+		grid_.AttachExternalTileCosts(reinterpret_cast<float*>(static_cast<char*>(data_) + header_.TileCostOffset));
+	}
+	error_.clear();
+	return true;
+}
+
+void MapFile::Close()
+{
+	grid_ = Grid();
+	header_ = {};
+#ifdef _WIN32
+	if (data_)
+	{
+		UnmapViewOfFile(data_);
+	}
+	if (mappingHandle_)
+	{
+		CloseHandle(mappingHandle_);
+	}
+	if (fileHandle_)
+	{
+		CloseHandle(fileHandle_);
+	}
+	fileHandle_ = nullptr;
+	mappingHandle_ = nullptr;
+#else
+	if (data_)
+	{
+		munmap(data_, size_);
+	}
+#endif
+	data_ = nullptr;
+	size_ = 0;
+}
+
+const float* MapFile::GetTileCosts() const
+{
+	if (!data_ || !(header_.Flags & MapFileHeader::FLAG_TILE_COSTS))
+	{
+		return nullptr;
+	}
+	return reinterpret_cast<const float*>(static_cast<const char*>(data_) + header_.TileCostOffset);
+}
+
+bool MapFile::Save(const std::string& path, const Grid& grid, const GridPosition& start, const GridPosition& end)
+{
+	const float* tileCosts = grid.GetTileCosts();
+	const size_t wordCount = Grid::GetWordCount(grid.GetRowCount(), grid.GetColumnCount());
+
+	MapFileHeader header = {};
+	std::memcpy(header.Magic, MapFileHeader::MAGIC, sizeof(header.Magic));
+	header.Version = MapFileHeader::VERSION;
+	header.ByteOrderMark = MapFileHeader::BYTE_ORDER_MARK;
+	header.Flags = tileCosts ? MapFileHeader::FLAG_TILE_COSTS : 0;
+	header.RowCount = grid.GetRowCount();
+	header.ColumnCount = grid.GetColumnCount();
+	header.StartRow = start.Row;
+	header.StartColumn = start.Column;
+	header.EndRow = end.Row;
+	header.EndColumn = end.Column;
+	header.WalkableOffset = sizeof(MapFileHeader);
+	header.TileCostOffset = tileCosts ? header.WalkableOffset + wordCount * sizeof(uint64_t) : 0;
+
+	std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+	stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	stream.write(reinterpret_cast<const char*>(grid.GetWords()), wordCount * sizeof(uint64_t));
+	if (tileCosts)
+	{
+		stream.write(reinterpret_cast<const char*>(tileCosts), grid.GetCellCount() * sizeof(float));
+	}
+	return static_cast<bool>(stream);
+}
+
+bool MapFile::Map(const std::string& path)
+{
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+							  FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		error_ = "cannot open " + path;
+		return false;
+	}
+	fileHandle_ = file;
+
+	LARGE_INTEGER fileSize = {};
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+	{
+		error_ = "cannot read the size of " + path;
+		Close();
+		return false;
+	}
+	size_ = static_cast<size_t>(fileSize.QuadPart);
+
+	// PAGE_WRITECOPY: 쓰기는 프로세스 안의 사본에만 반영된다.
+	mappingHandle_ = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+	data_ = mappingHandle_ ? MapViewOfFile(mappingHandle_, FILE_MAP_COPY, 0, 0, 0) : nullptr;
+	if (!data_)
+	{
+		error_ = "cannot map " + path;
+		Close();
+		return false;
+	}
+#else
+	const int file = open(path.c_str(), O_RDONLY);
+	if (file < 0)
+	{
+		error_ = "cannot open " + path;
+		return false;
+	}
+
+	struct stat fileStatus = {};
+	if (fstat(file, &fileStatus) != 0 || fileStatus.st_size == 0)
+	{
+		error_ = "cannot read the size of " + path;
+		close(file);
+		return false;
+	}
+	size_ = static_cast<size_t>(fileStatus.st_size);
+
+	// MAP_PRIVATE: 쓰기는 프로세스 안의 사본에만 반영된다. 맵을 만든 뒤에는 파일을 닫아도 된다.
+	void* data = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+	close(file);
+	if (data == MAP_FAILED)
+	{
+		error_ = "cannot map " + path;
+		size_ = 0;
+		return false;
+	}
+	data_ = data;
+#endif
+	return true;
+}
+
+bool MapFile::Validate()
+{
+	if (size_ < sizeof(MapFileHeader))
+	{
+		error_ = "file is smaller than the header";
+		return false;
+	}
+	std::memcpy(&header_, data_, sizeof(MapFileHeader));
+
+	if (std::memcmp(header_.Magic, MapFileHeader::MAGIC, sizeof(header_.Magic)) != 0)
+	{
+		error_ = "not a map file";
+		return false;
+	}
+	if (header_.ByteOrderMark != MapFileHeader::BYTE_ORDER_MARK)
+	{
+		error_ = "map file byte order does not match this machine";
+		return false;
+	}
+	if (header_.Version != MapFileHeader::VERSION)
+	{
+		error_ = "unsupported map file version " + std::to_string(header_.Version);
+		return false;
+	}
+	if (header_.RowCount <= 0 || header_.ColumnCount <= 0
+		|| static_cast<int64_t>(header_.RowCount) * header_.ColumnCount > INT_MAX)
+	{
+		error_ = "invalid map dimensions";
+		return false;
+	}
+
+	const uint64_t cellCount = static_cast<uint64_t>(header_.RowCount) * header_.ColumnCount;
+	const uint64_t wordBytes = Grid::GetWordCount(header_.RowCount, header_.ColumnCount) * sizeof(uint64_t);
+	if (header_.WalkableOffset % alignof(uint64_t) != 0 || header_.WalkableOffset > size_
+		|| wordBytes > size_ - header_.WalkableOffset)
+	{
+		error_ = "walkable bits are out of the file";
+		return false;
+	}
+	// Grid는 마지막 워드의 남는 비트를 벽으로 가정한다.
+	const uint64_t* words = reinterpret_cast<const uint64_t*>(static_cast<const char*>(data_) + header_.WalkableOffset);
+	const size_t lastWord = Grid::GetWordCount(header_.RowCount, header_.ColumnCount) - 1;
+	if (cellCount % 64 != 0 && (words[lastWord] >> (cellCount % 64)) != 0)
+	{
+		error_ = "padding bits of the last word must be zero";
+		return false;
+	}
+	if (header_.Flags & MapFileHeader::FLAG_TILE_COSTS)
+	{
+		const uint64_t costBytes = cellCount * sizeof(float);
+		if (header_.TileCostOffset % alignof(float) != 0 || header_.TileCostOffset > size_
+			|| costBytes > size_ - header_.TileCostOffset)
+		{
+			error_ = "tile costs are out of the file";
+			return false;
+		}
+		// 휴리스틱이 실제 비용을 넘지 않고 Open List 순서가 성립하려면 모든 셀 비용이 1 이상의 유한한 값이어야 한다.
+		// 비용 레이어가 있는 파일만 모든 값을 읽으므로 그만큼 열기가 느려진다.
+		const float* costs = reinterpret_cast<const float*>(static_cast<const char*>(data_) + header_.TileCostOffset);
+		for (uint64_t i = 0; i < cellCount; ++i)
+		{
+			if (!std::isfinite(costs[i]) || costs[i] < PathfindingConfig::ORTHOGONAL_COST)
+			{
+				error_ = "tile cost of cell " + std::to_string(i) + " must be a finite value of at least 1";
+				return false;
+			}
+		}
+	}
+
+	const bool bStartInBounds = header_.StartRow >= 0 && header_.StartRow < header_.RowCount
+								&& header_.StartColumn >= 0 && header_.StartColumn < header_.ColumnCount;
+	const bool bEndInBounds = header_.EndRow >= 0 && header_.EndRow < header_.RowCount && header_.EndColumn >= 0
+							  && header_.EndColumn < header_.ColumnCount;
+	if (!bStartInBounds || !bEndInBounds)
+	{
+		error_ = "start or end is out of the map";
+		return false;
+	}
+	return true;
+}
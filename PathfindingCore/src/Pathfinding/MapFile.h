@@ -0,0 +1,81 @@
+#pragma once
+#include "Pathfinding/Grid.h"
+#include "Pathfinding/PathResult.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// 디스크의 맵 파일(.pfmap)을 메모리에 맵하고, 파싱이나 복사 없이 그 비트를 그대로 Grid로 탐색한다.
+//
+// 파일 구성 (리틀 엔디언)
+//   MapFileHeader (64바이트)
+//   통과 가능 비트: Grid와 같은 배치의 uint64_t 워드 GetWordCount(rows, columns)개. 남는 비트는 0.
+//   타일 비용 (선택): 셀마다 1 이상의 유한한 float 하나. row * columns + column 순서. Grid의 셀 비용 레이어가 된다.
+//   Open은 범위를 벗어난 값이 하나라도 있으면 파일을 거절한다.
+struct MapFileHeader
+{
+	static constexpr char MAGIC[8] = {'P', 'F', 'M', 'A', 'P', '\0', '\0', '\0'};
+	static constexpr uint32_t VERSION = 1;
+	static constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+	static constexpr uint32_t FLAG_TILE_COSTS = 1u << 0;
+
+	char Magic[8];
+	uint32_t Version;
+	uint32_t ByteOrderMark;
+	uint32_t Flags;
+	int32_t RowCount;
+	int32_t ColumnCount;
+	int32_t StartRow;
+	int32_t StartColumn;
+	int32_t EndRow;
+	int32_t EndColumn;
+	uint32_t Reserved;
+	uint64_t WalkableOffset;
+	uint64_t TileCostOffset;
+};
+static_assert(sizeof(MapFileHeader) == 64);
+
+class MapFile
+{
+public:
+	MapFile() = default;
+	~MapFile();
+	MapFile(const MapFile&) = delete;
+	MapFile& operator=(const MapFile&) = delete;
+	MapFile(MapFile&& other) noexcept;
+	MapFile& operator=(MapFile&& other) noexcept;
+
+	// 실패하면 false를 반환하고 GetError로 이유를 알려준다.
+	bool Open(const std::string& path);
+	void Close();
+	bool IsOpen() const { return data_ != nullptr; }
+	const std::string& GetError() const { return error_; }
+
+	// 맵된 메모리를 가리키는 Grid. 비용 레이어가 있으면 Grid의 셀 비용도 파일을 가리킨다.
+	// 페이지는 copy-on-write로 맵되므로 SetTileType은 이 프로세스에만 보이고
+	// 파일에는 쓰이지 않는다. MapFile이 닫히면 더 이상 쓸 수 없다.
+	Grid& GetGrid() { return grid_; }
+	const Grid& GetGrid() const { return grid_; }
+	GridPosition GetStart() const { return {header_.StartRow, header_.StartColumn}; }
+	GridPosition GetEnd() const { return {header_.EndRow, header_.EndColumn}; }
+	// 비용 레이어가 없으면 nullptr
+	const float* GetTileCosts() const;
+
+	// Grid에 셀 비용 레이어가 있으면 함께 저장한다.
+	static bool Save(const std::string& path, const Grid& grid, const GridPosition& start, const GridPosition& end);
+
+private:
+	bool Map(const std::string& path);
+	bool Validate();
+
+	void* data_ = nullptr;
+	size_t size_ = 0;
+#ifdef _WIN32
+	void* fileHandle_ = nullptr;
+	void* mappingHandle_ = nullptr;
+#endif
+	MapFileHeader header_ = {};
+	Grid grid_;
+	std::string error_;
+};
@@ -0,0 +1,108 @@
+#include "MovingAIFormat.h"
+
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+	bool IsPassable(char tile)
+	{
+		return tile == '.' || tile == 'G' || tile == 'S';
+	}
+} // namespace
+
+bool LoadMovingAIMap(const std::string& path, Grid& grid, std::string& error)
+{
+	std::ifstream stream(path, std::ios::binary);
+	if (!stream)
+	{
+		error = "cannot open " + path;
+		return false;
+	}
+
+	int height = 0;
+	int width = 0;
+	for (std::string key; stream >> key && key != "map";)
+	{
+		if (key == "height")
+		{
+			stream >> height;
+		}
+		else if (key == "width")
+		{
+			stream >> width;
+		}
+		else if (key == "type")
+		{
+			stream >> key;
+		}
+		else
+		{
+			error = "unexpected header field " + key;
+			return false;
+		}
+	}
+	if (height <= 0 || width <= 0 || static_cast<long long>(height) * width > INT32_MAX)
+	{
+		error = "invalid map dimensions";
+		return false;
+	}
+
+	grid.Resize(height, width);
+	std::string line;
+	std::getline(stream, line);
+	for (int row = 0; row < height; ++row)
+	{
+		if (!std::getline(stream, line) || static_cast<int>(line.size()) < width)
+		{
+			error = "map has fewer rows or columns than its header";
+			return false;
+		}
+		for (int column = 0; column < width; ++column)
+		{
+			if (!IsPassable(line[column]))
+			{
+				grid.SetTileType(row, column, ETileType::Wall);
+			}
+		}
+	}
+	return true;
+}
+
+bool LoadMovingAIScenario(const std::string& path, std::vector<MovingAIScenarioEntry>& entries, std::string& error)
+{
+	std::ifstream stream(path);
+	if (!stream)
+	{
+		error = "cannot open " + path;
+		return false;
+	}
+
+	std::string line;
+	if (!std::getline(stream, line) || line.rfind("version", 0) != 0)
+	{
+		error = "missing version line";
+		return false;
+	}
+
+	entries.clear();
+	while (std::getline(stream, line))
+	{
+		if (line.empty() || line == "\r")
+		{
+			continue;
+		}
+
+		std::istringstream fields(line);
+		MovingAIScenarioEntry entry;
+		if (!(fields >> entry.Bucket >> entry.MapName >> entry.MapWidth >> entry.MapHeight >> entry.Start.Column
+			  >> entry.Start.Row >> entry.End.Column >> entry.End.Row >> entry.OptimalLength))
+		{
+			error = "malformed scenario line: " + line;
+			return false;
+		}
+		entries.push_back(entry);
+	}
+	return true;
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include "Pathfinding/Grid.h"
+#include "Pathfinding/PathResult.h"
+
+#include <string>
+#include <vector>
+
+// MovingAI 벤치마크(https://movingai.com/benchmarks/formats.html)의 .map/.scen 형식.
+// .map의 '.', 'G', 'S'는 통과 가능, 나머지('@', 'O', 'T', 'W')는 벽으로 읽는다.
+// .scen의 좌표는 (x, y) = (column, row)이며, 최적 거리는 대각선 √2, 코너 컷팅 금지 기준이다.
+struct MovingAIScenarioEntry
+{
+	int Bucket = 0;
+	std::string MapName;
+	int MapWidth = 0;
+	int MapHeight = 0;
+	GridPosition Start;
+	GridPosition End;
+	double OptimalLength = 0.0;
+};
+
+// 실패하면 false를 반환하고 error에 이유를 남긴다.
+bool LoadMovingAIMap(const std::string& path, Grid& grid, std::string& error);
+bool LoadMovingAIScenario(const std::string& path, std::vector<MovingAIScenarioEntry>& entries, std::string& error);
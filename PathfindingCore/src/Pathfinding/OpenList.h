@@ -0,0 +1,323 @@
+#pragma once
+#include "Pathfinding/Profiling.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+struct OpenNode
+{
+	float FCost;
+	float HCost;
+	int Index;
+
+	// F가 같으면 목표에 더 가까운(H가 작은) 노드를 먼저 꺼낸다.
+	bool IsBetterThan(const OpenNode& other) const
+	{
+		if (FCost == other.FCost)
+		{
+			return HCost < other.HCost;
+		}
+		return FCost < other.FCost;
+	}
+};
+
+// 모든 Open List는 같은 인터페이스를 가진다.
+//   Resize(cellCount), Clear(), IsEmpty(), GetSize(), Top(), Pop(), Push(node), Update(node), ForEach(func),
+//   GetMemoryUsage()
+// Update는 이미 Open List에 있는 셀의 비용이 줄었을 때 호출한다.
+
+// 셀마다 힙 안의 위치를 기록해 Update를 제자리에서 처리하는 d-ary 힙.
+template <int Arity>
+class IndexedHeap
+{
+public:
+	void Resize(int cellCount) { positions_.resize(cellCount); }
+	void Clear() { nodes_.clear(); }
+
+	bool IsEmpty() const { return nodes_.empty(); }
+	size_t GetSize() const { return nodes_.size(); }
+	const OpenNode& Top() const { return nodes_.front(); }
+	size_t GetMemoryUsage() const
+	{
+		return nodes_.capacity() * sizeof(OpenNode) + positions_.capacity() * sizeof(int);
+	}
+
+	OpenNode Pop()
+	{
+		PATHFINDING_HOT_ZONE("OpenList::Pop");
+		const OpenNode top = nodes_.front();
+		const OpenNode last = nodes_.back();
+		nodes_.pop_back();
+		if (!nodes_.empty())
+		{
+			SiftDown(0, last);
+		}
+		return top;
+	}
+
+	void Push(const OpenNode& node)
+	{
+		PATHFINDING_HOT_ZONE("OpenList::Push");
+		nodes_.push_back(node);
+		SiftUp(nodes_.size() - 1, node);
+	}
+
+	void Update(const OpenNode& node)
+	{
+		PATHFINDING_HOT_ZONE("OpenList::Update");
+		SiftUp(positions_[node.Index], node);
+	}
+
+	// 아래 두 함수는 IndexedHeap에만 있다. 키가 커질 수도 있는 탐색(D* Lite)에서 쓴다.
+	bool Contains(int index) const
+	{
+		const size_t position = positions_[index];
+		return position < nodes_.size() && nodes_[position].Index == index;
+	}
+	void Remove(int index)
+	{
+		const size_t position = positions_[index];
+		const OpenNode last = nodes_.back();
+		nodes_.pop_back();
+		if (position == nodes_.size())
+		{
+			return;
+		}
+		if (position > 0 && last.IsBetterThan(nodes_[(position - 1) / Arity]))
+		{
+			SiftUp(position, last);
+		}
+		else
+		{
+			SiftDown(position, last);
+		}
+	}
+
+	template <typename Func>
+	void ForEach(Func&& func) const
+	{
+		for (const OpenNode& node : nodes_)
+		{
+			func(node);
+		}
+	}
+
+private:
+	void SiftUp(size_t position, const OpenNode& node)
+	{
+		while (position > 0)
+		{
+			const size_t parent = (position - 1) / Arity;
+			if (!node.IsBetterThan(nodes_[parent]))
+			{
+				break;
+			}
+			Place(position, nodes_[parent]);
+			position = parent;
+		}
+		Place(position, node);
+	}
+
+	void SiftDown(size_t position, const OpenNode& node)
+	{
+		const size_t size = nodes_.size();
+		while (true)
+		{
+			const size_t firstChild = position * Arity + 1;
+			if (firstChild >= size)
+			{
+				break;
+			}
+			const size_t lastChild = std::min(firstChild + Arity, size);
+			size_t bestChild = firstChild;
+			for (size_t child = firstChild + 1; child < lastChild; ++child)
+			{
+				if (nodes_[child].IsBetterThan(nodes_[bestChild]))
+				{
+					bestChild = child;
+				}
+			}
+			if (!nodes_[bestChild].IsBetterThan(node))
+			{
+				break;
+			}
+			Place(position, nodes_[bestChild]);
+			position = bestChild;
+		}
+		Place(position, node);
+	}
+
+	void Place(size_t position, const OpenNode& node)
+	{
+		nodes_[position] = node;
+		positions_[node.Index] = static_cast<int>(position);
+	}
+
+	std::vector<OpenNode> nodes_;
+	std::vector<int> positions_;
+};
+
+using BinaryHeap = IndexedHeap<2>;
+using QuaternaryHeap = IndexedHeap<4>;
+
+// F가 정수일 때(4방향, 단위 비용, Manhattan)만 쓸 수 있는 버킷 큐.
+// Push/Update/Pop이 모두 O(1)이며, 같은 버킷 안에서는 나중에 들어온 노드를 먼저 꺼낸다.
+class BucketQueue
+{
+public:
+	void Resize(int cellCount)
+	{
+		positions_.resize(cellCount);
+		keys_.resize(cellCount);
+	}
+
+	void Clear()
+	{
+		for (std::vector<OpenNode>& bucket : buckets_)
+		{
+			bucket.clear();
+		}
+		size_ = 0;
+		minKey_ = 0;
+	}
+
+	bool IsEmpty() const { return size_ == 0; }
+	size_t GetSize() const { return size_; }
+	const OpenNode& Top() const { return buckets_[minKey_].back(); }
+	size_t GetMemoryUsage() const
+	{
+		size_t bytes = buckets_.capacity() * sizeof(std::vector<OpenNode>)
+					   + (positions_.capacity() + keys_.capacity()) * sizeof(int);
+		for (const std::vector<OpenNode>& bucket : buckets_)
+		{
+			bytes += bucket.capacity() * sizeof(OpenNode);
+		}
+		return bytes;
+	}
+
+	OpenNode Pop()
+	{
+		PATHFINDING_HOT_ZONE("OpenList::Pop");
+		std::vector<OpenNode>& bucket = buckets_[minKey_];
+		const OpenNode top = bucket.back();
+		bucket.pop_back();
+		--size_;
+		SkipEmptyBuckets();
+		return top;
+	}
+
+	void Push(const OpenNode& node)
+	{
+		PATHFINDING_HOT_ZONE("OpenList::Push");
+		const int key = static_cast<int>(std::lround(node.FCost));
+		if (key >= static_cast<int>(buckets_.size()))
+		{
+			buckets_.resize(key + 1);
+		}
+		std::vector<OpenNode>& bucket = buckets_[key];
+		positions_[node.Index] = static_cast<int>(bucket.size());
+		keys_[node.Index] = key;
+		bucket.push_back(node);
+		if (size_ == 0 || key < minKey_)
+		{
+			minKey_ = key;
+		}
+		++size_;
+	}
+
+	void Update(const OpenNode& node)
+	{
+		PATHFINDING_HOT_ZONE("OpenList::Update");
+		Remove(node.Index);
+		Push(node);
+	}
+
+	template <typename Func>
+	void ForEach(Func&& func) const
+	{
+		for (size_t key = minKey_; key < buckets_.size(); ++key)
+		{
+			for (const OpenNode& node : buckets_[key])
+			{
+				func(node);
+			}
+		}
+	}
+
+private:
+	void Remove(int index)
+	{
+		std::vector<OpenNode>& bucket = buckets_[keys_[index]];
+		const int position = positions_[index];
+		bucket[position] = bucket.back();
+		positions_[bucket[position].Index] = position;
+		bucket.pop_back();
+		--size_;
+		SkipEmptyBuckets();
+	}
+
+	void SkipEmptyBuckets()
+	{
+		while (size_ > 0 && buckets_[minKey_].empty())
+		{
+			++minKey_;
+		}
+	}
+
+	std::vector<std::vector<OpenNode>> buckets_;
+	std::vector<int> positions_;
+	std::vector<int> keys_;
+	size_t size_ = 0;
+	int minKey_ = 0;
+};
+
+// 기존 방식: 비용이 줄면 중복으로 다시 넣고, 꺼낼 때 이미 Closed인 항목은 탐색 쪽에서 건너뛴다.
+// 비교용으로 남겨둔다.
+class PriorityQueue
+{
+public:
+	void Resize(int) {}
+	void Clear() { nodes_.clear(); }
+
+	bool IsEmpty() const { return nodes_.empty(); }
+	size_t GetSize() const { return nodes_.size(); }
+	const OpenNode& Top() const { return nodes_.front(); }
+	size_t GetMemoryUsage() const { return nodes_.capacity() * sizeof(OpenNode); }
+
+	OpenNode Pop()
+	{
+		PATHFINDING_HOT_ZONE("OpenList::Pop");
+		std::pop_heap(nodes_.begin(), nodes_.end(), Comparator());
+		const OpenNode top = nodes_.back();
+		nodes_.pop_back();
+		return top;
+	}
+
+	void Push(const OpenNode& node)
+	{
+		PATHFINDING_HOT_ZONE("OpenList::Push");
+		nodes_.push_back(node);
+		std::push_heap(nodes_.begin(), nodes_.end(), Comparator());
+	}
+
+	void Update(const OpenNode& node) { Push(node); }
+
+	template <typename Func>
+	void ForEach(Func&& func) const
+	{
+		for (const OpenNode& node : nodes_)
+		{
+			func(node);
+		}
+	}
+
+private:
+	struct Comparator
+	{
+		bool operator()(const OpenNode& a, const OpenNode& b) const { return b.IsBetterThan(a); }
+	};
+
+	std::vector<OpenNode> nodes_;
+};
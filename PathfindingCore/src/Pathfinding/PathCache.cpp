@@ -0,0 +1,264 @@
+#include "PathCache.h"
+
+#include "Pathfinding/Profiling.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace
+{
+	uint64_t MixHash(uint64_t hash, uint64_t value)
+	{
+		hash ^= value + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+		return hash;
+	}
+} // namespace
+
+size_t PathCache::KeyHash::operator()(const Key& key) const
+{
+	uint64_t hash = (static_cast<uint64_t>(static_cast<uint32_t>(key.Start.Row)) << 32)
+					| static_cast<uint32_t>(key.Start.Column);
+	hash = MixHash(hash, (static_cast<uint64_t>(static_cast<uint32_t>(key.End.Row)) << 32)
+							 | static_cast<uint32_t>(key.End.Column));
+	hash = MixHash(hash, (static_cast<uint64_t>(key.Algorithm) << 8) | static_cast<uint64_t>(key.Method));
+	return static_cast<size_t>(hash);
+}
+
+PathCache::PathCache(int capacity)
+	: capacity_(std::max(1, capacity))
+{
+}
+
+bool PathCache::Find(const PathQuery& query, ESearchAlgorithm::Type algorithm, PathResult& result)
+{
+	PATHFINDING_ZONE("PathCache::Find");
+	std::lock_guard<std::mutex> lock(mutex_);
+	const auto found = index_.find({query.Start, query.End, algorithm, query.Method});
+	if (found == index_.end())
+	{
+		++counters_.Misses;
+		return false;
+	}
+	const int entryIndex = found->second;
+	Unlink(entryIndex);
+	PushFront(entryIndex);
+	result = entries_[entryIndex].Result;
+	// 탐색하지 않았으므로 확장 수나 시간 같은 탐색 비용은 남기지 않는다.
+	result.Stats = {};
+	result.Stats.PathCellCount = entries_[entryIndex].Result.Stats.PathCellCount;
+	result.Stats.PathCost = entries_[entryIndex].Result.Stats.PathCost;
+	++counters_.Hits;
+	return true;
+}
+
+void PathCache::Store(const PathQuery& query, ESearchAlgorithm::Type algorithm, const PathResult& result,
+					  uint64_t generation)
+{
+	if (result.bPartial)
+	{
+		return;
+	}
+	std::lock_guard<std::mutex> lock(mutex_);
+	if (generation != generation_)
+	{
+		++counters_.RejectedStores;
+		return;
+	}
+
+	const Key key = {query.Start, query.End, algorithm, query.Method};
+	int entryIndex = INVALID_ENTRY;
+	const auto found = index_.find(key);
+	if (found != index_.end())
+	{
+		entryIndex = found->second;
+		Unlink(entryIndex);
+	}
+	else
+	{
+		if (!freeEntries_.empty())
+		{
+			entryIndex = freeEntries_.back();
+			freeEntries_.pop_back();
+		}
+		else if (static_cast<int>(entries_.size()) < capacity_)
+		{
+			entryIndex = static_cast<int>(entries_.size());
+			entries_.emplace_back();
+		}
+		else
+		{
+			// 가장 오래 쓰지 않은 항목의 자리와 버퍼를 그대로 쓴다.
+			entryIndex = tail_;
+			Unlink(entryIndex);
+			index_.erase(entries_[entryIndex].EntryKey);
+			++counters_.Evictions;
+		}
+		index_.emplace(key, entryIndex);
+	}
+
+	Entry& entry = entries_[entryIndex];
+	entry.EntryKey = key;
+	entry.Result = result;
+	const std::vector<GridPosition>& cells = result.Cells.empty() ? result.Waypoints : result.Cells;
+	entry.MinRow = entry.MinColumn = 0;
+	entry.MaxRow = entry.MaxColumn = -1;
+	if (!cells.empty())
+	{
+		entry.MinRow = entry.MaxRow = cells.front().Row;
+		entry.MinColumn = entry.MaxColumn = cells.front().Column;
+		for (const GridPosition& cell : cells)
+		{
+			entry.MinRow = std::min(entry.MinRow, cell.Row);
+			entry.MaxRow = std::max(entry.MaxRow, cell.Row);
+			entry.MinColumn = std::min(entry.MinColumn, cell.Column);
+			entry.MaxColumn = std::max(entry.MaxColumn, cell.Column);
+		}
+	}
+	PushFront(entryIndex);
+}
+
+uint64_t PathCache::GetGeneration() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return generation_;
+}
+
+void PathCache::OnTileChanged(int row, int column, float oldCost, float newCost)
+{
+	PATHFINDING_ZONE("PathCache::OnTileChanged");
+	if (oldCost == newCost)
+	{
+		return;
+	}
+	if (newCost < oldCost)
+	{
+		InvalidateAll();
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(mutex_);
+	++generation_;
+	for (int entryIndex = head_; entryIndex != INVALID_ENTRY;)
+	{
+		const Entry& entry = entries_[entryIndex];
+		const int next = entry.Next;
+		if (IsNearPath(entry, row, column))
+		{
+			Remove(entryIndex);
+			++counters_.Invalidations;
+		}
+		entryIndex = next;
+	}
+}
+
+void PathCache::InvalidateAll()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	++generation_;
+	counters_.Invalidations += index_.size();
+	// 경로 버퍼는 다음 Store가 재사용하도록 남겨 둔다.
+	while (head_ != INVALID_ENTRY)
+	{
+		Remove(head_);
+	}
+}
+
+PathCacheCounters PathCache::GetCounters() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	PathCacheCounters counters = counters_;
+	counters.EntryCount = index_.size();
+	return counters;
+}
+
+void PathCache::ResetCounters()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	counters_ = {};
+}
+
+size_t PathCache::GetMemoryUsage() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	size_t bytes = entries_.capacity() * sizeof(Entry) + freeEntries_.capacity() * sizeof(int)
+				   + index_.size() * (sizeof(Key) + sizeof(int) + 2 * sizeof(void*))
+				   + index_.bucket_count() * sizeof(void*);
+	for (const Entry& entry : entries_)
+	{
+		bytes += (entry.Result.Cells.capacity() + entry.Result.Waypoints.capacity()) * sizeof(GridPosition);
+	}
+	return bytes;
+}
+
+bool PathCache::IsNearPath(const Entry& entry, int row, int column)
+{
+	// 경로가 없던 쿼리는 타일이 막혀도 여전히 경로가 없다.
+	if (entry.MaxRow < entry.MinRow)
+	{
+		return false;
+	}
+	if (row < entry.MinRow - 1 || row > entry.MaxRow + 1 || column < entry.MinColumn - 1
+		|| column > entry.MaxColumn + 1)
+	{
+		return false;
+	}
+	// 셀 없이 웨이포인트만 있으면 점 사이의 칸을 모르므로 사각형 안이면 지난다고 본다.
+	if (entry.Result.Cells.empty())
+	{
+		return true;
+	}
+	for (const GridPosition& cell : entry.Result.Cells)
+	{
+		if (std::abs(cell.Row - row) <= 1 && std::abs(cell.Column - column) <= 1)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void PathCache::Remove(int entryIndex)
+{
+	Unlink(entryIndex);
+	index_.erase(entries_[entryIndex].EntryKey);
+	freeEntries_.push_back(entryIndex);
+}
+
+void PathCache::Unlink(int entryIndex)
+{
+	Entry& entry = entries_[entryIndex];
+	if (entry.Previous != INVALID_ENTRY)
+	{
+		entries_[entry.Previous].Next = entry.Next;
+	}
+	else
+	{
+		head_ = entry.Next;
+	}
+	if (entry.Next != INVALID_ENTRY)
+	{
+		entries_[entry.Next].Previous = entry.Previous;
+	}
+	else
+	{
+		tail_ = entry.Previous;
+	}
+	entry.Previous = INVALID_ENTRY;
+	entry.Next = INVALID_ENTRY;
+}
+
+void PathCache::PushFront(int entryIndex)
+{
+	Entry& entry = entries_[entryIndex];
+	entry.Previous = INVALID_ENTRY;
+	entry.Next = head_;
+	if (head_ != INVALID_ENTRY)
+	{
+		entries_[head_].Previous = entryIndex;
+	}
+	head_ = entryIndex;
+	if (tail_ == INVALID_ENTRY)
+	{
+		tail_ = entryIndex;
+	}
+}
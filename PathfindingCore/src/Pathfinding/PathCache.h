@@ -0,0 +1,104 @@
+#pragma once
+#include "Pathfinding/PathResult.h"
+#include "Pathfinding/PathfindingTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+struct PathCacheCounters
+{
+	uint64_t Hits = 0;
+	uint64_t Misses = 0;
+	// 가득 차서 가장 오래 쓰지 않은 항목을 버린 횟수
+	uint64_t Evictions = 0;
+	// 맵이 바뀌어 버린 항목 수
+	uint64_t Invalidations = 0;
+	// 그 사이에 맵이 바뀌어 저장하지 않은 결과 수
+	uint64_t RejectedStores = 0;
+	size_t EntryCount = 0;
+};
+
+// 끝난 탐색 결과를 (시작, 도착, 알고리즘, 휴리스틱)으로 기억해 같은 쿼리를 탐색 없이 돌려준다.
+// 가득 차면 가장 오래 쓰지 않은 항목부터 버린다(LRU). 모든 함수는 내부 뮤텍스를 잡으므로 여러 스레드에서 부른다.
+//
+// 맵이 바뀌면 호출한 쪽이 OnTileChanged를 부른다. 타일이 막히거나 비싸지면 그 타일을 지나거나 바로 옆을 지나는
+// 경로만 버린다(대각선 이동과 직선 시야는 옆 칸에도 영향을 받는다). 다른 경로는 더 길어질 수 없으므로 그대로 최적이다.
+// 타일이 열리거나 싸지면 어느 쿼리든 더 짧은 경로가 생길 수 있으므로 모든 항목을 버린다.
+// 셀 비용 레이어가 새로 생기면 JPS와 Theta*가 A*로 바뀌므로(AStarSearch::Reset) 호출한 쪽이 InvalidateAll을 부른다.
+// 맵 세대(GetGeneration)는 맵이 바뀔 때마다 올라가며, 탐색 중에 맵이 바뀐 결과가 들어오지 않게 막는다.
+//
+// 캐시는 설정이 같은 탐색끼리 공유한다. 웨이포인트를 만드는지, 코너 컷팅 규칙 같은 설정은 키에 없다.
+class PathCache
+{
+public:
+	static constexpr int DEFAULT_CAPACITY = 4096;
+
+	explicit PathCache(int capacity = DEFAULT_CAPACITY);
+
+	// 있으면 result에 복사하고 true. result의 기존 용량을 재사용하고, Stats에는 경로 항목만 남긴다.
+	bool Find(const PathQuery& query, ESearchAlgorithm::Type algorithm, PathResult& result);
+	// 탐색을 시작하기 전에 GetGeneration으로 받아 둔 값을 넘긴다. 그 사이에 맵이 바뀌었으면 저장하지 않는다.
+	// 부분 경로는 저장하지 않는다.
+	void Store(const PathQuery& query, ESearchAlgorithm::Type algorithm, const PathResult& result,
+			   uint64_t generation);
+	// OnTileChanged와 InvalidateAll마다 올라간다.
+	uint64_t GetGeneration() const;
+
+	// 셀 비용이 oldCost에서 newCost로 바뀌었다. 벽은 PathfindingConfig::IMPASSABLE_COST이다.
+	void OnTileChanged(int row, int column, float oldCost, float newCost);
+	// 맵을 새로 만들거나 불러온 경우
+	void InvalidateAll();
+
+	PathCacheCounters GetCounters() const;
+	void ResetCounters();
+	size_t GetMemoryUsage() const;
+
+private:
+	static constexpr int INVALID_ENTRY = -1;
+
+	struct Key
+	{
+		GridPosition Start;
+		GridPosition End;
+		ESearchAlgorithm::Type Algorithm = ESearchAlgorithm::AStar;
+		EHeuristicMethod::Type Method = EHeuristicMethod::None;
+
+		bool operator==(const Key& other) const = default;
+	};
+	struct KeyHash
+	{
+		size_t operator()(const Key& key) const;
+	};
+
+	struct Entry
+	{
+		Key EntryKey;
+		PathResult Result;
+		// 경로 셀을 모두 담는 사각형. 타일 변경마다 셀을 다 훑지 않도록 먼저 이것으로 거른다.
+		int MinRow = 0;
+		int MinColumn = 0;
+		int MaxRow = -1;
+		int MaxColumn = -1;
+		// LRU 목록. head_가 가장 최근에 쓴 항목이다.
+		int Previous = INVALID_ENTRY;
+		int Next = INVALID_ENTRY;
+	};
+
+	static bool IsNearPath(const Entry& entry, int row, int column);
+	void Remove(int entryIndex);
+	void Unlink(int entryIndex);
+	void PushFront(int entryIndex);
+
+	mutable std::mutex mutex_;
+	int capacity_ = DEFAULT_CAPACITY;
+	uint64_t generation_ = 0;
+	std::vector<Entry> entries_;
+	std::vector<int> freeEntries_;
+	std::unordered_map<Key, int, KeyHash> index_;
+	int head_ = INVALID_ENTRY;
+	int tail_ = INVALID_ENTRY;
+	PathCacheCounters counters_;
+};
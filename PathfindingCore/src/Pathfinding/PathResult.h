@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Pathfinding/PathfindingTypes.h"
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+struct GridPosition
+{
+	int Row = 0;
+	int Column = 0;
+
+	bool operator==(const GridPosition& other) const = default;
+};
+
+struct PathQuery
+{
+	GridPosition Start;
+	GridPosition End;
+	EHeuristicMethod::Type Method = EHeuristicMethod::Octile;
+};
+
+// 탐색 한 번에 든 비용. Reset에서 초기화되고, BuildPath가 경로 항목을 채워 PathResult::Stats에 담는다.
+struct SearchStats
+{
+	int NodesExpanded = 0;
+	// Open List에 새로 넣거나 비용을 낮춘 이웃의 수
+	int NodesGenerated = 0;
+	// 확장했던 셀을 다시 연 횟수. ALT의 재오픈과 D* Lite에서 비용이 늘어 다시 계산한 셀이 해당한다.
+	int ReopenedCount = 0;
+	size_t PeakOpenListSize = 0;
+	// 이미 Open List에 넣었던 셀을 새 항목으로 다시 넣은 횟수. PriorityQueue의 갱신과 ALT의 재오픈이 해당한다.
+	// 인덱스 힙과 버킷 큐의 갱신은 제자리에서 하므로 세지 않는다.
+	int DuplicatePushCount = 0;
+	// 경로의 셀 수와 비용. 경로가 없으면 0이다.
+	int PathCellCount = 0;
+	float PathCost = 0.0f;
+	// Advance와 Run 안에서 탐색에 쓴 시간. Step으로 진행한 시간은 호출한 쪽이 잰다.
+	std::chrono::nanoseconds ElapsedTime{0};
+	// 탐색 상태 배열과 Open List가 차지한 바이트
+	size_t ScratchBytes = 0;
+};
+
+struct PathResult
+{
+	bool bFound = false;
+	// 탐색이 끝나기 전에 만든 경로. Cells는 시작 셀에서 지금까지 확장한 셀 중 도착 셀에 가장 가까운 셀까지이다.
+	bool bPartial = false;
+	float Cost = 0.0f;
+	// 시작 셀부터 도착 셀까지 순서대로. 이웃한 두 셀은 8방향으로 인접한다.
+	std::vector<GridPosition> Cells;
+	// 시작과 도착 셀을 포함한 꺾이는 점. 이웃한 두 점 사이는 시야가 트여 있다(Grid::HasLineOfSight).
+	// Theta*는 탐색 결과로 채우고, 다른 탐색은 비워 두므로 BuildWaypoints로 만든다.
+	std::vector<GridPosition> Waypoints;
+	SearchStats Stats;
+};
+
+// 한 번에 진행할 수 있는 양. 0이면 그 항목은 제한하지 않는다.
+// 시간은 노드 몇 개마다 확인하므로 그만큼 넘을 수 있다.
+struct SearchBudget
+{
+	int MaxNodes = 0;
+	std::chrono::microseconds MaxTime{0};
+};
@@ -0,0 +1,101 @@
+#include "PathSmoothing.h"
+
+#include "Pathfinding/Profiling.h"
+
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+// Cells에서 이동 방향이 바뀌는 셀과 양 끝 셀을 waypoints에 담는다.
+void CollectCorners(const std::vector<GridPosition>& cells, std::vector<GridPosition>& waypoints)
+{
+	waypoints.push_back(cells.front());
+	for (size_t i = 1; i + 1 < cells.size(); ++i)
+	{
+		const bool bSameRowStep = cells[i].Row - cells[i - 1].Row == cells[i + 1].Row - cells[i].Row;
+		const bool bSameColumnStep = cells[i].Column - cells[i - 1].Column == cells[i + 1].Column - cells[i].Column;
+		if (!bSameRowStep || !bSameColumnStep)
+		{
+			waypoints.push_back(cells[i]);
+		}
+	}
+	if (cells.size() > 1)
+	{
+		waypoints.push_back(cells.back());
+	}
+}
+} // namespace
+
+void BuildWaypoints(const Grid& grid, PathResult& result)
+{
+	PATHFINDING_ZONE("BuildWaypoints");
+	std::vector<GridPosition>& waypoints = result.Waypoints;
+	if (!result.bFound && !result.bPartial)
+	{
+		waypoints.clear();
+		return;
+	}
+	if (waypoints.empty() && !result.Cells.empty())
+	{
+		CollectCorners(result.Cells, waypoints);
+	}
+	if (grid.HasTileCosts() || waypoints.size() <= 2)
+	{
+		return;
+	}
+
+	// 기준점에서 다음 후보가 보이지 않으면 바로 앞 후보를 새 기준점으로 남긴다. 남기는 자리는 항상
+	// 읽는 자리보다 앞이므로 제자리에서 줄인다.
+	GridPosition anchor = waypoints.front();
+	size_t count = 1;
+	for (size_t i = 2; i < waypoints.size(); ++i)
+	{
+		if (!grid.HasLineOfSight(anchor.Row, anchor.Column, waypoints[i].Row, waypoints[i].Column))
+		{
+			anchor = waypoints[i - 1];
+			waypoints[count++] = anchor;
+		}
+	}
+	waypoints[count++] = waypoints.back();
+	waypoints.resize(count);
+}
+
+void AppendLineCells(const GridPosition& from, const GridPosition& to, std::vector<GridPosition>& cells)
+{
+	const int rowCount = std::abs(to.Row - from.Row);
+	const int columnCount = std::abs(to.Column - from.Column);
+	const int stepRow = to.Row > from.Row ? 1 : -1;
+	const int stepColumn = to.Column > from.Column ? 1 : -1;
+
+	// i번째 열 경계는 선분 위 (2i + 1) / (2 * columnCount) 지점, j번째 행 경계는 (2j + 1) / (2 * rowCount) 지점에
+	// 있다. 먼저 만나는 경계 쪽으로 한 칸 가고, 동시에 만나면(꼭짓점) 대각선으로 간다.
+	GridPosition position = from;
+	for (int i = 0, j = 0; i < columnCount || j < rowCount;)
+	{
+		const long long decision = (2ll * i + 1) * rowCount - (2ll * j + 1) * columnCount;
+		if (decision <= 0)
+		{
+			position.Column += stepColumn;
+			++i;
+		}
+		if (decision >= 0)
+		{
+			position.Row += stepRow;
+			++j;
+		}
+		cells.push_back(position);
+	}
+}
+
+float GetWaypointPathLength(const std::vector<GridPosition>& waypoints)
+{
+	float length = 0.0f;
+	for (size_t i = 1; i < waypoints.size(); ++i)
+	{
+		const float deltaRow = static_cast<float>(waypoints[i].Row - waypoints[i - 1].Row);
+		const float deltaColumn = static_cast<float>(waypoints[i].Column - waypoints[i - 1].Column);
+		length += std::sqrt(deltaRow * deltaRow + deltaColumn * deltaColumn);
+	}
+	return length;
+}
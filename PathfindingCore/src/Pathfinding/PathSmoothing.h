@@ -0,0 +1,24 @@
+#pragma once
+#include "Pathfinding/Grid.h"
+#include "Pathfinding/PathResult.h"
+
+#include <vector>
+
+// 경로 결과의 후처리. 탐색이 만든 셀 경로를 소비하는 쪽이 따라가기 쉬운 웨이포인트로 줄인다.
+//
+// BuildWaypoints는 꺾이는 셀만 후보로 남긴 뒤, 앞에서부터 기준점에서 보이는 동안 후보를 건너뛰는
+// 줄 당기기(string pulling)를 한다. 시야 판정은 Grid::HasLineOfSight(비트보드)이고, 두 후보 사이가
+// 직선이나 대각선으로 이어진 셀이므로 항상 바로 앞 후보는 보인다.
+
+// result.Waypoints를 채운다. 이미 채워져 있으면(Theta*) 그 점들을 다시 당긴다.
+// 셀 비용 레이어가 있으면 시야가 트여도 비용이 달라질 수 있으므로 한 직선 위의 셀만 합친다.
+// 경로가 없으면(bFound도 bPartial도 아니면) 비운다. Cells와 Cost는 바꾸지 않는다.
+void BuildWaypoints(const Grid& grid, PathResult& result);
+
+// from에서 to로 가는 선분이 닿는 셀을 from 다음부터 to까지 cells 뒤에 붙인다. 이웃한 두 셀은 8방향으로
+// 인접하고, 대각선으로 건너는 것은 선분이 셀 꼭짓점을 지날 때뿐이다. 그래서 두 점 사이에 시야가 트여 있으면
+// 붙인 셀은 모두 통과 가능하고 모서리를 자르지도 않는다.
+void AppendLineCells(const GridPosition& from, const GridPosition& to, std::vector<GridPosition>& cells);
+
+// 웨이포인트를 직선으로 이은 길이(셀 중심 사이의 유클리드 거리 합)
+float GetWaypointPathLength(const std::vector<GridPosition>& waypoints);
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <limits>
+#include <string>
+
+enum class ETileType
+{
+	Path,
+	Wall,
+	// 통과할 수 있지만 비용이 큰 지형
+	Swamp,
+	Water
+};
+
+namespace EHeuristicMethod
+{
+	enum Type
+	{
+		None = 0,
+		Manhattan,
+		Euclidean,
+		Octile,
+		// LandmarkTable이 있는 탐색에서만 쓰이며, 없으면 Octile로 동작한다. 이동은 8방향이다.
+		ALT,
+		NUM_TYPES
+	};
+
+	inline const char* to_string(EHeuristicMethod::Type e)
+	{
+		switch (e)
+		{
+		case EHeuristicMethod::None:
+			return "None";
+		case EHeuristicMethod::Manhattan:
+			return "Manhattan";
+		case EHeuristicMethod::Euclidean:
+			return "Euclidean";
+		case EHeuristicMethod::Octile:
+			return "Octile";
+		case EHeuristicMethod::ALT:
+			return "ALT";
+		default:
+			return "Unknown";
+		}
+	}
+	inline EHeuristicMethod::Type from_string(const std::string& str)
+	{
+		if (str == "None")
+			return EHeuristicMethod::None;
+		else if (str == "Manhattan")
+			return EHeuristicMethod::Manhattan;
+		else if (str == "Euclidean")
+			return EHeuristicMethod::Euclidean;
+		else if (str == "Octile")
+			return EHeuristicMethod::Octile;
+		else if (str == "ALT")
+			return EHeuristicMethod::ALT;
+		return EHeuristicMethod::None;
+	}
+
+} // namespace EHeuristicMethod
+
+namespace ESearchAlgorithm
+{
+	enum Type
+	{
+		AStar = 0,
+		JumpPointSearch,
+		DStarLite,
+		Bidirectional,
+		// 부모의 부모와 시야가 트여 있으면 바로 잇는 임의 각도 탐색
+		ThetaStar,
+		// 시야 판정을 셀을 꺼낼 때로 미뤄 판정 횟수를 줄인 Theta*
+		LazyThetaStar,
+		NUM_TYPES
+	};
+
+	inline const char* to_string(ESearchAlgorithm::Type e)
+	{
+		switch (e)
+		{
+		case ESearchAlgorithm::AStar:
+			return "AStar";
+		case ESearchAlgorithm::JumpPointSearch:
+			return "JumpPointSearch";
+		case ESearchAlgorithm::DStarLite:
+			return "DStarLite";
+		case ESearchAlgorithm::Bidirectional:
+			return "Bidirectional";
+		case ESearchAlgorithm::ThetaStar:
+			return "ThetaStar";
+		case ESearchAlgorithm::LazyThetaStar:
+			return "LazyThetaStar";
+		default:
+			return "Unknown";
+		}
+	}
+	inline ESearchAlgorithm::Type from_string(const std::string& str)
+	{
+		if (str == "AStar")
+			return ESearchAlgorithm::AStar;
+		else if (str == "JumpPointSearch")
+			return ESearchAlgorithm::JumpPointSearch;
+		else if (str == "DStarLite")
+			return ESearchAlgorithm::DStarLite;
+		else if (str == "Bidirectional")
+			return ESearchAlgorithm::Bidirectional;
+		else if (str == "ThetaStar")
+			return ESearchAlgorithm::ThetaStar;
+		else if (str == "LazyThetaStar")
+			return ESearchAlgorithm::LazyThetaStar;
+		return ESearchAlgorithm::AStar;
+	}
+
+} // namespace ESearchAlgorithm
+
+namespace EOpenListType
+{
+	enum Type
+	{
+		BinaryHeap = 0,
+		QuaternaryHeap,
+		BucketQueue,
+		PriorityQueue,
+		NUM_TYPES
+	};
+
+	inline const char* to_string(EOpenListType::Type e)
+	{
+		switch (e)
+		{
+		case EOpenListType::BinaryHeap:
+			return "BinaryHeap";
+		case EOpenListType::QuaternaryHeap:
+			return "QuaternaryHeap";
+		case EOpenListType::BucketQueue:
+			return "BucketQueue";
+		case EOpenListType::PriorityQueue:
+			return "PriorityQueue";
+		default:
+			return "Unknown";
+		}
+	}
+	inline EOpenListType::Type from_string(const std::string& str)
+	{
+		if (str == "BinaryHeap")
+			return EOpenListType::BinaryHeap;
+		else if (str == "QuaternaryHeap")
+			return EOpenListType::QuaternaryHeap;
+		else if (str == "BucketQueue")
+			return EOpenListType::BucketQueue;
+		else if (str == "PriorityQueue")
+			return EOpenListType::PriorityQueue;
+		return EOpenListType::BinaryHeap;
+	}
+
+} // namespace EOpenListType
+
+namespace PathfindingConfig
+{
+	constexpr float WALL_DENSITY = 0.3f;
+
+	constexpr float DIAGONAL_COST = 1.4142135f;
+	constexpr float ORTHOGONAL_COST = 1.0f;
+	constexpr float IMPASSABLE_COST = std::numeric_limits<float>::max();
+	// 지형 타일의 셀 비용. 이동 비용에 곱해진다.
+	constexpr float SWAMP_COST = 3.0f;
+	constexpr float WATER_COST = 6.0f;
+}
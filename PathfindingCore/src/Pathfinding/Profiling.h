@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+
+// Tracy 계측 매크로. PATHFINDING_ENABLE_TRACY로 빌드했을 때만 Tracy를 포함하고, 아니면 모두 빈 문장이 되어
+// 배포 빌드에는 아무것도 남지 않는다. 이름은 문자열 리터럴이어야 한다.
+//
+// PATHFINDING_ZONE은 Reset, Advance, 경로 복원처럼 쿼리나 조각마다 한 번 지나는 곳에 둔다.
+// PATHFINDING_HOT_ZONE은 노드마다 지나는 곳(확장, 이웃 생성, 휴리스틱, Open List Push/Pop)에 두며
+// PATHFINDING_TRACY_HOT_ZONES까지 켜야 남는다. 구간 하나에 수십 ns가 들어 탐색이 몇 배 느려지기 때문이다.
+// 한 블록에는 구간을 하나만 둘 수 있다.
+#ifdef PATHFINDING_ENABLE_TRACY
+#include "tracy/Tracy.hpp"
+#define PATHFINDING_ZONE(name) ZoneScopedN(name)
+#define PATHFINDING_PLOT(name, value) TracyPlot(name, static_cast<int64_t>(value))
+#else
+#define PATHFINDING_ZONE(name)
+#define PATHFINDING_PLOT(name, value)
+#endif
+
+#if defined(PATHFINDING_ENABLE_TRACY) && defined(PATHFINDING_TRACY_HOT_ZONES)
+#define PATHFINDING_HOT_ZONE(name) ZoneScopedN(name)
+#else
+#define PATHFINDING_HOT_ZONE(name)
+#endif
@@ -0,0 +1,295 @@
+#include "SearchScheduler.h"
+
+#include "Pathfinding/PathSmoothing.h"
+#include "Pathfinding/Profiling.h"
+
+#include <algorithm>
+#include <chrono>
+
+SearchScheduler::SearchScheduler(const Grid& grid, int maxActiveCount)
+	: grid_(grid)
+	, maxActiveCount_(std::max(1, maxActiveCount))
+{
+}
+
+void SearchScheduler::SetAlgorithm(ESearchAlgorithm::Type algorithm)
+{
+	algorithm_ = algorithm;
+	for (std::unique_ptr<AStarSearch>& search : searches_)
+	{
+		search->SetAlgorithm(algorithm);
+	}
+}
+
+void SearchScheduler::SetOpenListType(EOpenListType::Type type)
+{
+	openListType_ = type;
+	for (std::unique_ptr<AStarSearch>& search : searches_)
+	{
+		search->SetOpenListType(type);
+	}
+}
+
+void SearchScheduler::SetLandmarks(const LandmarkTable* landmarks)
+{
+	landmarks_ = landmarks;
+	for (std::unique_ptr<AStarSearch>& search : searches_)
+	{
+		search->SetLandmarks(landmarks);
+	}
+}
+
+void SearchScheduler::SetConnectivity(const ConnectivityIndex* connectivity)
+{
+	connectivity_ = connectivity;
+	for (std::unique_ptr<AStarSearch>& search : searches_)
+	{
+		search->SetConnectivity(connectivity);
+	}
+}
+
+void SearchScheduler::Reserve()
+{
+	while (static_cast<int>(searches_.size()) < maxActiveCount_)
+	{
+		CreateSearch();
+	}
+}
+
+int SearchScheduler::Submit(const PathQuery& query)
+{
+	int handle = INVALID_HANDLE;
+	if (freeHandles_.empty())
+	{
+		handle = static_cast<int>(requests_.size());
+		requests_.emplace_back();
+	}
+	else
+	{
+		handle = freeHandles_.back();
+		freeHandles_.pop_back();
+	}
+	Request& request = requests_[handle];
+	request.Query = query;
+	request.SearchIndex = INVALID_HANDLE;
+	if (cache_ && cache_->Find(query, algorithm_, request.Result))
+	{
+		// 웨이포인트 없이 저장한 항목일 수 있다.
+		if (bBuildWaypoints_ && request.Result.Waypoints.empty())
+		{
+			BuildWaypoints(grid_, request.Result);
+		}
+		request.State = ESearchRequestState::Finished;
+		return handle;
+	}
+	request.State = ESearchRequestState::Queued;
+	queued_.push_back(handle);
+	return handle;
+}
+
+void SearchScheduler::Release(int handle)
+{
+	if (!IsValidHandle(handle))
+	{
+		return;
+	}
+	Request& request = requests_[handle];
+	if (request.State == ESearchRequestState::Queued)
+	{
+		queued_.erase(std::find(queued_.begin(), queued_.end(), handle));
+	}
+	else if (request.State == ESearchRequestState::Running)
+	{
+		freeSearches_.push_back(request.SearchIndex);
+		RemoveRunning(static_cast<size_t>(std::find(running_.begin(), running_.end(), handle) - running_.begin()));
+	}
+	request.State = ESearchRequestState::Invalid;
+	request.SearchIndex = INVALID_HANDLE;
+	freeHandles_.push_back(handle);
+}
+
+int SearchScheduler::Update(const SearchBudget& budget)
+{
+	PATHFINDING_ZONE("SearchScheduler::Update");
+	using Clock = std::chrono::steady_clock;
+	const bool bTimed = budget.MaxTime.count() > 0;
+	const Clock::time_point deadline = Clock::now() + budget.MaxTime;
+	int expandedCount = 0;
+	StartQueued();
+	while (!running_.empty())
+	{
+		SearchBudget slice;
+		slice.MaxNodes = sliceNodeCount_;
+		if (budget.MaxNodes > 0)
+		{
+			if (expandedCount >= budget.MaxNodes)
+			{
+				break;
+			}
+			slice.MaxNodes = std::min(slice.MaxNodes, budget.MaxNodes - expandedCount);
+		}
+		if (bTimed)
+		{
+			slice.MaxTime = std::chrono::duration_cast<std::chrono::microseconds>(deadline - Clock::now());
+			if (slice.MaxTime.count() <= 0)
+			{
+				break;
+			}
+		}
+
+		if (cursor_ >= running_.size())
+		{
+			cursor_ = 0;
+		}
+		AStarSearch& search = *searches_[requests_[running_[cursor_]].SearchIndex];
+		expandedCount += search.Advance(slice);
+		if (search.IsFinished())
+		{
+			// 빈 자리는 바로 다음 요청으로 채우고, 커서는 그대로 두어 다음 요청이 차례를 받게 한다.
+			Finish(cursor_);
+			StartQueued();
+		}
+		else
+		{
+			++cursor_;
+		}
+	}
+	PATHFINDING_PLOT("Scheduler Running", running_.size());
+	PATHFINDING_PLOT("Scheduler Queued", queued_.size());
+	return expandedCount;
+}
+
+ESearchRequestState SearchScheduler::GetState(int handle) const
+{
+	return IsValidHandle(handle) ? requests_[handle].State : ESearchRequestState::Invalid;
+}
+
+void SearchScheduler::GetResult(int handle, PathResult& result) const
+{
+	const ESearchRequestState state = GetState(handle);
+	if (state == ESearchRequestState::Finished)
+	{
+		result = requests_[handle].Result;
+		return;
+	}
+	if (state == ESearchRequestState::Running)
+	{
+		searches_[requests_[handle].SearchIndex]->BuildPartialPath(result);
+		if (bBuildWaypoints_)
+		{
+			BuildWaypoints(grid_, result);
+		}
+		return;
+	}
+	result.bFound = false;
+	result.bPartial = false;
+	result.Cost = 0.0f;
+	result.Cells.clear();
+	result.Waypoints.clear();
+}
+
+SearchStats SearchScheduler::GetStats(int handle) const
+{
+	return GetState(handle) == ESearchRequestState::Finished ? requests_[handle].Result.Stats : SearchStats{};
+}
+
+const AStarSearch* SearchScheduler::GetSearch(int handle) const
+{
+	if (GetState(handle) != ESearchRequestState::Running)
+	{
+		return nullptr;
+	}
+	return searches_[requests_[handle].SearchIndex].get();
+}
+
+size_t SearchScheduler::GetMemoryUsage() const
+{
+	size_t bytes = 0;
+	for (const std::unique_ptr<AStarSearch>& search : searches_)
+	{
+		bytes += search->GetSearchSpace().GetMemoryUsage();
+	}
+	for (const Request& request : requests_)
+	{
+		bytes += sizeof(Request) + (request.Result.Cells.capacity() + request.Result.Waypoints.capacity())
+									   * sizeof(GridPosition);
+	}
+	return bytes;
+}
+
+bool SearchScheduler::IsValidHandle(int handle) const
+{
+	return handle >= 0 && handle < static_cast<int>(requests_.size())
+		   && requests_[handle].State != ESearchRequestState::Invalid;
+}
+
+void SearchScheduler::StartQueued()
+{
+	while (!queued_.empty())
+	{
+		if (freeSearches_.empty())
+		{
+			if (static_cast<int>(searches_.size()) >= maxActiveCount_)
+			{
+				return;
+			}
+			CreateSearch();
+		}
+		const int searchIndex = freeSearches_.back();
+		freeSearches_.pop_back();
+
+		const int handle = queued_.front();
+		queued_.pop_front();
+		Request& request = requests_[handle];
+		request.State = ESearchRequestState::Running;
+		request.SearchIndex = searchIndex;
+		request.Algorithm = algorithm_;
+		request.CacheGeneration = cache_ ? cache_->GetGeneration() : 0;
+		searches_[searchIndex]->Reset(request.Query.Start, request.Query.End, request.Query.Method);
+		running_.push_back(handle);
+	}
+}
+
+void SearchScheduler::CreateSearch()
+{
+	std::unique_ptr<AStarSearch>& search = searches_.emplace_back(std::make_unique<AStarSearch>(grid_));
+	search->SetAlgorithm(algorithm_);
+	search->SetOpenListType(openListType_);
+	search->SetLandmarks(landmarks_);
+	search->SetConnectivity(connectivity_);
+	// 셀 수만큼의 배열은 Reset에서 할당되므로 여기서 한 번 초기화해 둔다.
+	if (grid_.GetCellCount() > 0)
+	{
+		search->Reset({0, 0}, {0, 0}, EHeuristicMethod::Octile);
+	}
+	freeSearches_.push_back(static_cast<int>(searches_.size()) - 1);
+}
+
+void SearchScheduler::Finish(size_t position)
+{
+	const int handle = running_[position];
+	Request& request = requests_[handle];
+	const AStarSearch& search = *searches_[request.SearchIndex];
+	search.BuildPath(request.Result);
+	if (bBuildWaypoints_)
+	{
+		BuildWaypoints(grid_, request.Result);
+	}
+	if (cache_)
+	{
+		cache_->Store(request.Query, request.Algorithm, request.Result, request.CacheGeneration);
+	}
+	request.State = ESearchRequestState::Finished;
+	freeSearches_.push_back(request.SearchIndex);
+	request.SearchIndex = INVALID_HANDLE;
+	RemoveRunning(position);
+}
+
+void SearchScheduler::RemoveRunning(size_t position)
+{
+	running_.erase(running_.begin() + static_cast<std::ptrdiff_t>(position));
+	if (cursor_ > position)
+	{
+		--cursor_;
+	}
+}
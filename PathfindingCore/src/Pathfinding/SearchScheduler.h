@@ -0,0 +1,119 @@
+#pragma once
+#include "Pathfinding/AStarSearch.h"
+#include "Pathfinding/Grid.h"
+#include "Pathfinding/PathCache.h"
+#include "Pathfinding/PathResult.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+enum class ESearchRequestState
+{
+	// 없는 핸들이거나 Release된 핸들
+	Invalid,
+	Queued,
+	Running,
+	Finished
+};
+
+// 여러 탐색 요청을 프레임마다 조금씩 나눠 진행한다. Update 한 번에 받은 예산을 실행 중인 요청들에
+// 돌아가며 조각(slice) 단위로 나눠 주고, 다 쓰면 멈춘 곳에서 다음 Update가 이어 간다.
+//
+// 실행 중인 요청마다 AStarSearch(셀 수만큼의 탐색 상태)가 필요하므로 동시에 실행하는 수는 maxActiveCount로
+// 제한하고, 나머지는 제출한 순서대로 기다린다. 끝난 요청은 결과를 복사해 두고 탐색 객체를 다음 요청에 넘긴다.
+// Grid는 Update 사이에만 바꿀 수 있으며, 이미 실행 중인 요청에는 바뀐 맵이 일부만 반영될 수 있다.
+class SearchScheduler
+{
+public:
+	static constexpr int INVALID_HANDLE = -1;
+	// 요청 하나가 한 번에 확장하는 기본 노드 수
+	static constexpr int DEFAULT_SLICE_NODE_COUNT = 256;
+
+	explicit SearchScheduler(const Grid& grid, int maxActiveCount = 8);
+
+	// 아래 설정은 이후에 시작하는 요청부터 적용된다.
+	void SetAlgorithm(ESearchAlgorithm::Type algorithm);
+	void SetOpenListType(EOpenListType::Type type);
+	// 표의 수명은 호출한 쪽이 관리한다.
+	void SetLandmarks(const LandmarkTable* landmarks);
+	void SetConnectivity(const ConnectivityIndex* connectivity);
+	// 있으면 Submit이 먼저 캐시를 찾아 적중한 요청은 바로 끝내고, 끝난 결과는 캐시에 넣는다.
+	// 캐시의 수명은 호출한 쪽이 관리하고, Grid를 바꾸면 캐시에도 알린다(PathCache::OnTileChanged).
+	void SetCache(PathCache* cache) { cache_ = cache; }
+	// 켜면 끝난 결과와 부분 경로에 BuildWaypoints까지 실행한다. 캐시에서 찾은 결과에 웨이포인트가 없으면 채운다.
+	void SetBuildWaypoints(bool bBuildWaypoints) { bBuildWaypoints_ = bBuildWaypoints; }
+	// 요청 하나가 차례마다 쓰는 최대 노드 수. 작을수록 요청 사이가 공평하고, 클수록 전환 비용이 적다.
+	void SetSliceNodeCount(int count) { sliceNodeCount_ = count > 0 ? count : DEFAULT_SLICE_NODE_COUNT; }
+
+	// 탐색 상태는 처음 필요할 때 셀 수만큼 할당하므로 큰 맵에서는 그 Update가 예산을 크게 넘긴다.
+	// 로딩 중에 호출해 maxActiveCount개를 미리 만들어 둔다.
+	void Reserve();
+
+	// 핸들은 Release할 때까지 유효하다.
+	int Submit(const PathQuery& query);
+	// 기다리거나 실행 중인 요청은 취소한다. 끝난 요청은 결과를 읽은 뒤에 돌려준다.
+	void Release(int handle);
+
+	// 예산을 다 쓰거나 모든 요청이 끝날 때까지 진행하고, 확장한 노드 수를 돌려준다.
+	// 예산이 모두 0이면 모든 요청이 끝날 때까지 진행한다.
+	int Update(const SearchBudget& budget);
+
+	ESearchRequestState GetState(int handle) const;
+	// 끝났으면 최종 결과, 실행 중이면 지금까지의 부분 경로(AStarSearch::BuildPartialPath), 그 밖에는 빈 결과.
+	// result의 기존 용량을 재사용한다.
+	void GetResult(int handle, PathResult& result) const;
+	// 끝난 요청의 탐색 통계. 그 밖에는 빈 통계.
+	SearchStats GetStats(int handle) const;
+	// 실행 중인 요청의 탐색 상태(시각화용). 아니면 nullptr.
+	const AStarSearch* GetSearch(int handle) const;
+
+	int GetQueuedCount() const { return static_cast<int>(queued_.size()); }
+	int GetRunningCount() const { return static_cast<int>(running_.size()); }
+	// 만들어 둔 탐색 상태와 보관 중인 결과가 차지하는 바이트
+	size_t GetMemoryUsage() const;
+
+private:
+	struct Request
+	{
+		PathQuery Query;
+		ESearchRequestState State = ESearchRequestState::Invalid;
+		// 실행 중이면 searches_의 인덱스
+		int SearchIndex = INVALID_HANDLE;
+		// 시작할 때의 알고리즘과 캐시 세대. 끝난 결과를 캐시에 넣을 때 쓴다.
+		ESearchAlgorithm::Type Algorithm = ESearchAlgorithm::AStar;
+		uint64_t CacheGeneration = 0;
+		PathResult Result;
+	};
+
+	bool IsValidHandle(int handle) const;
+	// 빈 탐색 객체가 있는 동안 기다리는 요청을 시작한다.
+	void StartQueued();
+	// 탐색 객체를 하나 더 만들어 freeSearches_에 넣는다.
+	void CreateSearch();
+	// running_[position]의 요청을 끝내고 탐색 객체를 돌려준다.
+	void Finish(size_t position);
+	void RemoveRunning(size_t position);
+
+	const Grid& grid_;
+	int maxActiveCount_ = 1;
+	int sliceNodeCount_ = DEFAULT_SLICE_NODE_COUNT;
+	bool bBuildWaypoints_ = false;
+
+	ESearchAlgorithm::Type algorithm_ = ESearchAlgorithm::AStar;
+	EOpenListType::Type openListType_ = EOpenListType::BinaryHeap;
+	const LandmarkTable* landmarks_ = nullptr;
+	const ConnectivityIndex* connectivity_ = nullptr;
+	PathCache* cache_ = nullptr;
+
+	std::vector<std::unique_ptr<AStarSearch>> searches_;
+	std::vector<int> freeSearches_;
+	std::vector<Request> requests_;
+	std::vector<int> freeHandles_;
+	std::deque<int> queued_;
+	// 실행 중인 요청의 핸들. cursor_부터 돌아가며 조각을 준다.
+	std::vector<int> running_;
+	size_t cursor_ = 0;
+};
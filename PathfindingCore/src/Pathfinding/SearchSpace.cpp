@@ -0,0 +1,31 @@
+#include "SearchSpace.h"
+
+#include <algorithm>
+
+void SearchSpace::Resize(int cellCount)
+{
+	gCosts_.resize(cellCount);
+	parents_.resize(cellCount);
+	stamps_.assign(cellCount, 0u);
+	generation_ = 1;
+	changeLog_.SetCellCount(cellCount);
+	changeLog_.MarkAllChanged();
+}
+
+void SearchSpace::Clear()
+{
+	changeLog_.MarkAllChanged();
+	++generation_;
+	// 세대 값이 스탬프 비트를 넘어가면 한 번만 전체를 지운다.
+	if (generation_ >= (1u << 31))
+	{
+		std::fill(stamps_.begin(), stamps_.end(), 0u);
+		generation_ = 1;
+	}
+}
+
+size_t SearchSpace::GetMemoryUsage() const
+{
+	return gCosts_.capacity() * sizeof(float) + parents_.capacity() * sizeof(int)
+		   + stamps_.capacity() * sizeof(uint32_t) + changeLog_.GetCells().capacity() * sizeof(int);
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include "Pathfinding/CellChangeLog.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// 탐색 중 셀마다 필요한 상태를 필드별 배열로 보관한다.
+// Grid는 읽기 전용으로 두고 탐색 상태만 이곳에 기록한다.
+//
+// 셀마다 마지막으로 기록된 탐색 세대(generation)를 함께 저장한다. 세대가 현재와 다른 셀은
+// 아직 방문하지 않은 것으로 취급하므로 Clear는 세대만 올리는 O(1) 연산이다.
+//
+// 변경 목록(CellChangeLog)을 켜 두면 처음 방문한 셀, Closed가 되거나 다시 열린 셀을 모은다.
+// Clear와 Resize는 모든 셀이 바뀐 것으로 기록한다.
+class SearchSpace
+{
+public:
+	static constexpr int INVALID_INDEX = -1;
+
+	void Resize(int cellCount);
+	void Clear();
+
+	int GetCellCount() const { return static_cast<int>(gCosts_.size()); }
+
+	bool IsVisited(int index) const { return (stamps_[index] >> 1) == generation_; }
+
+	float GetGCost(int index) const
+	{
+		return IsVisited(index) ? gCosts_[index] : std::numeric_limits<float>::max();
+	}
+	// 처음 기록되는 셀이면 부모를 INVALID_INDEX로 초기화한다.
+	void SetGCost(int index, float cost)
+	{
+		Visit(index);
+		gCosts_[index] = cost;
+	}
+
+	int GetParent(int index) const { return IsVisited(index) ? parents_[index] : INVALID_INDEX; }
+	void SetParent(int index, int parent)
+	{
+		Visit(index);
+		parents_[index] = parent;
+	}
+
+	bool IsClosed(int index) const { return stamps_[index] == ((generation_ << 1) | 1u); }
+	void SetClosed(int index)
+	{
+		Visit(index);
+		stamps_[index] |= 1u;
+		changeLog_.Add(index);
+	}
+	// 일관되지 않은 휴리스틱에서 Closed 셀까지 더 싼 경로를 찾았을 때 다시 연다.
+	void Reopen(int index)
+	{
+		stamps_[index] &= ~1u;
+		changeLog_.Add(index);
+	}
+	// 비용이 기록되었지만 아직 Closed가 아닌 셀. 탐색은 비용을 기록한 셀을 항상 Open List에 넣는다.
+	bool IsOpen(int index) const { return stamps_[index] == (generation_ << 1); }
+
+	CellChangeLog& GetChangeLog() { return changeLog_; }
+
+	size_t GetMemoryUsage() const;
+
+private:
+	void Visit(int index)
+	{
+		if (!IsVisited(index))
+		{
+			stamps_[index] = generation_ << 1;
+			gCosts_[index] = std::numeric_limits<float>::max();
+			parents_[index] = INVALID_INDEX;
+			changeLog_.Add(index);
+		}
+	}
+
+	std::vector<float> gCosts_;
+	std::vector<int> parents_;
+	// (세대 << 1) | Closed 비트
+	std::vector<uint32_t> stamps_;
+	uint32_t generation_ = 1;
+	CellChangeLog changeLog_;
+};
@@ -0,0 +1,66 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(int threadCount)
+{
+	threadCount = std::max(threadCount, 1);
+	workers_.reserve(threadCount);
+	for (int i = 0; i < threadCount; ++i)
+	{
+		workers_.emplace_back([this, i]() { WorkerLoop(i); });
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		bStopping_ = true;
+	}
+	wakeCondition_.notify_all();
+	for (std::thread& worker : workers_)
+	{
+		worker.join();
+	}
+}
+
+void ThreadPool::RunOnAllWorkers(const std::function<void(int)>& job)
+{
+	std::unique_lock<std::mutex> lock(mutex_);
+	job_ = &job;
+	pendingWorkers_ = GetThreadCount();
+	++jobGeneration_;
+	wakeCondition_.notify_all();
+	doneCondition_.wait(lock, [this]() { return pendingWorkers_ == 0; });
+	job_ = nullptr;
+}
+
+void ThreadPool::WorkerLoop(int workerIndex)
+{
+	uint64_t lastGeneration = 0;
+	while (true)
+	{
+		const std::function<void(int)>* job = nullptr;
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			wakeCondition_.wait(lock, [&]() { return bStopping_ || jobGeneration_ != lastGeneration; });
+			if (bStopping_)
+			{
+				return;
+			}
+			lastGeneration = jobGeneration_;
+			job = job_;
+		}
+
+		(*job)(workerIndex);
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			if (--pendingWorkers_ == 0)
+			{
+				doneCondition_.notify_one();
+			}
+		}
+	}
+}
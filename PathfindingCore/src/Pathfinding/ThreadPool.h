@@ -0,0 +1,38 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 고정된 수의 워커 스레드. 작업은 모든 워커에 한 번씩 전달되며,
+// 워커 인덱스로 스레드별 스크래치 데이터를 고를 수 있다.
+class ThreadPool
+{
+public:
+	explicit ThreadPool(int threadCount);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	int GetThreadCount() const { return static_cast<int>(workers_.size()); }
+
+	// 모든 워커에서 job(workerIndex)를 실행하고 전부 끝날 때까지 기다린다.
+	void RunOnAllWorkers(const std::function<void(int)>& job);
+
+private:
+	void WorkerLoop(int workerIndex);
+
+	std::vector<std::thread> workers_;
+	std::mutex mutex_;
+	std::condition_variable wakeCondition_;
+	std::condition_variable doneCondition_;
+
+	const std::function<void(int)>* job_ = nullptr;
+	uint64_t jobGeneration_ = 0;
+	int pendingWorkers_ = 0;
+	bool bStopping_ = false;
+};
@@ -0,0 +1,137 @@
+// 한 번 돌려 본(웜업) AStarSearch와 PathResult로 다시 탐색하면 힙 할당이 없어야 한다.
+// 전역 operator new를 바꿔 할당 횟수를 센다.
+#include "TestUtils.h"
+
+#include "Pathfinding/AStarSearch.h"
+#include "Pathfinding/LandmarkTable.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+	std::atomic<size_t> allocationCount{0};
+
+	void* CountedAllocate(size_t size)
+	{
+		allocationCount.fetch_add(1, std::memory_order_relaxed);
+		if (void* pointer = std::malloc(size != 0 ? size : 1))
+		{
+			return pointer;
+		}
+		throw std::bad_alloc();
+	}
+} // namespace
+
+void* operator new(size_t size)
+{
+	return CountedAllocate(size);
+}
+
+void* operator new[](size_t size)
+{
+	return CountedAllocate(size);
+}
+
+void operator delete(void* pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept
+{
+	std::free(pointer);
+}
+
+namespace
+{
+	constexpr int MAP_SIZE = 128;
+	constexpr int QUERY_COUNT = 16;
+	constexpr int REPEAT_COUNT = 2;
+
+	// 모든 쿼리를 한 번 돌려 버퍼를 키운 뒤, 같은 쿼리를 REPEAT_COUNT번 다시 돌리는 동안의 할당 수를 센다.
+	void CheckSteadyStateAllocations(const Grid& grid, const LandmarkTable& landmarks, const char* mapName)
+	{
+		AStarSearch search(grid);
+		search.SetLandmarks(&landmarks);
+		PathResult result;
+		const EHeuristicMethod::Type methods[] = {EHeuristicMethod::None, EHeuristicMethod::Manhattan,
+												  EHeuristicMethod::Octile, EHeuristicMethod::ALT};
+		const ESearchAlgorithm::Type algorithms[] = {ESearchAlgorithm::AStar, ESearchAlgorithm::JumpPointSearch,
+													 ESearchAlgorithm::ThetaStar, ESearchAlgorithm::LazyThetaStar};
+
+		for (const ESearchAlgorithm::Type algorithm : algorithms)
+		{
+			for (int type = 0; type < EOpenListType::NUM_TYPES; ++type)
+			{
+				const auto openListType = static_cast<EOpenListType::Type>(type);
+				search.SetAlgorithm(algorithm);
+				search.SetOpenListType(openListType);
+				for (const EHeuristicMethod::Type method : methods)
+				{
+					const std::vector<PathQuery> queries = MakeQueries(grid, QUERY_COUNT, method, 7);
+					for (const PathQuery& query : queries)
+					{
+						search.Reset(query.Start, query.End, query.Method);
+						search.Run(result);
+					}
+
+					const size_t before = allocationCount.load();
+					for (int repeat = 0; repeat < REPEAT_COUNT; ++repeat)
+					{
+						for (const PathQuery& query : queries)
+						{
+							search.Reset(query.Start, query.End, query.Method);
+							search.Run(result);
+						}
+					}
+					const size_t allocations = allocationCount.load() - before;
+					if (allocations != 0)
+					{
+						std::fprintf(stderr, "%s %s %s %s: %zu allocation(s)\n", mapName,
+									 ESearchAlgorithm::to_string(algorithm), EOpenListType::to_string(openListType),
+									 EHeuristicMethod::to_string(method), allocations);
+					}
+					CHECK(allocations == 0);
+				}
+			}
+		}
+	}
+} // namespace
+
+int main()
+{
+	const Grid walls = MakeRandomGrid(MAP_SIZE, PathfindingConfig::WALL_DENSITY, 1);
+	LandmarkTable wallLandmarks;
+	wallLandmarks.Build(walls);
+	CheckSteadyStateAllocations(walls, wallLandmarks, "walls");
+
+	// 셀 비용 레이어가 있으면 WeightedCostModel로 확장한다(JPS와 Theta*는 A*로 대체).
+	Grid terrain = MakeRandomGrid(MAP_SIZE, 0.2f, 2);
+	for (int row = 0; row < MAP_SIZE; row += 3)
+	{
+		for (int column = row % 7; column < MAP_SIZE; column += 5)
+		{
+			if (terrain.IsWalkable(row, column))
+			{
+				terrain.SetTileType(row, column, column % 2 == 0 ? ETileType::Swamp : ETileType::Water);
+			}
+		}
+	}
+	LandmarkTable terrainLandmarks;
+	terrainLandmarks.Build(terrain);
+	CheckSteadyStateAllocations(terrain, terrainLandmarks, "terrain");
+
+	return FinishTest("AllocationTest");
+}
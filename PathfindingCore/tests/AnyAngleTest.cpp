@@ -0,0 +1,177 @@
+// 벽이 있는 랜덤 맵에서 Theta*와 Lazy Theta*의 웨이포인트가 이웃한 두 점마다 시야가 트여 있고,
+// AppendLineCells로 편 Cells가 코너를 자르지 않는 8방향 셀 경로이며, 비용이 A*보다 크지 않은지 확인한다.
+// A* 경로에서 BuildWaypoints로 당긴 웨이포인트도 같은 조건을 지켜야 한다.
+#include "TestUtils.h"
+
+#include "Pathfinding/AStarSearch.h"
+#include "Pathfinding/PathSmoothing.h"
+
+namespace
+{
+	constexpr int QUERY_COUNT = 150;
+	constexpr int LINE_SAMPLES = 5000;
+
+	// 이웃한 두 점이 서로 보이고 시작과 도착에서 끝나는지
+	bool HasVisibleWaypoints(const Grid& grid, const PathQuery& query, const std::vector<GridPosition>& waypoints)
+	{
+		if (waypoints.empty() || !(waypoints.front() == query.Start) || !(waypoints.back() == query.End))
+		{
+			return false;
+		}
+		for (size_t i = 1; i < waypoints.size(); ++i)
+		{
+			const GridPosition& from = waypoints[i - 1];
+			const GridPosition& to = waypoints[i];
+			if (!grid.HasLineOfSight(from.Row, from.Column, to.Row, to.Column))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// from 다음부터 이어지는 cells가 통과 가능하고 8방향으로 인접하며, 대각선으로 건널 때는 꼭짓점의
+	// 나머지 두 셀도 통과 가능한지(선분이 꼭짓점을 지나면 네 셀을 모두 보는 시야 판정과 같은 규칙)
+	bool IsOpenCellChain(const Grid& grid, const GridPosition& from, const std::vector<GridPosition>& cells,
+						 size_t first)
+	{
+		GridPosition previous = from;
+		for (size_t i = first; i < cells.size(); ++i)
+		{
+			const GridPosition& cell = cells[i];
+			const int deltaRow = cell.Row - previous.Row;
+			const int deltaColumn = cell.Column - previous.Column;
+			if (std::abs(deltaRow) > 1 || std::abs(deltaColumn) > 1 || (deltaRow == 0 && deltaColumn == 0)
+				|| !grid.IsInBounds(cell.Row, cell.Column) || !grid.IsWalkable(cell.Row, cell.Column))
+			{
+				return false;
+			}
+			if (deltaRow != 0 && deltaColumn != 0
+				&& (!grid.IsWalkable(previous.Row + deltaRow, previous.Column)
+					|| !grid.IsWalkable(previous.Row, cell.Column)))
+			{
+				return false;
+			}
+			previous = cell;
+		}
+		return true;
+	}
+
+	// 시야가 트인 임의의 두 셀 사이에서 AppendLineCells가 붙인 셀을 검사한다.
+	void CheckLineCells(const Grid& grid, uint32_t seed)
+	{
+		std::mt19937 random(seed);
+		std::vector<GridPosition> cells;
+		int visibleCount = 0;
+		for (int sample = 0; sample < LINE_SAMPLES; ++sample)
+		{
+			const GridPosition from = {static_cast<int>(random() % grid.GetRowCount()),
+									   static_cast<int>(random() % grid.GetColumnCount())};
+			// 짧은 선분이 많아야 시야가 트인 쌍이 나온다.
+			const int reach = 1 + static_cast<int>(random() % 16);
+			const GridPosition to = {
+				std::clamp(from.Row + static_cast<int>(random() % (2 * reach + 1)) - reach, 0, grid.GetRowCount() - 1),
+				std::clamp(from.Column + static_cast<int>(random() % (2 * reach + 1)) - reach, 0,
+						   grid.GetColumnCount() - 1)};
+			if (from == to || !grid.HasLineOfSight(from.Row, from.Column, to.Row, to.Column))
+			{
+				continue;
+			}
+			++visibleCount;
+			cells.clear();
+			AppendLineCells(from, to, cells);
+			CHECK(!cells.empty() && cells.back() == to);
+			CHECK(IsOpenCellChain(grid, from, cells, 0));
+		}
+		CHECK(visibleCount > LINE_SAMPLES / 20);
+	}
+
+	void CheckQueries(const Grid& grid, uint32_t seed)
+	{
+		const std::vector<PathQuery> queries = MakeQueries(grid, QUERY_COUNT, EHeuristicMethod::Octile, seed);
+		AStarSearch astar(grid);
+		AStarSearch anyAngle(grid);
+		PathResult optimal;
+		PathResult result;
+		std::vector<GridPosition> cells;
+		double gridCostSum = 0.0;
+		double anyAngleCostSum[2] = {};
+		for (const PathQuery& query : queries)
+		{
+			astar.Reset(query.Start, query.End, query.Method);
+			astar.Run(optimal);
+			CHECK(IsValidCellPath(grid, query, optimal));
+			BuildWaypoints(grid, optimal);
+			if (optimal.bFound)
+			{
+				gridCostSum += optimal.Cost;
+				CHECK(HasVisibleWaypoints(grid, query, optimal.Waypoints));
+				CHECK(GetWaypointPathLength(optimal.Waypoints) <= optimal.Cost + 1e-3f);
+			}
+
+			const ESearchAlgorithm::Type algorithms[] = {ESearchAlgorithm::ThetaStar, ESearchAlgorithm::LazyThetaStar};
+			for (const ESearchAlgorithm::Type algorithm : algorithms)
+			{
+				anyAngle.SetAlgorithm(algorithm);
+				anyAngle.Reset(query.Start, query.End, query.Method);
+				CHECK(anyAngle.GetActiveAlgorithm() == algorithm);
+				anyAngle.Run(result);
+				CHECK(result.bFound == optimal.bFound);
+				if (!result.bFound)
+				{
+					CHECK(result.Cells.empty() && result.Waypoints.empty());
+					continue;
+				}
+				const bool bVisible = HasVisibleWaypoints(grid, query, result.Waypoints);
+				// 셀 경로의 격자 비용이 아니라 웨이포인트를 직선으로 이은 길이가 비용이다.
+				const bool bCostMatches = IsSameCost(result.Cost, GetWaypointPathLength(result.Waypoints));
+				const bool bNotLonger = result.Cost <= optimal.Cost + 1e-3f;
+				if (!bVisible || !bCostMatches || !bNotLonger)
+				{
+					std::fprintf(stderr, "%s (%d,%d)->(%d,%d): visible %d, cost %f (length %f), A* cost %f\n",
+								 ESearchAlgorithm::to_string(algorithm), query.Start.Row, query.Start.Column,
+								 query.End.Row, query.End.Column, bVisible, result.Cost,
+								 GetWaypointPathLength(result.Waypoints), optimal.Cost);
+				}
+				CHECK(bVisible);
+				CHECK(bCostMatches);
+				CHECK(bNotLonger);
+
+				// Cells는 웨이포인트 사이를 AppendLineCells로 편 것과 같아야 한다.
+				cells.assign(1, result.Waypoints.front());
+				for (size_t i = 1; i < result.Waypoints.size(); ++i)
+				{
+					AppendLineCells(result.Waypoints[i - 1], result.Waypoints[i], cells);
+				}
+				CHECK(result.Cells == cells);
+				CHECK(!result.Cells.empty() && result.Cells.front() == query.Start && result.Cells.back() == query.End);
+				CHECK(IsOpenCellChain(grid, query.Start, result.Cells, 1));
+
+				// 이미 보이는 점들을 다시 당겨도 시야는 유지되고 길어지지 않는다.
+				const float length = GetWaypointPathLength(result.Waypoints);
+				BuildWaypoints(grid, result);
+				CHECK(HasVisibleWaypoints(grid, query, result.Waypoints));
+				CHECK(GetWaypointPathLength(result.Waypoints) <= length + 1e-3f);
+				anyAngleCostSum[algorithm == ESearchAlgorithm::LazyThetaStar ? 1 : 0] += result.Cost;
+			}
+		}
+		std::printf("seed %u: A* %.1f, Theta* %.1f, Lazy Theta* %.1f\n", seed, gridCostSum, anyAngleCostSum[0],
+					anyAngleCostSum[1]);
+	}
+
+	void RunMap(int size, float density, uint32_t seed)
+	{
+		const Grid grid = MakeRandomGrid(size, density, seed);
+		CheckLineCells(grid, seed);
+		CheckQueries(grid, seed);
+	}
+} // namespace
+
+int main()
+{
+	RunMap(64, 0.2f, 201);
+	RunMap(96, 0.3f, 202);
+	RunMap(48, 0.4f, 203);
+	RunMap(128, 0.1f, 204);
+	return FinishTest("AnyAngleTest");
+}
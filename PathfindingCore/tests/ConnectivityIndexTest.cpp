@@ -0,0 +1,140 @@
+// 벽을 세우고 허물며 OnTileChanged로 고친 연결 영역 표가 새로 Build한 표, 그리고 BFS와 같은 영역을 나누는지 확인한다.
+#include "TestUtils.h"
+
+#include "Pathfinding/ConnectivityIndex.h"
+
+#include <unordered_map>
+
+namespace
+{
+	constexpr int EDIT_COUNT = 2000;
+	constexpr int PAIR_SAMPLES = 200;
+
+	// 4방향 BFS로 매긴 영역 번호. 벽은 INVALID_LABEL이다.
+	std::vector<int> LabelByBreadthFirst(const Grid& grid)
+	{
+		std::vector<int> labels(grid.GetCellCount(), ConnectivityIndex::INVALID_LABEL);
+		std::vector<int> queue;
+		int labelCount = 0;
+		for (int seed = 0; seed < grid.GetCellCount(); ++seed)
+		{
+			if (!grid.IsWalkable(seed) || labels[seed] != ConnectivityIndex::INVALID_LABEL)
+			{
+				continue;
+			}
+			labels[seed] = labelCount;
+			queue.assign(1, seed);
+			for (size_t i = 0; i < queue.size(); ++i)
+			{
+				grid.ForEachNeighbor<false>(queue[i],
+											[&](int neighbor, bool /*bDiagonal*/)
+											{
+												if (labels[neighbor] == ConnectivityIndex::INVALID_LABEL)
+												{
+													labels[neighbor] = labelCount;
+													queue.push_back(neighbor);
+												}
+											});
+			}
+			++labelCount;
+		}
+		return labels;
+	}
+
+	// 번호는 달라도 같은 셀들을 같은 영역으로 묶는지. 두 방향 모두 번호가 일대일로 대응해야 한다.
+	bool IsSamePartition(const ConnectivityIndex& index, const std::vector<int>& expected)
+	{
+		std::unordered_map<int, int> forward;
+		std::unordered_map<int, int> backward;
+		for (int cell = 0; cell < static_cast<int>(expected.size()); ++cell)
+		{
+			const int label = index.GetLabel(cell);
+			if ((label == ConnectivityIndex::INVALID_LABEL) != (expected[cell] == ConnectivityIndex::INVALID_LABEL))
+			{
+				return false;
+			}
+			if (label == ConnectivityIndex::INVALID_LABEL)
+			{
+				continue;
+			}
+			if (forward.emplace(label, expected[cell]).first->second != expected[cell]
+				|| backward.emplace(expected[cell], label).first->second != label)
+			{
+				return false;
+			}
+		}
+		return static_cast<int>(forward.size()) == index.GetComponentCount();
+	}
+
+	void RunEdits(int size, float density, int threadCount, uint32_t seed)
+	{
+		Grid grid = MakeRandomGrid(size, density, seed);
+		std::mt19937 random(seed);
+		ConnectivityIndex incremental(grid);
+		incremental.Build();
+		ConnectivityIndex fresh(grid, threadCount);
+		fresh.Build();
+		CHECK(IsSamePartition(fresh, LabelByBreadthFirst(grid)));
+
+		int mismatchCount = 0;
+		for (int edit = 0; edit < EDIT_COUNT; ++edit)
+		{
+			const int row = static_cast<int>(random() % size);
+			const int column = static_cast<int>(random() % size);
+			// 가끔 비용만 바꿔 통과 여부가 그대로인 변경도 섞는다.
+			ETileType type = grid.IsWalkable(row, column) ? ETileType::Wall : ETileType::Path;
+			if (type == ETileType::Wall && random() % 8 == 0)
+			{
+				type = ETileType::Swamp;
+			}
+			grid.SetTileType(row, column, type);
+			incremental.OnTileChanged(row, column);
+
+			fresh.Build();
+			const bool bSame = IsSamePartition(incremental, LabelByBreadthFirst(grid))
+							   && incremental.GetComponentCount() == fresh.GetComponentCount();
+			bool bSamePairs = true;
+			for (int pair = 0; pair < PAIR_SAMPLES; ++pair)
+			{
+				const int start = static_cast<int>(random() % grid.GetCellCount());
+				const int end = static_cast<int>(random() % grid.GetCellCount());
+				bSamePairs = bSamePairs && incremental.IsReachable(start, end) == fresh.IsReachable(start, end);
+			}
+			if (!bSame || !bSamePairs)
+			{
+				if (++mismatchCount <= 5)
+				{
+					std::fprintf(stderr, "size %d density %.2f edit %d at (%d,%d) -> %s: labels differ\n", size,
+								 density, edit, row, column, grid.IsWalkable(row, column) ? "open" : "wall");
+				}
+			}
+			CHECK(bSame);
+			CHECK(bSamePairs);
+		}
+	}
+
+	// 같은 셀이라도 벽이면 도달할 수 없다.
+	void CheckSameCell()
+	{
+		Grid grid = MakeRandomGrid(8, 0.0f, 1);
+		grid.SetTileType(2, 3, ETileType::Wall);
+		ConnectivityIndex index(grid);
+		index.Build();
+		const int wall = grid.ToIndex(2, 3);
+		const int open = grid.ToIndex(4, 4);
+		CHECK(!index.IsReachable(wall, wall));
+		CHECK(index.IsReachable(open, open));
+		CHECK(!index.IsReachable(open, wall));
+		CHECK(!index.IsReachable(wall, open));
+	}
+} // namespace
+
+int main()
+{
+	CheckSameCell();
+	// 벽 밀도가 임계점 근처일수록 막힌 셀 하나로 영역이 갈라지고 합쳐지는 일이 잦다.
+	RunEdits(48, 0.35f, 1, 111);
+	RunEdits(64, 0.42f, 4, 112);
+	RunEdits(40, 0.5f, 3, 113);
+	return FinishTest("ConnectivityIndexTest");
+}
@@ -0,0 +1,97 @@
+// 타일을 바꾸고 시작 셀을 옮기며 D* Lite로 다시 계획한 경로가 매번 새로 돌린 A*와 같은 비용인지 확인한다.
+#include "TestUtils.h"
+
+#include "Pathfinding/AStarSearch.h"
+#include "Pathfinding/DStarLite.h"
+
+namespace
+{
+	constexpr int EDIT_COUNT = 250;
+	// 이 간격마다 시작 셀을 경로를 따라 두 칸 옮긴다.
+	constexpr int MOVE_INTERVAL = 10;
+
+	int RunReplans(int size, EHeuristicMethod::Type method, uint32_t seed)
+	{
+		Grid grid = MakeRandomGrid(size, 0.25f, seed);
+		std::mt19937 random(seed);
+		GridPosition start = {0, 0};
+		const GridPosition end = {size - 1, size - 1};
+		grid.SetTileType(start.Row, start.Column, ETileType::Path);
+		grid.SetTileType(end.Row, end.Column, ETileType::Path);
+
+		DStarLite dstar(grid);
+		AStarSearch astar(grid);
+		PathResult replanned;
+		PathResult fresh;
+		dstar.Reset(start, end, method);
+		dstar.Run();
+		dstar.BuildPath(replanned);
+
+		int replanCount = 0;
+		for (int edit = 0; edit < EDIT_COUNT; ++edit)
+		{
+			// 절반은 지금 경로 위의 셀을 바꿔 수리가 실제로 일어나게 한다.
+			GridPosition cell;
+			if (replanned.bFound && random() % 2 == 0)
+			{
+				cell = replanned.Cells[random() % replanned.Cells.size()];
+			}
+			else
+			{
+				cell = {static_cast<int>(random() % size), static_cast<int>(random() % size)};
+			}
+			if (cell == start || cell == end)
+			{
+				continue;
+			}
+
+			// 벽을 세우거나 허물고, 가끔 지형 비용을 바꾼다.
+			ETileType type = grid.IsWalkable(cell.Row, cell.Column) ? ETileType::Wall : ETileType::Path;
+			if (random() % 4 == 0)
+			{
+				const ETileType terrains[] = {ETileType::Path, ETileType::Swamp, ETileType::Water};
+				type = terrains[random() % 3];
+			}
+			grid.SetTileType(cell.Row, cell.Column, type);
+			dstar.OnTileChanged(cell.Row, cell.Column);
+			dstar.Run();
+			dstar.BuildPath(replanned);
+
+			astar.Reset(start, end, method);
+			astar.Run(fresh);
+			const PathQuery query = {start, end, method};
+			const bool bSame
+				= replanned.bFound == fresh.bFound && (!fresh.bFound || IsSameCost(replanned.Cost, fresh.Cost));
+			if (!bSame)
+			{
+				std::fprintf(stderr, "%s size %d edit %d at (%d,%d): D* Lite found %d cost %f, A* found %d cost %f\n",
+							 EHeuristicMethod::to_string(method), size, edit, cell.Row, cell.Column, replanned.bFound,
+							 replanned.Cost, fresh.bFound, fresh.Cost);
+			}
+			CHECK(bSame);
+			CHECK(IsValidCellPath(grid, query, replanned));
+			++replanCount;
+
+			if (edit % MOVE_INTERVAL == MOVE_INTERVAL - 1 && replanned.bFound && replanned.Cells.size() > 3)
+			{
+				start = replanned.Cells[2];
+				dstar.MoveStart(start);
+				dstar.Run();
+				dstar.BuildPath(replanned);
+			}
+		}
+		return replanCount;
+	}
+} // namespace
+
+int main()
+{
+	int replanCount = 0;
+	for (const EHeuristicMethod::Type method : {EHeuristicMethod::Octile, EHeuristicMethod::Manhattan})
+	{
+		replanCount += RunReplans(48, method, 21);
+		replanCount += RunReplans(96, method, 22);
+	}
+	std::printf("%d replans\n", replanCount);
+	return FinishTest("DStarLiteTest");
+}
@@ -0,0 +1,92 @@
+// 행/열 비트보드를 처음 쓸 때 만들고, 만들기 전후의 타일 변경과 복사가 비트보드에 제대로 반영되는지 확인한다.
+#include "TestUtils.h"
+
+#include <thread>
+
+namespace
+{
+	constexpr int MAP_SIZE = 200;
+
+	// 비트보드의 모든 칸이 Grid의 비트와 같은지
+	bool MatchesBits(const Grid& grid)
+	{
+		const GridBitboard& bitboard = grid.GetBitboard();
+		for (int row = 0; row < grid.GetRowCount(); ++row)
+		{
+			for (int column = 0; column < grid.GetColumnCount(); ++column)
+			{
+				if (bitboard.IsWalkable(row, column) != grid.IsWalkable(row, column))
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+} // namespace
+
+int main()
+{
+	Grid grid = MakeRandomGrid(MAP_SIZE, PathfindingConfig::WALL_DENSITY, 51);
+	const size_t bitBytes = Grid::GetWordCount(MAP_SIZE, MAP_SIZE) * sizeof(uint64_t);
+	// 만들기 전에는 비트만 차지한다.
+	CHECK(grid.GetMemoryUsage() == bitBytes);
+
+	// 만들기 전의 변경은 만들 때 비트에서 읽힌다.
+	grid.SetTileType(10, 10, ETileType::Wall);
+	grid.SetTileType(11, 11, ETileType::Path);
+	const Grid unbuiltCopy = grid;
+	CHECK(unbuiltCopy.GetMemoryUsage() == bitBytes);
+
+	// 여러 스레드가 동시에 처음 써도 한 번만 만들고 모두 같은 결과를 본다.
+	std::vector<GridPosition> targets;
+	for (int i = 0; i < 64; ++i)
+	{
+		targets.push_back({(i * 37) % MAP_SIZE, (i * 91) % MAP_SIZE});
+	}
+	std::vector<std::vector<char>> results(4);
+	std::vector<std::thread> threads;
+	for (std::vector<char>& result : results)
+	{
+		threads.emplace_back(
+			[&grid, &targets, &result]
+			{
+				for (const GridPosition& target : targets)
+				{
+					result.push_back(grid.HasLineOfSight(MAP_SIZE / 2, MAP_SIZE / 2, target.Row, target.Column));
+				}
+			});
+	}
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+	for (const std::vector<char>& result : results)
+	{
+		CHECK(result == results.front());
+	}
+	CHECK(grid.GetMemoryUsage() > bitBytes);
+	CHECK(MatchesBits(grid));
+
+	// 만든 뒤의 변경은 비트보드에 함께 반영된다.
+	grid.SetTileType(20, 30, ETileType::Wall);
+	grid.SetTileType(10, 10, ETileType::Path);
+	CHECK(MatchesBits(grid));
+
+	// 복사본은 만들어진 비트보드를 가져가고, 이후 변경은 서로 영향을 주지 않는다.
+	Grid builtCopy = grid;
+	builtCopy.SetTileType(40, 50, builtCopy.IsWalkable(40, 50) ? ETileType::Wall : ETileType::Path);
+	CHECK(MatchesBits(builtCopy));
+	CHECK(MatchesBits(grid));
+	CHECK(MatchesBits(unbuiltCopy));
+
+	// 크기를 바꾸면 비트보드를 버리고 다시 만든다.
+	grid.Resize(70, 90);
+	const size_t resizedBytes = grid.GetMemoryUsage();
+	grid.SetTileType(69, 89, ETileType::Wall);
+	CHECK(MatchesBits(grid));
+	CHECK(!grid.GetBitboard().IsWalkable(69, 89));
+	CHECK(grid.GetMemoryUsage() > resizedBytes);
+
+	return FinishTest("GridBitboardTest");
+}
@@ -0,0 +1,126 @@
+// 타일을 바꾸며 OnTileChanged로 고친 HPA* 추상 그래프가 새로 Build한 것과 같은 답을 내는지 확인한다.
+// 경로는 A*와 같은 도달 여부에 유효한 셀 경로여야 하고, 비용은 A*보다 작지 않고 허용한 배율 안이어야 한다.
+#include "TestUtils.h"
+
+#include "Pathfinding/AStarSearch.h"
+#include "Pathfinding/HierarchicalPathfinder.h"
+
+namespace
+{
+	constexpr int EDIT_COUNT = 300;
+	// 이 간격마다 새로 Build한 그래프와 비교한다.
+	constexpr int COMPARE_INTERVAL = 25;
+	constexpr int QUERIES_PER_COMPARE = 40;
+	// HPA*는 입구마다 전이 지점을 하나나 둘만 두므로 최적보다 길 수 있다. 경로가 짧을수록 배율이 커지므로
+	// 배율에 클러스터 한 변만큼의 여유를 더한다.
+	constexpr float MAX_COST_RATIO = 1.25f;
+
+	void CheckQueries(const Grid& grid, HierarchicalPathfinder& incremental, int clusterSize, bool bAllowDiagonals,
+					  uint32_t seed, float& worstRatio)
+	{
+		HierarchicalPathfinder fresh(grid, clusterSize);
+		fresh.Build(bAllowDiagonals);
+		CHECK(incremental.GetAbstractNodeCount() == fresh.GetAbstractNodeCount());
+		CHECK(incremental.GetAbstractEdgeCount() == fresh.GetAbstractEdgeCount());
+
+		const EHeuristicMethod::Type method = bAllowDiagonals ? EHeuristicMethod::Octile : EHeuristicMethod::Manhattan;
+		AStarSearch astar(grid);
+		PathResult optimal;
+		for (const PathQuery& query : MakeQueries(grid, QUERIES_PER_COMPARE, method, seed))
+		{
+			const PathResult result = incremental.FindPath(query.Start, query.End);
+			const PathResult rebuilt = fresh.FindPath(query.Start, query.End);
+			astar.Reset(query.Start, query.End, method);
+			astar.Run(optimal);
+
+			const bool bSameAsRebuilt
+				= result.bFound == rebuilt.bFound && (!result.bFound || IsSameCost(result.Cost, rebuilt.Cost));
+			const bool bBounded = result.bFound == optimal.bFound
+								  && (!result.bFound
+									  || (result.Cost >= optimal.Cost - 1e-3f
+										  && result.Cost <= optimal.Cost * MAX_COST_RATIO + clusterSize));
+			if (!bSameAsRebuilt || !bBounded)
+			{
+				std::fprintf(stderr,
+							 "(%d,%d)->(%d,%d): found %d cost %f, rebuilt found %d cost %f, A* found %d cost %f\n",
+							 query.Start.Row, query.Start.Column, query.End.Row, query.End.Column, result.bFound,
+							 result.Cost, rebuilt.bFound, rebuilt.Cost, optimal.bFound, optimal.Cost);
+			}
+			CHECK(bSameAsRebuilt);
+			CHECK(bBounded);
+			CHECK(IsValidCellPath(grid, query, result));
+			CHECK(result.Stats.PathCellCount == static_cast<int>(result.Cells.size()));
+			CHECK(!result.bFound || result.Stats.NodesExpanded > 0);
+			if (result.bFound && optimal.Cost > 0.0f)
+			{
+				worstRatio = std::max(worstRatio, result.Cost / optimal.Cost);
+			}
+		}
+	}
+
+	void RunEdits(int size, int clusterSize, bool bAllowDiagonals, bool bTerrain, uint32_t seed)
+	{
+		Grid grid = MakeRandomGrid(size, 0.2f, seed);
+		std::mt19937 random(seed);
+		HierarchicalPathfinder incremental(grid, clusterSize);
+		incremental.Build(bAllowDiagonals);
+
+		float worstRatio = 1.0f;
+		for (int edit = 0; edit < EDIT_COUNT; ++edit)
+		{
+			// 절반은 클러스터 경계 위의 셀을 바꿔 입구가 다시 만들어지게 한다.
+			int row = static_cast<int>(random() % size);
+			int column = static_cast<int>(random() % size);
+			if (random() % 2 == 0)
+			{
+				row = std::min(size - 1, row / clusterSize * clusterSize + (random() % 2 == 0 ? 0 : clusterSize - 1));
+			}
+			ETileType type = grid.IsWalkable(row, column) ? ETileType::Wall : ETileType::Path;
+			if (bTerrain && random() % 3 == 0)
+			{
+				const ETileType terrains[] = {ETileType::Path, ETileType::Swamp, ETileType::Water};
+				type = terrains[random() % 3];
+			}
+			grid.SetTileType(row, column, type);
+			CHECK(incremental.OnTileChanged(row, column) >= 1);
+
+			if (edit % COMPARE_INTERVAL == COMPARE_INTERVAL - 1)
+			{
+				CheckQueries(grid, incremental, clusterSize, bAllowDiagonals, seed + edit, worstRatio);
+			}
+		}
+		std::printf("size %d cluster %d diagonals %d terrain %d: worst cost ratio %.3f\n", size, clusterSize,
+					bAllowDiagonals, bTerrain, worstRatio);
+	}
+
+	// Build 전이나 Grid 크기가 바뀐 뒤에는 범위를 벗어나지 않고 찾지 못한 결과를 돌려준다.
+	void CheckUnbuilt()
+	{
+		Grid grid = MakeRandomGrid(40, 0.0f, 91);
+		HierarchicalPathfinder pathfinder(grid);
+		CHECK(!pathfinder.IsBuilt());
+		CHECK(!pathfinder.FindPath({0, 0}, {39, 39}).bFound);
+		CHECK(pathfinder.OnTileChanged(5, 5) == 0);
+
+		pathfinder.Build(true);
+		CHECK(pathfinder.IsBuilt());
+		CHECK(pathfinder.FindPath({0, 0}, {39, 39}).bFound);
+		CHECK(!pathfinder.FindPath({0, 0}, {40, 39}).bFound);
+		CHECK(pathfinder.OnTileChanged(-1, 0) == 0);
+
+		grid.Resize(80, 80);
+		CHECK(!pathfinder.IsBuilt());
+		CHECK(!pathfinder.FindPath({0, 0}, {79, 79}).bFound);
+		CHECK(pathfinder.OnTileChanged(70, 70) == 0);
+	}
+} // namespace
+
+int main()
+{
+	CheckUnbuilt();
+	RunEdits(64, 16, true, false, 101);
+	RunEdits(100, 16, true, true, 102);
+	RunEdits(72, 8, true, false, 103);
+	RunEdits(64, 16, false, false, 104);
+	return FinishTest("HierarchicalPathfinderTest");
+}
@@ -0,0 +1,84 @@
+// .pfmap을 저장하고 다시 열어 같은 맵이 되는지, 잘못된 셀 비용이 든 파일을 거절하는지 확인한다.
+#include "TestUtils.h"
+
+#include "Pathfinding/MapFile.h"
+
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <string>
+
+namespace
+{
+	constexpr int MAP_SIZE = 50;
+
+	// 파일의 cellIndex번째 셀 비용을 value로 덮어쓴다.
+	bool OverwriteTileCost(const std::string& path, int cellIndex, float value)
+	{
+		MapFileHeader header = {};
+		std::fstream stream(path, std::ios::binary | std::ios::in | std::ios::out);
+		stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+		stream.seekp(static_cast<std::streamoff>(header.TileCostOffset + cellIndex * sizeof(float)));
+		stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+		return static_cast<bool>(stream);
+	}
+} // namespace
+
+int main()
+{
+	const std::filesystem::path directory = std::filesystem::temp_directory_path();
+	const std::string path = (directory / "PathfindingMapFileTest.pfmap").string();
+
+	Grid grid = MakeRandomGrid(MAP_SIZE, 0.2f, 31);
+	const GridPosition start = {1, 2};
+	const GridPosition end = {MAP_SIZE - 2, MAP_SIZE - 3};
+
+	// 비용 레이어가 없는 맵
+	CHECK(MapFile::Save(path, grid, start, end));
+	{
+		MapFile file;
+		CHECK(file.Open(path));
+		CHECK(file.GetTileCosts() == nullptr);
+		CHECK(file.GetStart() == start && file.GetEnd() == end);
+		const Grid& opened = file.GetGrid();
+		CHECK(!opened.HasTileCosts());
+		for (int index = 0; index < grid.GetCellCount(); ++index)
+		{
+			CHECK(opened.IsWalkable(index) == grid.IsWalkable(index));
+		}
+	}
+
+	// 비용 레이어가 있는 맵
+	grid.SetTileType(3, 4, ETileType::Swamp);
+	grid.SetTileType(5, 6, ETileType::Water);
+	grid.SetTileCost(7, 8, 2.5f);
+	CHECK(MapFile::Save(path, grid, start, end));
+	{
+		MapFile file;
+		CHECK(file.Open(path));
+		const Grid& opened = file.GetGrid();
+		CHECK(opened.HasTileCosts());
+		for (int index = 0; index < grid.GetCellCount(); ++index)
+		{
+			CHECK(opened.GetTileCost(index) == grid.GetTileCost(index));
+		}
+		CHECK(opened.GetTileType(3, 4) == ETileType::Swamp);
+		CHECK(opened.GetTileType(5, 6) == ETileType::Water);
+	}
+
+	// 1보다 작거나 유한하지 않은 비용은 휴리스틱과 Open List 순서를 깨므로 열지 않는다.
+	const float badCosts[] = {0.0f, 0.5f, -1.0f, std::numeric_limits<float>::quiet_NaN(),
+							  std::numeric_limits<float>::infinity()};
+	for (const float badCost : badCosts)
+	{
+		CHECK(MapFile::Save(path, grid, start, end));
+		CHECK(OverwriteTileCost(path, grid.GetCellCount() - 1, badCost));
+		MapFile file;
+		CHECK(!file.Open(path));
+		CHECK(!file.IsOpen());
+		CHECK(!file.GetError().empty());
+	}
+
+	std::filesystem::remove(path);
+	return FinishTest("MapFileTest");
+}
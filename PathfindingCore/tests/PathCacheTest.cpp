@@ -0,0 +1,212 @@
+// 벽과 지형을 바꾼 뒤에도 캐시가 돌려준 경로가 새로 돌린 A*와 JPS와 같은 비용이고 지금 맵에서 유효한지 확인한다.
+// LRU 교체와 세대 검사, 캐시를 공유할 때 적중한 결과의 웨이포인트도 확인한다.
+#include "TestUtils.h"
+
+#include "Pathfinding/AStarSearch.h"
+#include "Pathfinding/BatchPathfinder.h"
+#include "Pathfinding/PathCache.h"
+#include "Pathfinding/PathSmoothing.h"
+#include "Pathfinding/SearchScheduler.h"
+
+namespace
+{
+	constexpr int MAP_SIZE = 64;
+	constexpr int QUERY_COUNT = 30;
+	constexpr int EDIT_COUNT = 200;
+
+	// PathCache::OnTileChanged에 넘기는 셀 비용. 벽은 IMPASSABLE_COST이다.
+	float GetCellCost(const Grid& grid, int row, int column)
+	{
+		if (!grid.IsWalkable(row, column))
+		{
+			return PathfindingConfig::IMPASSABLE_COST;
+		}
+		return grid.GetTileCost(grid.ToIndex(row, column));
+	}
+
+	// 편집마다 모든 쿼리를 캐시에서 찾고, 적중하면 같은 알고리즘으로 새로 돌린 결과와 비교한다.
+	void CheckEdits(uint32_t seed)
+	{
+		Grid grid = MakeRandomGrid(MAP_SIZE, 0.25f, seed);
+		std::mt19937 random(seed);
+		const std::vector<PathQuery> queries = MakeQueries(grid, QUERY_COUNT, EHeuristicMethod::Octile, seed);
+		PathCache cache;
+		AStarSearch astar(grid);
+		AStarSearch jps(grid);
+		jps.SetAlgorithm(ESearchAlgorithm::JumpPointSearch);
+
+		PathResult cached;
+		PathResult fresh;
+		for (int edit = 0; edit < EDIT_COUNT; ++edit)
+		{
+			for (const PathQuery& query : queries)
+			{
+				for (AStarSearch* search : {&astar, &jps})
+				{
+					const ESearchAlgorithm::Type algorithm = search == &jps ? ESearchAlgorithm::JumpPointSearch
+																			  : ESearchAlgorithm::AStar;
+					const bool bHit = cache.Find(query, algorithm, cached);
+					const uint64_t generation = cache.GetGeneration();
+					search->Reset(query.Start, query.End, query.Method);
+					search->Run(fresh);
+					if (!bHit)
+					{
+						cache.Store(query, algorithm, fresh, generation);
+						continue;
+					}
+					const bool bSame
+						= cached.bFound == fresh.bFound && (!fresh.bFound || IsSameCost(cached.Cost, fresh.Cost));
+					if (!bSame)
+					{
+						std::fprintf(stderr,
+									 "%s edit %d (%d,%d)->(%d,%d): cached found %d cost %f, fresh found %d cost %f\n",
+									 ESearchAlgorithm::to_string(algorithm), edit, query.Start.Row, query.Start.Column,
+									 query.End.Row, query.End.Column, cached.bFound, cached.Cost, fresh.bFound,
+									 fresh.Cost);
+					}
+					CHECK(bSame);
+					CHECK(IsValidCellPath(grid, query, cached));
+				}
+			}
+
+			// 절반은 지금 경로 위의 셀을 바꿔 무효화가 실제로 일어나게 한다.
+			GridPosition cell = {static_cast<int>(random() % MAP_SIZE), static_cast<int>(random() % MAP_SIZE)};
+			if (fresh.bFound && random() % 2 == 0)
+			{
+				cell = fresh.Cells[random() % fresh.Cells.size()];
+			}
+			bool bEndpoint = false;
+			for (const PathQuery& query : queries)
+			{
+				bEndpoint = bEndpoint || cell == query.Start || cell == query.End;
+			}
+			if (bEndpoint)
+			{
+				continue;
+			}
+
+			// 앞 절반은 벽만 바꾸고, 뒤 절반에서 지형을 깔아 셀 비용 레이어를 만든다.
+			ETileType type = grid.IsWalkable(cell.Row, cell.Column) ? ETileType::Wall : ETileType::Path;
+			if (edit >= EDIT_COUNT / 2 && random() % 2 == 0)
+			{
+				const ETileType terrains[] = {ETileType::Path, ETileType::Swamp, ETileType::Water};
+				type = terrains[random() % 3];
+			}
+			const bool bHadTileCosts = grid.HasTileCosts();
+			const float oldCost = GetCellCost(grid, cell.Row, cell.Column);
+			grid.SetTileType(cell.Row, cell.Column, type);
+			if (!bHadTileCosts && grid.HasTileCosts())
+			{
+				cache.InvalidateAll();
+			}
+			else
+			{
+				cache.OnTileChanged(cell.Row, cell.Column, oldCost, GetCellCost(grid, cell.Row, cell.Column));
+			}
+		}
+		CHECK(grid.HasTileCosts());
+		const PathCacheCounters counters = cache.GetCounters();
+		CHECK(counters.Hits > 0);
+		CHECK(counters.Invalidations > 0);
+		std::printf("seed %u: %llu hits, %llu misses, %llu invalidations\n", seed,
+					static_cast<unsigned long long>(counters.Hits), static_cast<unsigned long long>(counters.Misses),
+					static_cast<unsigned long long>(counters.Invalidations));
+	}
+
+	void CheckEviction()
+	{
+		const Grid grid = MakeRandomGrid(MAP_SIZE, 0.1f, 61);
+		const std::vector<PathQuery> queries = MakeQueries(grid, 4, EHeuristicMethod::Octile, 61);
+		AStarSearch astar(grid);
+		std::vector<PathResult> results(queries.size());
+		for (size_t i = 0; i < queries.size(); ++i)
+		{
+			astar.Reset(queries[i].Start, queries[i].End, queries[i].Method);
+			astar.Run(results[i]);
+		}
+
+		PathCache cache(3);
+		PathResult result;
+		for (int i = 0; i < 3; ++i)
+		{
+			cache.Store(queries[i], ESearchAlgorithm::AStar, results[i], cache.GetGeneration());
+		}
+		// 0을 최근에 쓴 것으로 만들면 다음 저장은 1을 버린다.
+		CHECK(cache.Find(queries[0], ESearchAlgorithm::AStar, result));
+		CHECK(result.Cost == results[0].Cost && result.Cells == results[0].Cells);
+		cache.Store(queries[3], ESearchAlgorithm::AStar, results[3], cache.GetGeneration());
+		CHECK(!cache.Find(queries[1], ESearchAlgorithm::AStar, result));
+		CHECK(cache.Find(queries[2], ESearchAlgorithm::AStar, result));
+		CHECK(cache.Find(queries[3], ESearchAlgorithm::AStar, result));
+		// 알고리즘이 다르면 다른 항목이다.
+		CHECK(!cache.Find(queries[0], ESearchAlgorithm::JumpPointSearch, result));
+
+		// 탐색 중에 맵이 바뀐 결과는 저장하지 않는다.
+		const uint64_t staleGeneration = cache.GetGeneration();
+		cache.InvalidateAll();
+		cache.Store(queries[0], ESearchAlgorithm::AStar, results[0], staleGeneration);
+		CHECK(!cache.Find(queries[0], ESearchAlgorithm::AStar, result));
+
+		const PathCacheCounters counters = cache.GetCounters();
+		CHECK(counters.Hits == 3);
+		CHECK(counters.Misses == 3);
+		CHECK(counters.Evictions == 1);
+		CHECK(counters.Invalidations == 3);
+		CHECK(counters.RejectedStores == 1);
+		CHECK(counters.EntryCount == 0);
+	}
+
+	// 웨이포인트 없이 채운 캐시를 웨이포인트를 만드는 BatchPathfinder와 SearchScheduler가 함께 쓴다.
+	void CheckSharedWaypoints()
+	{
+		const Grid grid = MakeRandomGrid(MAP_SIZE, 0.2f, 71);
+		const std::vector<PathQuery> queries = MakeQueries(grid, QUERY_COUNT, EHeuristicMethod::Octile, 71);
+		PathCache cache;
+		std::vector<PathResult> plainResults;
+		BatchPathfinder plain(grid, 2);
+		plain.SetCache(&cache);
+		plain.Run(queries, plainResults);
+
+		std::vector<PathResult> expected = plainResults;
+		for (PathResult& result : expected)
+		{
+			CHECK(result.Waypoints.empty());
+			BuildWaypoints(grid, result);
+		}
+
+		std::vector<PathResult> results;
+		BatchPathfinder batch(grid, 2);
+		batch.SetCache(&cache);
+		batch.SetBuildWaypoints(true);
+		const uint64_t hitsBefore = cache.GetCounters().Hits;
+		batch.Run(queries, results);
+		CHECK(cache.GetCounters().Hits - hitsBefore == queries.size());
+		for (size_t i = 0; i < queries.size(); ++i)
+		{
+			CHECK(results[i].Waypoints == expected[i].Waypoints);
+			CHECK(!results[i].bFound || !results[i].Waypoints.empty());
+		}
+
+		SearchScheduler scheduler(grid);
+		scheduler.SetCache(&cache);
+		scheduler.SetBuildWaypoints(true);
+		PathResult result;
+		for (size_t i = 0; i < queries.size(); ++i)
+		{
+			const int handle = scheduler.Submit(queries[i]);
+			CHECK(scheduler.GetState(handle) == ESearchRequestState::Finished);
+			scheduler.GetResult(handle, result);
+			CHECK(result.Waypoints == expected[i].Waypoints);
+			scheduler.Release(handle);
+		}
+	}
+} // namespace
+
+int main()
+{
+	CheckEdits(81);
+	CheckEdits(82);
+	CheckEviction();
+	CheckSharedWaypoints();
+	return FinishTest("PathCacheTest");
+}
@@ -0,0 +1,96 @@
+// 같은 쿼리에서 A*(휴리스틱마다), JPS, 양방향 A*(직렬, 병렬)가 다익스트라와 같은 비용을 찾는지 확인한다.
+// 찾은 셀 경로는 모두 이어져 있고 코너를 자르지 않아야 한다.
+#include "TestUtils.h"
+
+#include "Pathfinding/AStarSearch.h"
+#include "Pathfinding/BidirectionalSearch.h"
+
+namespace
+{
+	struct MapCase
+	{
+		int Size;
+		float Density;
+		uint32_t Seed;
+	};
+
+	// 벽이 많을수록 도달할 수 없는 쿼리와 JPS의 강제 이웃이 늘어난다.
+	constexpr MapCase MAP_CASES[] = {
+		{64, 0.1f, 11}, {64, 0.3f, 12}, {96, 0.4f, 13}, {128, 0.2f, 14}, {128, 0.3f, 15}, {160, 0.35f, 16},
+	};
+	constexpr int QUERIES_PER_MAP = 100;
+
+	void CheckMatches(const Grid& grid, const PathQuery& query, const PathResult& reference, const PathResult& result,
+					  const char* name)
+	{
+		const bool bSame
+			= result.bFound == reference.bFound && (!result.bFound || IsSameCost(result.Cost, reference.Cost));
+		if (!bSame)
+		{
+			std::fprintf(stderr, "%s (%d,%d)->(%d,%d) %s: found %d cost %f, expected found %d cost %f\n", name,
+						 query.Start.Row, query.Start.Column, query.End.Row, query.End.Column,
+						 EHeuristicMethod::to_string(query.Method), result.bFound, result.Cost, reference.bFound,
+						 reference.Cost);
+		}
+		CHECK(bSame);
+		CHECK(IsValidCellPath(grid, query, result));
+	}
+} // namespace
+
+int main()
+{
+	int queryCount = 0;
+	for (const MapCase& mapCase : MAP_CASES)
+	{
+		const Grid grid = MakeRandomGrid(mapCase.Size, mapCase.Density, mapCase.Seed);
+		AStarSearch dijkstra(grid);
+		AStarSearch astar(grid);
+		AStarSearch jps(grid);
+		jps.SetAlgorithm(ESearchAlgorithm::JumpPointSearch);
+		BidirectionalSearch bidirectional(grid);
+		BidirectionalSearch parallelBidirectional(grid);
+		parallelBidirectional.SetParallel(true);
+
+		PathResult reference;
+		PathResult result;
+		const std::vector<PathQuery> queries
+			= MakeQueries(grid, QUERIES_PER_MAP, EHeuristicMethod::Octile, mapCase.Seed);
+		for (PathQuery query : queries)
+		{
+			++queryCount;
+			dijkstra.Reset(query.Start, query.End, EHeuristicMethod::None);
+			dijkstra.Run(reference);
+			CHECK(IsValidCellPath(grid, query, reference));
+
+			// Manhattan은 4방향 이동이라 비용이 다르므로 8방향 휴리스틱끼리 비교한다.
+			for (const EHeuristicMethod::Type method : {EHeuristicMethod::Euclidean, EHeuristicMethod::Octile})
+			{
+				query.Method = method;
+				astar.Reset(query.Start, query.End, method);
+				astar.Run(result);
+				CheckMatches(grid, query, reference, result, "AStar");
+
+				jps.Reset(query.Start, query.End, method);
+				CHECK(jps.GetActiveAlgorithm() == ESearchAlgorithm::JumpPointSearch);
+				jps.Run(result);
+				CheckMatches(grid, query, reference, result, "JumpPointSearch");
+
+				bidirectional.Reset(query.Start, query.End, method);
+				bidirectional.Run(result);
+				CheckMatches(grid, query, reference, result, "Bidirectional");
+
+				parallelBidirectional.Reset(query.Start, query.End, method);
+				parallelBidirectional.Run(result);
+				CheckMatches(grid, query, reference, result, "Bidirectional (parallel)");
+			}
+
+			// JPS는 None에서도 점프하므로 다익스트라와 같은 비용이어야 한다.
+			query.Method = EHeuristicMethod::None;
+			jps.Reset(query.Start, query.End, EHeuristicMethod::None);
+			jps.Run(result);
+			CheckMatches(grid, query, reference, result, "JumpPointSearch");
+		}
+	}
+	std::printf("%d queries\n", queryCount);
+	return FinishTest("SearchEquivalenceTest");
+}
@@ -0,0 +1,125 @@
+#pragma once
+#include "Pathfinding/CostFunctions.h"
+#include "Pathfinding/Grid.h"
+#include "Pathfinding/PathResult.h"
+#include "Pathfinding/PathfindingTypes.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// 테스트 실행 파일이 함께 쓰는 도구. 실패한 CHECK는 바로 출력하고 세어 두며, main은 FinishTest의 값으로 끝난다.
+
+inline int& GetFailureCount()
+{
+	static int failureCount = 0;
+	return failureCount;
+}
+
+inline void ReportFailure(const char* file, int line, const char* expression)
+{
+	std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", file, line, expression);
+	++GetFailureCount();
+}
+
+#define CHECK(expression)                                                                                              \
+	do                                                                                                                 \
+	{                                                                                                                  \
+		if (!(expression))                                                                                             \
+		{                                                                                                              \
+			ReportFailure(__FILE__, __LINE__, #expression);                                                            \
+		}                                                                                                              \
+	} while (false)
+
+inline int FinishTest(const char* name)
+{
+	if (GetFailureCount() != 0)
+	{
+		std::fprintf(stderr, "%s: %d check(s) failed\n", name, GetFailureCount());
+		return 1;
+	}
+	std::printf("%s: OK\n", name);
+	return 0;
+}
+
+// 같은 시드면 같은 맵이다.
+inline Grid MakeRandomGrid(int size, float density, uint32_t seed)
+{
+	Grid grid(size, size);
+	grid.GenerateRandomWalls(density, seed);
+	return grid;
+}
+
+// 통과 가능한 셀 사이의 쿼리. 도달할 수 없는 쿼리도 섞여 있다.
+inline std::vector<PathQuery> MakeQueries(const Grid& grid, int count, EHeuristicMethod::Type method, uint32_t seed)
+{
+	std::mt19937 random(seed);
+	auto pickWalkableCell = [&]()
+	{
+		while (true)
+		{
+			const int row = static_cast<int>(random() % grid.GetRowCount());
+			const int column = static_cast<int>(random() % grid.GetColumnCount());
+			if (grid.IsWalkable(row, column))
+			{
+				return GridPosition{row, column};
+			}
+		}
+	};
+
+	std::vector<PathQuery> queries;
+	queries.reserve(count);
+	for (int i = 0; i < count; ++i)
+	{
+		const GridPosition start = pickWalkableCell();
+		queries.push_back({start, pickWalkableCell(), method});
+	}
+	return queries;
+}
+
+// 합하는 순서가 다른 두 경로 비용을 비교한다.
+inline bool IsSameCost(float a, float b)
+{
+	return std::fabs(a - b) <= 1e-3f + 1e-5f * std::max(std::fabs(a), std::fabs(b));
+}
+
+// Cells가 query의 시작에서 도착까지 이어지는 통과 가능한 셀이고, 대각선은 코너를 자르지 않으며,
+// 셀 사이 이동 비용(WeightedCostModel과 같은 식)의 합이 Cost와 같은지.
+inline bool IsValidCellPath(const Grid& grid, const PathQuery& query, const PathResult& result)
+{
+	if (!result.bFound)
+	{
+		return result.Cells.empty();
+	}
+	if (result.Cells.empty() || !(result.Cells.front() == query.Start) || !(result.Cells.back() == query.End))
+	{
+		return false;
+	}
+	float cost = 0.0f;
+	for (size_t i = 1; i < result.Cells.size(); ++i)
+	{
+		const GridPosition& from = result.Cells[i - 1];
+		const GridPosition& to = result.Cells[i];
+		const int deltaRow = to.Row - from.Row;
+		const int deltaColumn = to.Column - from.Column;
+		if (std::abs(deltaRow) > 1 || std::abs(deltaColumn) > 1 || (deltaRow == 0 && deltaColumn == 0)
+			|| !grid.IsWalkable(to.Row, to.Column))
+		{
+			return false;
+		}
+		const bool bDiagonal = deltaRow != 0 && deltaColumn != 0;
+		if (bDiagonal && (!grid.IsWalkable(from.Row + deltaRow, from.Column) || !grid.IsWalkable(from.Row, to.Column)))
+		{
+			return false;
+		}
+		const float fromCost = grid.GetTileCost(grid.ToIndex(from.Row, from.Column));
+		const float toCost = grid.GetTileCost(grid.ToIndex(to.Row, to.Column));
+		cost += (bDiagonal ? PathfindingConfig::DIAGONAL_COST : PathfindingConfig::ORTHOGONAL_COST)
+				* (fromCost + toCost) * 0.5f;
+	}
+	return IsSameCost(cost, result.Cost);
+}
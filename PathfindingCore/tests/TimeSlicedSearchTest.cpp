@@ -0,0 +1,217 @@
+// 탐색을 잘게 나눠 진행해도 한 번에 Run한 것과 같은 답이 나오는지 확인한다.
+// AStarSearch::Advance를 노드 예산 1과 7로 반복한 결과, 그리고 실행 슬롯보다 많은 요청을 작은 조각으로 돌리며
+// 중간에 Release, 다시 Submit, Reserve를 섞은 SearchScheduler의 결과를 모두 Run과 비교한다.
+#include "TestUtils.h"
+
+#include "Pathfinding/AStarSearch.h"
+#include "Pathfinding/SearchScheduler.h"
+
+namespace
+{
+	constexpr int MAP_SIZE = 64;
+	constexpr int QUERY_COUNT = 40;
+	constexpr int ACTIVE_COUNT = 3;
+	constexpr int SLICE_NODE_COUNT = 5;
+	constexpr int UPDATE_NODE_BUDGET = 40;
+
+	struct SearchConfig
+	{
+		ESearchAlgorithm::Type Algorithm = ESearchAlgorithm::AStar;
+		EOpenListType::Type OpenListType = EOpenListType::BinaryHeap;
+		EHeuristicMethod::Type Method = EHeuristicMethod::Octile;
+	};
+
+	// 같은 Step을 같은 순서로 실행하므로 비용은 합하는 순서까지 같아 정확히 일치해야 한다.
+	bool IsSameResult(const PathResult& a, const PathResult& b)
+	{
+		return a.bFound == b.bFound && a.Cost == b.Cost && a.Cells == b.Cells && a.Waypoints == b.Waypoints;
+	}
+
+	std::vector<PathResult> RunAll(const Grid& grid, const SearchConfig& config, const std::vector<PathQuery>& queries)
+	{
+		AStarSearch search(grid);
+		search.SetAlgorithm(config.Algorithm);
+		search.SetOpenListType(config.OpenListType);
+		std::vector<PathResult> results(queries.size());
+		for (size_t i = 0; i < queries.size(); ++i)
+		{
+			search.Reset(queries[i].Start, queries[i].End, queries[i].Method);
+			search.Run(results[i]);
+		}
+		return results;
+	}
+
+	void CheckAdvance(const Grid& grid, const SearchConfig& config, const std::vector<PathQuery>& queries,
+					  const std::vector<PathResult>& expected)
+	{
+		AStarSearch search(grid);
+		search.SetAlgorithm(config.Algorithm);
+		search.SetOpenListType(config.OpenListType);
+		PathResult result;
+		for (const int nodeBudget : {1, 7})
+		{
+			for (size_t i = 0; i < queries.size(); ++i)
+			{
+				search.Reset(queries[i].Start, queries[i].End, queries[i].Method);
+				int expandedCount = 0;
+				while (!search.IsFinished())
+				{
+					const int expanded = search.Advance({nodeBudget, {}});
+					CHECK(expanded <= nodeBudget);
+					expandedCount += expanded;
+				}
+				// 끝난 뒤의 Advance는 아무것도 하지 않는다.
+				CHECK(search.Advance({nodeBudget, {}}) == 0);
+				search.BuildPath(result);
+				const bool bSame = IsSameResult(result, expected[i]);
+				if (!bSame)
+				{
+					std::fprintf(stderr, "%s %s budget %d (%d,%d)->(%d,%d): found %d cost %f, Run found %d cost %f\n",
+								 ESearchAlgorithm::to_string(config.Algorithm),
+								 EOpenListType::to_string(config.OpenListType), nodeBudget, queries[i].Start.Row,
+								 queries[i].Start.Column, queries[i].End.Row, queries[i].End.Column, result.bFound,
+								 result.Cost, expected[i].bFound, expected[i].Cost);
+				}
+				CHECK(bSame);
+				CHECK(result.Stats.NodesExpanded == expected[i].Stats.NodesExpanded);
+				CHECK(expandedCount == result.Stats.NodesExpanded);
+			}
+		}
+	}
+
+	// 슬롯보다 많은 요청을 넣고, 진행 중에 일부를 취소했다가 다시 넣는다. 취소한 요청의 탐색 객체와 핸들은
+	// 다른 요청이 이어 쓰므로 남은 상태가 섞이면 결과가 달라진다.
+	void CheckScheduler(const Grid& grid, const SearchConfig& config, const std::vector<PathQuery>& queries,
+						const std::vector<PathResult>& expected, uint32_t seed)
+	{
+		std::mt19937 random(seed);
+		SearchScheduler scheduler(grid, ACTIVE_COUNT);
+		scheduler.SetAlgorithm(config.Algorithm);
+		scheduler.SetOpenListType(config.OpenListType);
+		scheduler.SetSliceNodeCount(SLICE_NODE_COUNT);
+
+		// handles[i]는 queries[i]의 지금 핸들
+		std::vector<int> handles(queries.size());
+		for (size_t i = 0; i < queries.size(); ++i)
+		{
+			handles[i] = scheduler.Submit(queries[i]);
+		}
+		CHECK(scheduler.GetRunningCount() <= ACTIVE_COUNT);
+		CHECK(scheduler.GetQueuedCount() >= static_cast<int>(queries.size()) - ACTIVE_COUNT);
+
+		int releaseCount = 0;
+		int runningReleaseCount = 0;
+		PathResult result;
+		for (int update = 0; update < 100000; ++update)
+		{
+			bool bAllFinished = true;
+			for (const int handle : handles)
+			{
+				bAllFinished = bAllFinished && scheduler.GetState(handle) == ESearchRequestState::Finished;
+			}
+			if (bAllFinished)
+			{
+				break;
+			}
+
+			if (update % 3 == 1)
+			{
+				// 끝나지 않은 요청 하나를 취소하고 다시 넣는다.
+				const size_t i = random() % queries.size();
+				const ESearchRequestState state = scheduler.GetState(handles[i]);
+				if (state != ESearchRequestState::Finished)
+				{
+					runningReleaseCount += state == ESearchRequestState::Running ? 1 : 0;
+					scheduler.Release(handles[i]);
+					CHECK(scheduler.GetState(handles[i]) == ESearchRequestState::Invalid);
+					handles[i] = scheduler.Submit(queries[i]);
+					++releaseCount;
+				}
+			}
+			if (update == 10)
+			{
+				// 탐색 중에 미리 할당해도 실행 중인 요청은 그대로 이어 간다.
+				scheduler.Reserve();
+			}
+
+			const int expanded = scheduler.Update({UPDATE_NODE_BUDGET, {}});
+			// 마지막 조각은 남은 예산만큼으로 줄인다.
+			CHECK(expanded <= UPDATE_NODE_BUDGET);
+			CHECK(scheduler.GetRunningCount() <= ACTIVE_COUNT);
+			for (int running = 0; running < ACTIVE_COUNT && update % 5 == 0; ++running)
+			{
+				// 실행 중인 요청의 부분 경로는 시작에서 출발한다.
+				const size_t i = random() % queries.size();
+				if (scheduler.GetState(handles[i]) == ESearchRequestState::Running)
+				{
+					scheduler.GetResult(handles[i], result);
+					CHECK(!result.bFound);
+					CHECK(!result.bPartial || (!result.Cells.empty() && result.Cells.front() == queries[i].Start));
+				}
+			}
+		}
+		CHECK(releaseCount > 0);
+		CHECK(runningReleaseCount > 0);
+
+		for (size_t i = 0; i < queries.size(); ++i)
+		{
+			CHECK(scheduler.GetState(handles[i]) == ESearchRequestState::Finished);
+			scheduler.GetResult(handles[i], result);
+			const bool bSame = IsSameResult(result, expected[i]);
+			if (!bSame)
+			{
+				std::fprintf(stderr, "%s %s scheduler (%d,%d)->(%d,%d): found %d cost %f, Run found %d cost %f\n",
+							 ESearchAlgorithm::to_string(config.Algorithm),
+							 EOpenListType::to_string(config.OpenListType), queries[i].Start.Row,
+							 queries[i].Start.Column, queries[i].End.Row, queries[i].End.Column, result.bFound,
+							 result.Cost, expected[i].bFound, expected[i].Cost);
+			}
+			CHECK(bSame);
+			CHECK(scheduler.GetStats(handles[i]).NodesExpanded == expected[i].Stats.NodesExpanded);
+			scheduler.Release(handles[i]);
+		}
+		CHECK(scheduler.GetQueuedCount() == 0 && scheduler.GetRunningCount() == 0);
+	}
+
+	void RunConfig(const Grid& grid, const SearchConfig& config, uint32_t seed)
+	{
+		const std::vector<PathQuery> queries = MakeQueries(grid, QUERY_COUNT, config.Method, seed);
+		const std::vector<PathResult> expected = RunAll(grid, config, queries);
+		CheckAdvance(grid, config, queries, expected);
+		CheckScheduler(grid, config, queries, expected, seed);
+	}
+} // namespace
+
+int main()
+{
+	Grid grid = MakeRandomGrid(MAP_SIZE, 0.25f, 301);
+	const SearchConfig configs[] = {
+		{ESearchAlgorithm::AStar, EOpenListType::BinaryHeap, EHeuristicMethod::Octile},
+		{ESearchAlgorithm::AStar, EOpenListType::PriorityQueue, EHeuristicMethod::Octile},
+		{ESearchAlgorithm::AStar, EOpenListType::BucketQueue, EHeuristicMethod::Manhattan},
+		{ESearchAlgorithm::JumpPointSearch, EOpenListType::QuaternaryHeap, EHeuristicMethod::Octile},
+		{ESearchAlgorithm::ThetaStar, EOpenListType::BinaryHeap, EHeuristicMethod::Octile},
+		{ESearchAlgorithm::LazyThetaStar, EOpenListType::BinaryHeap, EHeuristicMethod::Octile},
+	};
+	uint32_t seed = 310;
+	for (const SearchConfig& config : configs)
+	{
+		RunConfig(grid, config, seed++);
+	}
+
+	// 셀 비용 레이어가 있으면 WeightedCostModel로 확장한다.
+	std::mt19937 random(302);
+	for (int i = 0; i < MAP_SIZE * MAP_SIZE / 4; ++i)
+	{
+		const int row = static_cast<int>(random() % MAP_SIZE);
+		const int column = static_cast<int>(random() % MAP_SIZE);
+		if (grid.IsWalkable(row, column))
+		{
+			grid.SetTileType(row, column, random() % 2 == 0 ? ETileType::Swamp : ETileType::Water);
+		}
+	}
+	CHECK(grid.HasTileCosts());
+	RunConfig(grid, configs[0], seed++);
+	RunConfig(grid, configs[1], seed++);
+	return FinishTest("TimeSlicedSearchTest");
+}
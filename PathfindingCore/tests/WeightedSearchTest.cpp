@@ -0,0 +1,114 @@
+// 셀 비용 레이어가 있는 맵에서 휴리스틱과 Open List를 바꾼 A*와 양방향 A*가 다익스트라와 같은 비용을 찾는지 확인한다.
+// 비용이 1 이상이므로 모든 8방향 휴리스틱은 과대평가하지 않아야 한다.
+#include "TestUtils.h"
+
+#include "Pathfinding/AStarSearch.h"
+#include "Pathfinding/BidirectionalSearch.h"
+#include "Pathfinding/LandmarkTable.h"
+
+#include <utility>
+
+namespace
+{
+	constexpr int QUERIES_PER_MAP = 60;
+
+	// 벽 사이에 늪과 물을 덩어리로 깔고 임의 비용 셀을 섞는다.
+	Grid MakeTerrainGrid(int size, uint32_t seed)
+	{
+		Grid grid = MakeRandomGrid(size, 0.2f, seed);
+		std::mt19937 random(seed);
+		for (int patch = 0; patch < size / 2; ++patch)
+		{
+			const int centerRow = static_cast<int>(random() % size);
+			const int centerColumn = static_cast<int>(random() % size);
+			const int radius = 1 + static_cast<int>(random() % 6);
+			const ETileType type = random() % 2 == 0 ? ETileType::Swamp : ETileType::Water;
+			for (int row = std::max(0, centerRow - radius); row <= std::min(size - 1, centerRow + radius); ++row)
+			{
+				for (int column = std::max(0, centerColumn - radius);
+					 column <= std::min(size - 1, centerColumn + radius); ++column)
+				{
+					if (grid.IsWalkable(row, column))
+					{
+						grid.SetTileType(row, column, type);
+					}
+				}
+			}
+		}
+		for (int i = 0; i < size * 4; ++i)
+		{
+			const int row = static_cast<int>(random() % size);
+			const int column = static_cast<int>(random() % size);
+			if (grid.IsWalkable(row, column))
+			{
+				grid.SetTileCost(row, column, 1.0f + static_cast<float>(random() % 1000) / 100.0f);
+			}
+		}
+		return grid;
+	}
+
+	void CheckMatches(const Grid& grid, const PathQuery& query, const PathResult& reference, const PathResult& result,
+					  const char* name, const char* openList)
+	{
+		const bool bSame
+			= result.bFound == reference.bFound && (!result.bFound || IsSameCost(result.Cost, reference.Cost));
+		if (!bSame)
+		{
+			std::fprintf(stderr, "%s %s (%d,%d)->(%d,%d) %s: found %d cost %f, expected found %d cost %f\n", name,
+						 openList, query.Start.Row, query.Start.Column, query.End.Row, query.End.Column,
+						 EHeuristicMethod::to_string(query.Method), result.bFound, result.Cost, reference.bFound,
+						 reference.Cost);
+		}
+		CHECK(bSame);
+		CHECK(IsValidCellPath(grid, query, result));
+	}
+} // namespace
+
+int main()
+{
+	int queryCount = 0;
+	for (const auto& [size, seed] : {std::pair{64, 41u}, std::pair{128, 42u}, std::pair{160, 43u}})
+	{
+		const Grid grid = MakeTerrainGrid(size, seed);
+		CHECK(grid.HasTileCosts());
+		LandmarkTable landmarks;
+		landmarks.Build(grid);
+
+		AStarSearch dijkstra(grid);
+		AStarSearch astar(grid);
+		astar.SetLandmarks(&landmarks);
+		BidirectionalSearch bidirectional(grid);
+
+		PathResult reference;
+		PathResult result;
+		const std::vector<PathQuery> queries = MakeQueries(grid, QUERIES_PER_MAP, EHeuristicMethod::Octile, seed);
+		for (PathQuery query : queries)
+		{
+			++queryCount;
+			dijkstra.Reset(query.Start, query.End, EHeuristicMethod::None);
+			dijkstra.Run(reference);
+			CHECK(IsValidCellPath(grid, query, reference));
+
+			for (const EHeuristicMethod::Type method :
+				 {EHeuristicMethod::Euclidean, EHeuristicMethod::Octile, EHeuristicMethod::ALT})
+			{
+				query.Method = method;
+				for (int type = 0; type < EOpenListType::NUM_TYPES; ++type)
+				{
+					const auto openListType = static_cast<EOpenListType::Type>(type);
+					astar.SetOpenListType(openListType);
+					astar.Reset(query.Start, query.End, method);
+					astar.Run(result);
+					CheckMatches(grid, query, reference, result, "AStar", EOpenListType::to_string(openListType));
+				}
+
+				// ALT는 양방향 탐색에서 Octile로 동작한다.
+				bidirectional.Reset(query.Start, query.End, method);
+				bidirectional.Run(result);
+				CheckMatches(grid, query, reference, result, "Bidirectional", "");
+			}
+		}
+	}
+	std::printf("%d queries\n", queryCount);
+	return FinishTest("WeightedSearchTest");
+}
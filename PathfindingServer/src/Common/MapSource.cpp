@@ -0,0 +1,58 @@
+#include "MapSource.h"
+
+#include "Pathfinding/MovingAIFormat.h"
+#include "Pathfinding/PathfindingTypes.h"
+
+#include <cstdlib>
+#include <utility>
+
+namespace
+{
+	constexpr char RANDOM_PREFIX[] = "random:";
+	// 프로토콜의 좌표는 uint16이다.
+	constexpr int MAX_MAP_SIZE = 65536;
+
+	bool EndsWith(const std::string& value, const std::string& suffix)
+	{
+		return value.size() >= suffix.size() && value.compare(value.size() - suffix.size(), suffix.size(), suffix) == 0;
+	}
+} // namespace
+
+bool LoadMapSource(const std::string& source, uint32_t seed, MapFile& file, Grid& grid, std::string& error)
+{
+	if (source.rfind(RANDOM_PREFIX, 0) == 0)
+	{
+		const int size = std::atoi(source.c_str() + sizeof(RANDOM_PREFIX) - 1);
+		if (size <= 2 || size > MAX_MAP_SIZE)
+		{
+			error = "invalid random map size: " + source;
+			return false;
+		}
+		grid.Resize(size, size);
+		grid.GenerateRandomWalls(PathfindingConfig::WALL_DENSITY, seed);
+		return true;
+	}
+	if (EndsWith(source, ".map"))
+	{
+		if (!LoadMovingAIMap(source, grid, error))
+		{
+			return false;
+		}
+	}
+	else
+	{
+		if (!file.Open(source))
+		{
+			error = file.GetError();
+			return false;
+		}
+		// 복사하지 않고 옮겨 와 파일의 메모리를 그대로 가리킨다.
+		grid = std::move(file.GetGrid());
+	}
+	if (grid.GetRowCount() > MAX_MAP_SIZE || grid.GetColumnCount() > MAX_MAP_SIZE)
+	{
+		error = "map is larger than the protocol allows: " + source;
+		return false;
+	}
+	return true;
+}
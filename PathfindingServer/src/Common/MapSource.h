@@ -0,0 +1,14 @@
+#pragma once
+#include "Pathfinding/Grid.h"
+#include "Pathfinding/MapFile.h"
+
+#include <cstdint>
+#include <string>
+
+// 서버와 부하 생성기가 같은 맵을 보도록 맵을 같은 문자열로 지정한다.
+//   path.map       MovingAI 맵
+//   path.pfmap     메모리 맵 파일. grid는 file의 메모리를 가리키므로 file이 grid보다 오래 살아 있어야 한다.
+//                  file의 Grid는 grid로 옮겨지므로 file.GetGrid()는 비어 있다.
+//   random:<n>     n x n 랜덤 벽 맵. 같은 seed면 같은 맵이다.
+// 실패하면 false를 반환하고 error에 이유를 남긴다.
+bool LoadMapSource(const std::string& source, uint32_t seed, MapFile& file, Grid& grid, std::string& error);
@@ -0,0 +1,219 @@
+#include "MessageSocket.h"
+
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+	// Receive 한 번에 늘리는 입력 버퍼 크기
+	constexpr size_t RECEIVE_CHUNK_SIZE = 64 * 1024;
+
+	bool SetNonBlocking(int descriptor)
+	{
+		const int flags = fcntl(descriptor, F_GETFL, 0);
+		return flags >= 0 && fcntl(descriptor, F_SETFL, flags | O_NONBLOCK) == 0;
+	}
+
+	bool MakeAddress(const std::string& path, sockaddr_un& address, std::string& error)
+	{
+		std::memset(&address, 0, sizeof(address));
+		address.sun_family = AF_UNIX;
+		if (path.empty() || path.size() >= sizeof(address.sun_path))
+		{
+			error = "invalid socket path: " + path;
+			return false;
+		}
+		std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+		return true;
+	}
+
+	std::string GetErrorText(const char* what)
+	{
+		return std::string(what) + ": " + std::strerror(errno);
+	}
+} // namespace
+
+MessageSocket::MessageSocket(int descriptor)
+	: descriptor_(descriptor)
+{
+	SetNonBlocking(descriptor_);
+}
+
+MessageSocket::~MessageSocket()
+{
+	Close();
+}
+
+MessageSocket::MessageSocket(MessageSocket&& other) noexcept
+	: descriptor_(std::exchange(other.descriptor_, -1))
+	, receiveBuffer_(std::move(other.receiveBuffer_))
+	, receiveOffset_(std::exchange(other.receiveOffset_, 0))
+	, sendBuffer_(std::move(other.sendBuffer_))
+	, sendOffset_(std::exchange(other.sendOffset_, 0))
+{
+}
+
+MessageSocket& MessageSocket::operator=(MessageSocket&& other) noexcept
+{
+	if (this != &other)
+	{
+		Close();
+		descriptor_ = std::exchange(other.descriptor_, -1);
+		receiveBuffer_ = std::move(other.receiveBuffer_);
+		receiveOffset_ = std::exchange(other.receiveOffset_, 0);
+		sendBuffer_ = std::move(other.sendBuffer_);
+		sendOffset_ = std::exchange(other.sendOffset_, 0);
+	}
+	return *this;
+}
+
+void MessageSocket::Close()
+{
+	if (descriptor_ >= 0)
+	{
+		close(descriptor_);
+		descriptor_ = -1;
+	}
+}
+
+bool MessageSocket::Receive()
+{
+	// 꺼낸 프레임을 앞으로 당겨 버퍼가 계속 자라지 않게 한다.
+	if (receiveOffset_ > 0)
+	{
+		receiveBuffer_.erase(receiveBuffer_.begin(),
+							 receiveBuffer_.begin() + static_cast<std::ptrdiff_t>(receiveOffset_));
+		receiveOffset_ = 0;
+	}
+	while (true)
+	{
+		const size_t size = receiveBuffer_.size();
+		receiveBuffer_.resize(size + RECEIVE_CHUNK_SIZE);
+		const ssize_t received = recv(descriptor_, receiveBuffer_.data() + size, RECEIVE_CHUNK_SIZE, 0);
+		receiveBuffer_.resize(size + (received > 0 ? static_cast<size_t>(received) : 0));
+		if (received > 0)
+		{
+			if (static_cast<size_t>(received) < RECEIVE_CHUNK_SIZE)
+			{
+				return true;
+			}
+			continue;
+		}
+		if (received == 0)
+		{
+			return false;
+		}
+		if (errno == EINTR)
+		{
+			continue;
+		}
+		return errno == EAGAIN || errno == EWOULDBLOCK;
+	}
+}
+
+bool MessageSocket::Flush()
+{
+	while (sendOffset_ < sendBuffer_.size())
+	{
+		// 끊긴 연결에 쓸 때의 SIGPIPE는 main에서 무시한다.
+		const ssize_t sent = send(descriptor_, sendBuffer_.data() + sendOffset_, sendBuffer_.size() - sendOffset_, 0);
+		if (sent > 0)
+		{
+			sendOffset_ += static_cast<size_t>(sent);
+			continue;
+		}
+		if (sent < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+		{
+			return true;
+		}
+		return false;
+	}
+	// 다 보냈으면 용량은 두고 비운다.
+	sendBuffer_.clear();
+	sendOffset_ = 0;
+	return true;
+}
+
+int ListenUnixSocket(const std::string& path, std::string& error)
+{
+	sockaddr_un address;
+	if (!MakeAddress(path, address, error))
+	{
+		return -1;
+	}
+	// 남아 있는 소켓 파일에 연결이 되면 다른 서버가 쓰고 있는 것이다.
+	if (access(path.c_str(), F_OK) == 0)
+	{
+		const int probe = socket(AF_UNIX, SOCK_STREAM, 0);
+		const bool bInUse = probe >= 0 && connect(probe, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+		if (probe >= 0)
+		{
+			close(probe);
+		}
+		if (bInUse)
+		{
+			error = "another server is listening on " + path;
+			return -1;
+		}
+		unlink(path.c_str());
+	}
+
+	const int descriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (descriptor < 0)
+	{
+		error = GetErrorText("socket");
+		return -1;
+	}
+	if (bind(descriptor, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+		|| listen(descriptor, SOMAXCONN) != 0 || !SetNonBlocking(descriptor))
+	{
+		error = GetErrorText("listen");
+		close(descriptor);
+		return -1;
+	}
+	return descriptor;
+}
+
+int ConnectUnixSocket(const std::string& path, std::string& error)
+{
+	sockaddr_un address;
+	if (!MakeAddress(path, address, error))
+	{
+		return -1;
+	}
+	const int descriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (descriptor < 0)
+	{
+		error = GetErrorText("socket");
+		return -1;
+	}
+	if (connect(descriptor, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+	{
+		error = GetErrorText("connect");
+		close(descriptor);
+		return -1;
+	}
+	return descriptor;
+}
+
+int AcceptUnixSocket(int listenDescriptor)
+{
+	while (true)
+	{
+		const int descriptor = accept(listenDescriptor, nullptr, nullptr);
+		if (descriptor >= 0 || errno != EINTR)
+		{
+			return descriptor;
+		}
+	}
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include "Protocol.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 논블로킹 스트림 소켓 하나와 그 입출력 버퍼. 받은 바이트는 프레임 단위로 꺼내고,
+// 보낼 프레임은 GetSendBuffer에 붙인 뒤 Flush가 쓸 수 있는 만큼 내보낸다.
+class MessageSocket
+{
+public:
+	MessageSocket() = default;
+	// descriptor의 소유권을 받아 논블로킹으로 바꾼다.
+	explicit MessageSocket(int descriptor);
+	~MessageSocket();
+	MessageSocket(const MessageSocket&) = delete;
+	MessageSocket& operator=(const MessageSocket&) = delete;
+	MessageSocket(MessageSocket&& other) noexcept;
+	MessageSocket& operator=(MessageSocket&& other) noexcept;
+
+	bool IsOpen() const { return descriptor_ >= 0; }
+	int GetDescriptor() const { return descriptor_; }
+	void Close();
+
+	// 지금 읽을 수 있는 만큼 읽는다. 상대가 닫았거나 오류면 false.
+	bool Receive();
+	// 다 받은 프레임마다 func(const FrameView&)를 호출하고 버퍼에서 뺀다. 잘못된 프레임이 있으면 false.
+	template <typename TFunc>
+	bool ForEachFrame(TFunc&& func)
+	{
+		while (true)
+		{
+			FrameView frame;
+			const EFrameState state
+				= PeekFrame(receiveBuffer_.data() + receiveOffset_, receiveBuffer_.size() - receiveOffset_, frame);
+			if (state == EFrameState::Invalid)
+			{
+				return false;
+			}
+			if (state == EFrameState::Incomplete)
+			{
+				return true;
+			}
+			func(frame);
+			receiveOffset_ += frame.FrameSize;
+		}
+	}
+
+	std::vector<uint8_t>& GetSendBuffer() { return sendBuffer_; }
+	// 지금 쓸 수 있는 만큼 보낸다. 오류면 false.
+	bool Flush();
+	size_t GetPendingSendSize() const { return sendBuffer_.size() - sendOffset_; }
+
+private:
+	int descriptor_ = -1;
+	std::vector<uint8_t> receiveBuffer_;
+	// receiveBuffer_에서 이미 꺼낸 바이트 수. 다음 Receive에서 앞으로 당긴다.
+	size_t receiveOffset_ = 0;
+	std::vector<uint8_t> sendBuffer_;
+	size_t sendOffset_ = 0;
+};
+
+// 실패하면 -1을 반환하고 error에 이유를 남긴다. 반환한 descriptor는 논블로킹이다.
+// 경로에 파일이 남아 있어도 그 소켓에 받는 서버가 없으면 지우고 다시 만든다.
+int ListenUnixSocket(const std::string& path, std::string& error);
+int ConnectUnixSocket(const std::string& path, std::string& error);
+// 대기 중인 연결을 하나 받는다. 없으면 -1.
+int AcceptUnixSocket(int listenDescriptor);
@@ -0,0 +1,227 @@
+#include "Protocol.h"
+
+#include <cstring>
+
+namespace
+{
+	// 호스트 바이트 순서와 상관없이 리틀 엔디언으로 읽고 쓴다.
+	class ByteWriter
+	{
+	public:
+		explicit ByteWriter(std::vector<uint8_t>& buffer)
+			: buffer_(buffer)
+		{
+		}
+
+		void U8(uint8_t value) { buffer_.push_back(value); }
+		void U16(uint16_t value)
+		{
+			buffer_.push_back(static_cast<uint8_t>(value));
+			buffer_.push_back(static_cast<uint8_t>(value >> 8));
+		}
+		void U32(uint32_t value)
+		{
+			for (int shift = 0; shift < 32; shift += 8)
+			{
+				buffer_.push_back(static_cast<uint8_t>(value >> shift));
+			}
+		}
+		void F32(float value)
+		{
+			uint32_t bits = 0;
+			std::memcpy(&bits, &value, sizeof(bits));
+			U32(bits);
+		}
+		// BeginFrame이 비워 둔 본문 길이를 채운다.
+		void PatchU32(size_t position, uint32_t value)
+		{
+			for (int i = 0; i < 4; ++i)
+			{
+				buffer_[position + i] = static_cast<uint8_t>(value >> (i * 8));
+			}
+		}
+
+		// 프레임 헤더를 쓰고 본문 길이를 채울 위치를 돌려준다.
+		size_t BeginFrame(EMessageType type)
+		{
+			const size_t position = buffer_.size();
+			U32(0);
+			U8(static_cast<uint8_t>(type));
+			return position;
+		}
+		void EndFrame(size_t position)
+		{
+			PatchU32(position, static_cast<uint32_t>(buffer_.size() - position - Protocol::FRAME_HEADER_SIZE));
+		}
+
+	private:
+		std::vector<uint8_t>& buffer_;
+	};
+
+	class ByteReader
+	{
+	public:
+		ByteReader(const uint8_t* data, size_t size)
+			: data_(data)
+			, size_(size)
+		{
+		}
+
+		// 남은 바이트가 모자라면 0을 읽고 IsValid가 false가 된다.
+		uint8_t U8() { return static_cast<uint8_t>(Read(1)); }
+		uint16_t U16() { return static_cast<uint16_t>(Read(2)); }
+		uint32_t U32() { return static_cast<uint32_t>(Read(4)); }
+		float F32()
+		{
+			const uint32_t bits = U32();
+			float value = 0.0f;
+			std::memcpy(&value, &bits, sizeof(value));
+			return value;
+		}
+
+		size_t GetRemaining() const { return size_ - position_; }
+		bool IsValid() const { return bValid_; }
+		bool IsAtEnd() const { return bValid_ && position_ == size_; }
+
+	private:
+		uint32_t Read(int byteCount)
+		{
+			if (GetRemaining() < static_cast<size_t>(byteCount))
+			{
+				bValid_ = false;
+				position_ = size_;
+				return 0;
+			}
+			uint32_t value = 0;
+			for (int i = 0; i < byteCount; ++i)
+			{
+				value |= static_cast<uint32_t>(data_[position_ + i]) << (i * 8);
+			}
+			position_ += byteCount;
+			return value;
+		}
+
+		const uint8_t* data_;
+		size_t size_;
+		size_t position_ = 0;
+		bool bValid_ = true;
+	};
+
+	constexpr size_t WIRE_QUERY_SIZE = 12;
+	constexpr size_t WIRE_POINT_SIZE = 4;
+} // namespace
+
+EFrameState PeekFrame(const uint8_t* data, size_t size, FrameView& frame)
+{
+	if (size < Protocol::FRAME_HEADER_SIZE)
+	{
+		return EFrameState::Incomplete;
+	}
+	ByteReader reader(data, size);
+	const uint32_t bodySize = reader.U32();
+	if (bodySize > Protocol::MAX_BODY_SIZE)
+	{
+		return EFrameState::Invalid;
+	}
+	if (size - Protocol::FRAME_HEADER_SIZE < bodySize)
+	{
+		return EFrameState::Incomplete;
+	}
+	frame.Type = static_cast<EMessageType>(reader.U8());
+	frame.Body = data + Protocol::FRAME_HEADER_SIZE;
+	frame.BodySize = bodySize;
+	frame.FrameSize = Protocol::FRAME_HEADER_SIZE + bodySize;
+	return EFrameState::Complete;
+}
+
+void AppendQueryBatch(std::vector<uint8_t>& buffer, const QueryBatch& batch)
+{
+	ByteWriter writer(buffer);
+	const size_t frame = writer.BeginFrame(EMessageType::QueryBatch);
+	writer.U16(static_cast<uint16_t>(batch.MapIndex));
+	writer.U8(static_cast<uint8_t>(batch.Method));
+	writer.U8(batch.Flags);
+	writer.U32(static_cast<uint32_t>(batch.Queries.size()));
+	for (const WireQuery& query : batch.Queries)
+	{
+		writer.U32(query.RequestId);
+		writer.U16(static_cast<uint16_t>(query.Start.Row));
+		writer.U16(static_cast<uint16_t>(query.Start.Column));
+		writer.U16(static_cast<uint16_t>(query.End.Row));
+		writer.U16(static_cast<uint16_t>(query.End.Column));
+	}
+	writer.EndFrame(frame);
+}
+
+void AppendPathResponse(std::vector<uint8_t>& buffer, uint32_t requestId, EPathStatus status, float cost,
+						const std::vector<GridPosition>& points)
+{
+	ByteWriter writer(buffer);
+	const size_t frame = writer.BeginFrame(EMessageType::PathResponse);
+	writer.U32(requestId);
+	writer.U8(static_cast<uint8_t>(status));
+	writer.F32(cost);
+	writer.U32(static_cast<uint32_t>(points.size()));
+	for (const GridPosition& point : points)
+	{
+		writer.U16(static_cast<uint16_t>(point.Row));
+		writer.U16(static_cast<uint16_t>(point.Column));
+	}
+	writer.EndFrame(frame);
+}
+
+bool ParseQueryBatch(const FrameView& frame, QueryBatch& out)
+{
+	if (frame.Type != EMessageType::QueryBatch)
+	{
+		return false;
+	}
+	ByteReader reader(frame.Body, frame.BodySize);
+	out.MapIndex = reader.U16();
+	const uint8_t method = reader.U8();
+	out.Flags = reader.U8();
+	const uint32_t count = reader.U32();
+	// 개수는 믿을 수 없는 입력이므로 곱하기 전에 남은 길이로 나눠 비교한다.
+	if (!reader.IsValid() || method >= EHeuristicMethod::NUM_TYPES || count > reader.GetRemaining() / WIRE_QUERY_SIZE
+		|| reader.GetRemaining() != count * WIRE_QUERY_SIZE)
+	{
+		return false;
+	}
+	out.Method = static_cast<EHeuristicMethod::Type>(method);
+	out.Queries.resize(count);
+	for (WireQuery& query : out.Queries)
+	{
+		query.RequestId = reader.U32();
+		query.Start.Row = reader.U16();
+		query.Start.Column = reader.U16();
+		query.End.Row = reader.U16();
+		query.End.Column = reader.U16();
+	}
+	return reader.IsAtEnd();
+}
+
+bool ParsePathResponse(const FrameView& frame, PathResponse& out)
+{
+	if (frame.Type != EMessageType::PathResponse)
+	{
+		return false;
+	}
+	ByteReader reader(frame.Body, frame.BodySize);
+	out.RequestId = reader.U32();
+	const uint8_t status = reader.U8();
+	out.Cost = reader.F32();
+	const uint32_t count = reader.U32();
+	if (!reader.IsValid() || status > static_cast<uint8_t>(EPathStatus::BadRequest)
+		|| count > reader.GetRemaining() / WIRE_POINT_SIZE || reader.GetRemaining() != count * WIRE_POINT_SIZE)
+	{
+		return false;
+	}
+	out.Status = static_cast<EPathStatus>(status);
+	out.Points.resize(count);
+	for (GridPosition& point : out.Points)
+	{
+		point.Row = reader.U16();
+		point.Column = reader.U16();
+	}
+	return reader.IsAtEnd();
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include "Pathfinding/PathResult.h"
+#include "Pathfinding/PathfindingTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 서버와 클라이언트가 Unix 도메인 소켓으로 주고받는 프레임.
+//
+// 모든 정수와 float는 리틀 엔디언이다. 프레임은 uint32 본문 길이, uint8 타입, 본문 순서이다.
+//   QueryBatch    (클라이언트 -> 서버)
+//     uint16 MapIndex, uint8 Heuristic(EHeuristicMethod), uint8 Flags, uint32 Count,
+//     Count x { uint32 RequestId, uint16 StartRow, uint16 StartColumn, uint16 EndRow, uint16 EndColumn }
+//   PathResponse  (서버 -> 클라이언트, 쿼리마다 하나, 끝난 순서대로)
+//     uint32 RequestId, uint8 Status(EPathStatus), float Cost, uint32 PointCount,
+//     PointCount x { uint16 Row, uint16 Column }
+// 클라이언트는 응답을 기다리지 않고 QueryBatch를 이어서 보낼 수 있다. 응답은 RequestId로 맞춘다.
+namespace Protocol
+{
+	// 이보다 긴 프레임은 잘못된 것으로 보고 연결을 끊는다.
+	constexpr uint32_t MAX_BODY_SIZE = 16u << 20;
+	constexpr size_t FRAME_HEADER_SIZE = 5;
+	// 켜면 웨이포인트 대신 경로의 모든 셀을 보낸다.
+	constexpr uint8_t QUERY_FLAG_CELLS = 1u << 0;
+} // namespace Protocol
+
+enum class EMessageType : uint8_t
+{
+	QueryBatch = 1,
+	PathResponse = 2
+};
+
+enum class EPathStatus : uint8_t
+{
+	Found = 0,
+	NotFound = 1,
+	// 없는 맵이거나 맵 밖의 좌표, 또는 벽인 시작이나 도착
+	BadRequest = 2
+};
+
+struct WireQuery
+{
+	uint32_t RequestId = 0;
+	GridPosition Start;
+	GridPosition End;
+};
+
+struct QueryBatch
+{
+	int MapIndex = 0;
+	EHeuristicMethod::Type Method = EHeuristicMethod::Octile;
+	uint8_t Flags = 0;
+	std::vector<WireQuery> Queries;
+};
+
+struct PathResponse
+{
+	uint32_t RequestId = 0;
+	EPathStatus Status = EPathStatus::NotFound;
+	float Cost = 0.0f;
+	std::vector<GridPosition> Points;
+};
+
+// 입력 버퍼에서 찾은 프레임 하나. Body는 입력 버퍼를 가리키므로 버퍼를 바꾸기 전까지만 유효하다.
+struct FrameView
+{
+	EMessageType Type = EMessageType::QueryBatch;
+	const uint8_t* Body = nullptr;
+	size_t BodySize = 0;
+	// 헤더를 포함한 크기
+	size_t FrameSize = 0;
+};
+
+enum class EFrameState
+{
+	Complete,
+	// 아직 다 받지 못했다.
+	Incomplete,
+	// 본문 길이가 MAX_BODY_SIZE를 넘는다.
+	Invalid
+};
+
+// data의 맨 앞 프레임을 찾는다.
+EFrameState PeekFrame(const uint8_t* data, size_t size, FrameView& frame);
+
+// buffer 끝에 프레임을 붙인다.
+void AppendQueryBatch(std::vector<uint8_t>& buffer, const QueryBatch& batch);
+void AppendPathResponse(std::vector<uint8_t>& buffer, uint32_t requestId, EPathStatus status, float cost,
+						const std::vector<GridPosition>& points);
+
+// 타입이 다르거나 본문이 잘렸으면 false. out의 기존 용량을 재사용한다.
+bool ParseQueryBatch(const FrameView& frame, QueryBatch& out);
+bool ParsePathResponse(const FrameView& frame, PathResponse& out);
@@ -0,0 +1,343 @@
+#include "Common/MapSource.h"
+#include "Common/MessageSocket.h"
+#include "Common/Protocol.h"
+
+#include "Pathfinding/ConnectivityIndex.h"
+#include "Pathfinding/Grid.h"
+#include "Pathfinding/MapFile.h"
+#include "Pathfinding/PathfindingTypes.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <poll.h>
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	struct LoadOptions
+	{
+		std::string SocketPath = "/tmp/pathfinding.sock";
+		// 서버의 --map과 같은 맵을 지정해야 도달 가능한 쿼리를 만든다.
+		std::string MapSource;
+		int MapIndex = 0;
+		uint32_t Seed = 1;
+		EHeuristicMethod::Type Method = EHeuristicMethod::Octile;
+		int QueryCount = 10000;
+		// QueryBatch 하나에 담는 쿼리 수
+		int BatchSize = 16;
+		// 연결마다 응답을 받지 못한 채 보낼 수 있는 쿼리 수
+		int InFlightCount = 256;
+		int ConnectionCount = 1;
+		// 0보다 크면 이만큼의 서로 다른 쿼리만 만들어 무작위로 반복한다(서버 캐시 확인용).
+		int UniqueCount = 0;
+		bool bCells = false;
+	};
+
+	void PrintUsage()
+	{
+		std::cerr << "Usage: LoadGenerator --map <source> [options]\n"
+					 "  --map <path.map|path.pfmap|random:N>            same source as the server's map\n"
+					 "  --socket <path>                                 (default /tmp/pathfinding.sock)\n"
+					 "  --map-index <n>                                 server map index (default 0)\n"
+					 "  --seed <n>                                      map and query seed (default 1)\n"
+					 "  --heuristic <None|Manhattan|Euclidean|Octile|ALT> (default Octile)\n"
+					 "  --queries <n>                                   (default 10000)\n"
+					 "  --batch <n>                                     queries per request frame (default 16)\n"
+					 "  --in-flight <n>                                 unanswered queries per connection\n"
+					 "                                                  (default 256)\n"
+					 "  --connections <n>                               (default 1)\n"
+					 "  --unique <n>                                    repeat n distinct queries at random\n"
+					 "                                                  (default 0, all distinct)\n"
+					 "  --points <Waypoints|Cells>                      (default Waypoints)\n";
+	}
+
+	bool ParseOptions(int argc, char** argv, LoadOptions& options)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			const std::string option = argv[i];
+			if (i + 1 >= argc)
+			{
+				return false;
+			}
+			const std::string value = argv[++i];
+			if (option == "--map")
+			{
+				options.MapSource = value;
+			}
+			else if (option == "--socket")
+			{
+				options.SocketPath = value;
+			}
+			else if (option == "--map-index")
+			{
+				options.MapIndex = std::atoi(value.c_str());
+			}
+			else if (option == "--seed")
+			{
+				options.Seed = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+			}
+			else if (option == "--heuristic")
+			{
+				options.Method = EHeuristicMethod::from_string(value);
+				if (value != EHeuristicMethod::to_string(options.Method))
+				{
+					return false;
+				}
+			}
+			else if (option == "--queries")
+			{
+				options.QueryCount = std::atoi(value.c_str());
+			}
+			else if (option == "--batch")
+			{
+				options.BatchSize = std::atoi(value.c_str());
+			}
+			else if (option == "--in-flight")
+			{
+				options.InFlightCount = std::atoi(value.c_str());
+			}
+			else if (option == "--connections")
+			{
+				options.ConnectionCount = std::atoi(value.c_str());
+			}
+			else if (option == "--unique")
+			{
+				options.UniqueCount = std::atoi(value.c_str());
+			}
+			else if (option == "--points")
+			{
+				if (value != "Waypoints" && value != "Cells")
+				{
+					return false;
+				}
+				options.bCells = value == "Cells";
+			}
+			else
+			{
+				return false;
+			}
+		}
+		return !options.MapSource.empty() && options.MapIndex >= 0 && options.QueryCount > 0 && options.BatchSize > 0
+			   && options.InFlightCount >= options.BatchSize && options.ConnectionCount > 0 && options.UniqueCount >= 0;
+	}
+
+	// 가장 큰 연결 영역의 셀 두 개를 고르므로 모든 쿼리는 경로가 있다.
+	std::vector<WireQuery> GenerateQueries(const Grid& grid, int queryCount, int uniqueCount, uint32_t seed)
+	{
+		ConnectivityIndex connectivity(grid, 0);
+		connectivity.Build();
+		std::vector<int> componentSizes;
+		for (int index = 0; index < grid.GetCellCount(); ++index)
+		{
+			const int label = connectivity.GetLabel(index);
+			if (label == ConnectivityIndex::INVALID_LABEL)
+			{
+				continue;
+			}
+			if (label >= static_cast<int>(componentSizes.size()))
+			{
+				componentSizes.resize(label + 1, 0);
+			}
+			++componentSizes[label];
+		}
+		if (componentSizes.empty())
+		{
+			return {};
+		}
+		const int largestLabel
+			= static_cast<int>(std::max_element(componentSizes.begin(), componentSizes.end()) - componentSizes.begin());
+		std::vector<int> cells;
+		cells.reserve(componentSizes[largestLabel]);
+		for (int index = 0; index < grid.GetCellCount(); ++index)
+		{
+			if (connectivity.GetLabel(index) == largestLabel)
+			{
+				cells.push_back(index);
+			}
+		}
+
+		std::mt19937 random(seed);
+		auto randomCell = [&]()
+		{
+			const int index = cells[random() % static_cast<uint32_t>(cells.size())];
+			return GridPosition{grid.ToRow(index), grid.ToColumn(index)};
+		};
+		std::vector<WireQuery> queries(queryCount);
+		for (int i = 0; i < queryCount; ++i)
+		{
+			queries[i].RequestId = static_cast<uint32_t>(i);
+			if (uniqueCount > 0 && i >= uniqueCount)
+			{
+				const WireQuery& repeated = queries[random() % static_cast<uint32_t>(uniqueCount)];
+				queries[i].Start = repeated.Start;
+				queries[i].End = repeated.End;
+				continue;
+			}
+			queries[i].Start = randomCell();
+			queries[i].End = randomCell();
+		}
+		return queries;
+	}
+
+	double GetPercentile(const std::vector<double>& sortedValues, double percentile)
+	{
+		const size_t index = static_cast<size_t>(percentile * (sortedValues.size() - 1) + 0.5);
+		return sortedValues[std::min(index, sortedValues.size() - 1)];
+	}
+
+	struct Connection
+	{
+		MessageSocket Socket;
+		int InFlightCount = 0;
+	};
+} // namespace
+
+int main(int argc, char** argv)
+{
+	LoadOptions options;
+	if (!ParseOptions(argc, argv, options))
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	MapFile file;
+	Grid grid;
+	std::string error;
+	if (!LoadMapSource(options.MapSource, options.Seed, file, grid, error))
+	{
+		std::cerr << "Failed to load " << options.MapSource << ": " << error << "\n";
+		return 1;
+	}
+	const std::vector<WireQuery> queries = GenerateQueries(grid, options.QueryCount, options.UniqueCount, options.Seed);
+	if (queries.empty())
+	{
+		std::cerr << "No walkable cells in " << options.MapSource << "\n";
+		return 1;
+	}
+
+	std::signal(SIGPIPE, SIG_IGN);
+	std::vector<Connection> connections(options.ConnectionCount);
+	for (Connection& connection : connections)
+	{
+		const int descriptor = ConnectUnixSocket(options.SocketPath, error);
+		if (descriptor < 0)
+		{
+			std::cerr << "Failed to connect: " << error << "\n";
+			return 1;
+		}
+		connection.Socket = MessageSocket(descriptor);
+	}
+
+	// 요청 번호는 queries의 인덱스이다. 지연 시간은 그 쿼리를 담은 프레임을 버퍼에 넣은 때부터 응답을 꺼낸 때까지.
+	std::vector<Clock::time_point> sendTimes(queries.size());
+	std::vector<double> latencies;
+	latencies.reserve(queries.size());
+	QueryBatch batch;
+	batch.MapIndex = options.MapIndex;
+	batch.Method = options.Method;
+	batch.Flags = options.bCells ? Protocol::QUERY_FLAG_CELLS : 0;
+	PathResponse response;
+	size_t nextQuery = 0;
+	int foundCount = 0;
+	int notFoundCount = 0;
+	int badRequestCount = 0;
+	uint64_t receivedPointCount = 0;
+	bool bFailed = false;
+
+	std::vector<pollfd> pollDescriptors(connections.size());
+	const Clock::time_point begin = Clock::now();
+	while (latencies.size() < queries.size() && !bFailed)
+	{
+		for (size_t i = 0; i < connections.size(); ++i)
+		{
+			Connection& connection = connections[i];
+			// 한도가 찰 때까지 배치를 이어서 보낸다(파이프라이닝).
+			while (nextQuery < queries.size() && connection.InFlightCount + options.BatchSize <= options.InFlightCount)
+			{
+				const size_t count = std::min(queries.size() - nextQuery, static_cast<size_t>(options.BatchSize));
+				batch.Queries.assign(queries.begin() + static_cast<std::ptrdiff_t>(nextQuery),
+									 queries.begin() + static_cast<std::ptrdiff_t>(nextQuery + count));
+				AppendQueryBatch(connection.Socket.GetSendBuffer(), batch);
+				const Clock::time_point now = Clock::now();
+				std::fill(sendTimes.begin() + static_cast<std::ptrdiff_t>(nextQuery),
+						  sendTimes.begin() + static_cast<std::ptrdiff_t>(nextQuery + count), now);
+				nextQuery += count;
+				connection.InFlightCount += static_cast<int>(count);
+			}
+			if (!connection.Socket.Flush())
+			{
+				bFailed = true;
+			}
+			const short events = connection.Socket.GetPendingSendSize() > 0 ? POLLIN | POLLOUT : POLLIN;
+			pollDescriptors[i] = {connection.Socket.GetDescriptor(), events, 0};
+		}
+		if (bFailed || (poll(pollDescriptors.data(), pollDescriptors.size(), -1) < 0 && errno != EINTR))
+		{
+			bFailed = true;
+			break;
+		}
+
+		for (size_t i = 0; i < connections.size(); ++i)
+		{
+			if ((pollDescriptors[i].revents & (POLLIN | POLLHUP | POLLERR)) == 0)
+			{
+				continue;
+			}
+			Connection& connection = connections[i];
+			bool bValidFrames = true;
+			const bool bOpen = connection.Socket.Receive();
+			const bool bComplete = connection.Socket.ForEachFrame(
+				[&](const FrameView& frame)
+				{
+					if (!ParsePathResponse(frame, response) || response.RequestId >= queries.size())
+					{
+						bValidFrames = false;
+						return;
+					}
+					const Clock::duration latency = Clock::now() - sendTimes[response.RequestId];
+					latencies.push_back(std::chrono::duration<double, std::micro>(latency).count());
+					--connection.InFlightCount;
+					receivedPointCount += response.Points.size();
+					foundCount += response.Status == EPathStatus::Found ? 1 : 0;
+					notFoundCount += response.Status == EPathStatus::NotFound ? 1 : 0;
+					badRequestCount += response.Status == EPathStatus::BadRequest ? 1 : 0;
+				});
+			if (!bOpen || !bComplete || !bValidFrames)
+			{
+				bFailed = true;
+			}
+		}
+	}
+	const double elapsedSeconds = std::chrono::duration<double>(Clock::now() - begin).count();
+	if (bFailed)
+	{
+		std::cerr << "Connection failed after " << latencies.size() << " of " << queries.size() << " responses\n";
+		return 1;
+	}
+
+	std::sort(latencies.begin(), latencies.end());
+	std::cout << "Queries:         " << queries.size() << " (" << foundCount << " found, " << notFoundCount
+			  << " not found, " << badRequestCount << " bad request)\n"
+			  << "Connections:     " << options.ConnectionCount << ", batch " << options.BatchSize << ", in-flight "
+			  << options.InFlightCount << "\n"
+			  << "Elapsed:         " << elapsedSeconds * 1000.0 << " ms\n"
+			  << "Throughput:      " << static_cast<double>(queries.size()) / elapsedSeconds << " queries/s\n"
+			  << "Latency (us):    p50 " << GetPercentile(latencies, 0.50) << ", p90 " << GetPercentile(latencies, 0.90)
+			  << ", p99 " << GetPercentile(latencies, 0.99) << ", p99.9 " << GetPercentile(latencies, 0.999)
+			  << ", max " << latencies.back() << "\n"
+			  << "Points per path: " << static_cast<double>(receivedPointCount) / static_cast<double>(queries.size())
+			  << "\n";
+	return 0;
+}
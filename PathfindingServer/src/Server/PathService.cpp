@@ -0,0 +1,189 @@
+#include "PathService.h"
+
+#include "Common/MapSource.h"
+
+#include "Pathfinding/PathSmoothing.h"
+
+#include <algorithm>
+
+PathService::PathService(const PathServiceOptions& options)
+	: options_(options)
+{
+	options_.ActiveCount = std::max(1, options_.ActiveCount);
+}
+
+PathService::~PathService() = default;
+
+bool PathService::AddMap(const std::string& source, uint32_t seed, std::string& error)
+{
+	auto map = std::make_unique<ServedMap>();
+	if (!LoadMapSource(source, seed, map->File, map->Map, error))
+	{
+		return false;
+	}
+	map->Connectivity = std::make_unique<ConnectivityIndex>(map->Map, 0);
+	map->Connectivity->Build();
+	if (options_.bBuildLandmarks)
+	{
+		map->Landmarks.Build(map->Map);
+	}
+
+	if (options_.CacheCapacity > 0)
+	{
+		map->Cache = std::make_unique<PathCache>(options_.CacheCapacity);
+	}
+
+	map->Scheduler = std::make_unique<SearchScheduler>(map->Map, options_.ActiveCount);
+	SearchScheduler& scheduler = *map->Scheduler;
+	scheduler.SetAlgorithm(options_.Algorithm);
+	scheduler.SetOpenListType(options_.OpenListType);
+	scheduler.SetLandmarks(&map->Landmarks);
+	// 서로 다른 영역을 잇는 쿼리는 탐색 없이 바로 끝난다.
+	scheduler.SetConnectivity(map->Connectivity.get());
+	scheduler.SetCache(map->Cache.get());
+	// 캐시가 없으면 웨이포인트는 요청한 쿼리에만 Collect에서 만든다. 있으면 캐시에 웨이포인트까지 넣어 둔다.
+	scheduler.SetBuildWaypoints(map->Cache != nullptr);
+	scheduler.SetSliceNodeCount(options_.SliceNodeCount);
+	scheduler.Reserve();
+	maps_.push_back(std::move(map));
+	return true;
+}
+
+void PathService::Submit(int clientId, const QueryBatch& batch, const PathResponseSink& sink)
+{
+	static const std::vector<GridPosition> noPoints;
+	const bool bValidMap = batch.MapIndex >= 0 && batch.MapIndex < GetMapCount();
+	for (const WireQuery& query : batch.Queries)
+	{
+		const Grid* grid = bValidMap ? &maps_[batch.MapIndex]->Map : nullptr;
+		// 탐색은 양 끝이 벽인지 보지 않으므로(시작과 도착이 같으면 비용 0으로 찾는다) 여기서 거른다.
+		auto isOpen = [grid](const GridPosition& position)
+		{ return grid->IsInBounds(position.Row, position.Column) && grid->IsWalkable(position.Row, position.Column); };
+		if (!grid || !isOpen(query.Start) || !isOpen(query.End))
+		{
+			++answeredCount_;
+			sink(clientId, query.RequestId, EPathStatus::BadRequest, 0.0f, noPoints);
+			continue;
+		}
+		PendingQuery pending;
+		pending.ClientId = clientId;
+		pending.RequestId = query.RequestId;
+		pending.Flags = batch.Flags;
+		pending.Query = {query.Start, query.End, batch.Method};
+		maps_[batch.MapIndex]->Waiting.push_back(pending);
+		++pendingCount_;
+	}
+}
+
+int PathService::Update(int nodeBudget, const PathResponseSink& sink)
+{
+	int expandedCount = 0;
+	for (std::unique_ptr<ServedMap>& map : maps_)
+	{
+		if (map->Waiting.empty() && map->Submitted.empty())
+		{
+			continue;
+		}
+		Admit(*map, sink);
+		expandedCount += map->Scheduler->Update({nodeBudget, {}});
+		Collect(*map, sink);
+		Admit(*map, sink);
+	}
+	return expandedCount;
+}
+
+void PathService::DropClient(int clientId)
+{
+	for (std::unique_ptr<ServedMap>& map : maps_)
+	{
+		auto isDropped = [clientId](const PendingQuery& pending) { return pending.ClientId == clientId; };
+		const size_t waitingCount = map->Waiting.size();
+		map->Waiting.erase(std::remove_if(map->Waiting.begin(), map->Waiting.end(), isDropped), map->Waiting.end());
+		pendingCount_ -= static_cast<int>(waitingCount - map->Waiting.size());
+
+		for (size_t i = 0; i < map->Submitted.size();)
+		{
+			if (!isDropped(map->Submitted[i]))
+			{
+				++i;
+				continue;
+			}
+			map->Scheduler->Release(map->Submitted[i].Handle);
+			map->Submitted[i] = map->Submitted.back();
+			map->Submitted.pop_back();
+			--pendingCount_;
+		}
+	}
+}
+
+PathCacheCounters PathService::GetCacheCounters() const
+{
+	PathCacheCounters total;
+	for (const std::unique_ptr<ServedMap>& map : maps_)
+	{
+		if (!map->Cache)
+		{
+			continue;
+		}
+		const PathCacheCounters counters = map->Cache->GetCounters();
+		total.Hits += counters.Hits;
+		total.Misses += counters.Misses;
+		total.Evictions += counters.Evictions;
+		total.Invalidations += counters.Invalidations;
+		total.RejectedStores += counters.RejectedStores;
+		total.EntryCount += counters.EntryCount;
+	}
+	return total;
+}
+
+void PathService::Admit(ServedMap& map, const PathResponseSink& sink)
+{
+	const size_t capacity = static_cast<size_t>(options_.ActiveCount) * 2;
+	while (!map.Waiting.empty() && map.Submitted.size() < capacity)
+	{
+		PendingQuery& pending = map.Submitted.emplace_back(map.Waiting.front());
+		map.Waiting.pop_front();
+		pending.Handle = map.Scheduler->Submit(pending.Query);
+		// 캐시에 있던 쿼리는 자리를 차지하지 않고 바로 응답한다.
+		if (map.Scheduler->GetState(pending.Handle) == ESearchRequestState::Finished)
+		{
+			Respond(map, pending, sink);
+			map.Submitted.pop_back();
+		}
+	}
+}
+
+void PathService::Collect(ServedMap& map, const PathResponseSink& sink)
+{
+	SearchScheduler& scheduler = *map.Scheduler;
+	for (size_t i = 0; i < map.Submitted.size();)
+	{
+		const PendingQuery& pending = map.Submitted[i];
+		if (scheduler.GetState(pending.Handle) != ESearchRequestState::Finished)
+		{
+			++i;
+			continue;
+		}
+		Respond(map, pending, sink);
+		// 응답 순서는 끝난 순서이므로 빈 자리는 마지막 것으로 채운다.
+		map.Submitted[i] = map.Submitted.back();
+		map.Submitted.pop_back();
+	}
+}
+
+void PathService::Respond(ServedMap& map, const PendingQuery& pending, const PathResponseSink& sink)
+{
+	SearchScheduler& scheduler = *map.Scheduler;
+	scheduler.GetResult(pending.Handle, result_);
+	scheduler.Release(pending.Handle);
+	const bool bCells = (pending.Flags & Protocol::QUERY_FLAG_CELLS) != 0;
+	if (!bCells && !map.Cache)
+	{
+		BuildWaypoints(map.Map, result_);
+	}
+	++answeredCount_;
+	foundCount_ += result_.bFound ? 1 : 0;
+	--pendingCount_;
+	sink(pending.ClientId, pending.RequestId, result_.bFound ? EPathStatus::Found : EPathStatus::NotFound,
+		 result_.Cost, bCells ? result_.Cells : result_.Waypoints);
+}
@@ -0,0 +1,106 @@
+#pragma once
+#include "Common/Protocol.h"
+
+#include "Pathfinding/ConnectivityIndex.h"
+#include "Pathfinding/Grid.h"
+#include "Pathfinding/LandmarkTable.h"
+#include "Pathfinding/MapFile.h"
+#include "Pathfinding/PathCache.h"
+#include "Pathfinding/PathfindingTypes.h"
+#include "Pathfinding/SearchScheduler.h"
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct PathServiceOptions
+{
+	ESearchAlgorithm::Type Algorithm = ESearchAlgorithm::AStar;
+	EOpenListType::Type OpenListType = EOpenListType::BinaryHeap;
+	// 맵마다 동시에 실행하는 탐색 수
+	int ActiveCount = 8;
+	int SliceNodeCount = SearchScheduler::DEFAULT_SLICE_NODE_COUNT;
+	// 켜면 맵마다 ALT 랜드마크 표를 만든다. 끄면 ALT 쿼리는 Octile로 동작한다.
+	bool bBuildLandmarks = true;
+	// 0보다 크면 맵마다 이만큼의 경로를 PathCache에 기억해 같은 쿼리는 탐색 없이 응답한다.
+	int CacheCapacity = 0;
+};
+
+// 끝난 쿼리를 보낼 곳. points는 다음 호출 전까지만 유효하다.
+using PathResponseSink = std::function<void(int clientId, uint32_t requestId, EPathStatus status, float cost,
+											const std::vector<GridPosition>& points)>;
+
+// 서버가 올린 맵들과 맵마다 하나인 SearchScheduler. 여러 클라이언트의 쿼리를 받은 순서대로 스케줄러에 넣고,
+// Update마다 조금씩 진행해 끝난 것부터 응답한다. 한 스레드에서만 쓴다.
+//
+// 스케줄러에는 ActiveCount의 두 배까지만 넣고 나머지는 맵별 대기열에 둔다. 끝난 요청을 찾으려고
+// 넣은 요청을 모두 훑으므로, 클라이언트가 얼마나 많이 보내든 Update 한 번의 비용이 일정하다.
+class PathService
+{
+public:
+	explicit PathService(const PathServiceOptions& options);
+	~PathService();
+	PathService(const PathService&) = delete;
+	PathService& operator=(const PathService&) = delete;
+
+	// source는 LoadMapSource 형식이다. 연결 영역과 (켜져 있으면) 랜드마크 표를 만들고 탐색 상태를 미리 할당한다.
+	bool AddMap(const std::string& source, uint32_t seed, std::string& error);
+	int GetMapCount() const { return static_cast<int>(maps_.size()); }
+	const Grid& GetMap(int index) const { return maps_[index]->Map; }
+
+	// 잘못된 쿼리(없는 맵, 맵 밖의 좌표, 벽인 시작이나 도착)는 바로 BadRequest로 응답한다.
+	void Submit(int clientId, const QueryBatch& batch, const PathResponseSink& sink);
+	// 맵마다 최대 nodeBudget개의 노드를 확장하고 끝난 쿼리를 응답한다. 확장한 노드 수를 돌려준다.
+	int Update(int nodeBudget, const PathResponseSink& sink);
+	// 연결이 끊긴 클라이언트의 쿼리를 버린다.
+	void DropClient(int clientId);
+
+	bool HasWork() const { return pendingCount_ > 0; }
+	int GetPendingCount() const { return pendingCount_; }
+	uint64_t GetAnsweredCount() const { return answeredCount_; }
+	uint64_t GetFoundCount() const { return foundCount_; }
+	// 모든 맵의 캐시 카운터를 더한 값
+	PathCacheCounters GetCacheCounters() const;
+
+private:
+	struct PendingQuery
+	{
+		int ClientId = 0;
+		uint32_t RequestId = 0;
+		uint8_t Flags = 0;
+		PathQuery Query;
+		int Handle = SearchScheduler::INVALID_HANDLE;
+	};
+
+	// Grid와 표는 스케줄러가 가리키므로 ServedMap은 옮기지 않는다.
+	struct ServedMap
+	{
+		MapFile File;
+		Grid Map;
+		std::unique_ptr<ConnectivityIndex> Connectivity;
+		LandmarkTable Landmarks;
+		// CacheCapacity가 0이면 nullptr
+		std::unique_ptr<PathCache> Cache;
+		std::unique_ptr<SearchScheduler> Scheduler;
+		// 스케줄러에 넣기를 기다리는 쿼리
+		std::deque<PendingQuery> Waiting;
+		// 스케줄러에 넣은 쿼리
+		std::vector<PendingQuery> Submitted;
+	};
+
+	// 스케줄러에 빈 자리가 있는 만큼 대기열에서 옮긴다.
+	void Admit(ServedMap& map, const PathResponseSink& sink);
+	// 끝난 쿼리를 응답하고 스케줄러에서 뺀다.
+	void Collect(ServedMap& map, const PathResponseSink& sink);
+	void Respond(ServedMap& map, const PendingQuery& pending, const PathResponseSink& sink);
+
+	PathServiceOptions options_;
+	std::vector<std::unique_ptr<ServedMap>> maps_;
+	PathResult result_;
+	int pendingCount_ = 0;
+	uint64_t answeredCount_ = 0;
+	uint64_t foundCount_ = 0;
+};
@@ -0,0 +1,295 @@
+#include "PathService.h"
+
+#include "Common/MessageSocket.h"
+#include "Common/Protocol.h"
+
+#include "Pathfinding/PathfindingTypes.h"
+
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <poll.h>
+#include <unistd.h>
+
+namespace
+{
+	// 보내지 못한 응답이 이만큼 쌓인 클라이언트는 다 보낼 때까지 새 쿼리를 읽지 않는다.
+	constexpr size_t MAX_PENDING_SEND_BYTES = 4u << 20;
+	// 할 일이 없을 때 poll이 기다리는 시간
+	constexpr int IDLE_POLL_MILLISECONDS = 1000;
+
+	volatile std::sig_atomic_t bStopRequested = 0;
+
+	void OnStopSignal(int)
+	{
+		bStopRequested = 1;
+	}
+
+	struct ServerOptions
+	{
+		std::string SocketPath = "/tmp/pathfinding.sock";
+		std::vector<std::string> Maps;
+		uint32_t Seed = 1;
+		PathServiceOptions Service;
+		// 루프 한 번에 맵마다 확장하는 노드 수. 작을수록 새 쿼리와 응답이 자주 오가고, 클수록 처리량이 높다.
+		int UpdateNodeCount = 4096;
+	};
+
+	void PrintUsage()
+	{
+		std::cerr << "Usage: PathfindingServer --map <source> [--map <source> ...] [options]\n"
+					 "  --map <path.map|path.pfmap|random:N>            map served at the next index (repeatable)\n"
+					 "  --socket <path>                                 (default /tmp/pathfinding.sock)\n"
+					 "  --seed <n>                                      seed for random:N maps (default 1)\n"
+					 "  --algorithm <AStar|JumpPointSearch|ThetaStar|LazyThetaStar> (default AStar)\n"
+					 "  --open-list <BinaryHeap|QuaternaryHeap|BucketQueue|PriorityQueue>\n"
+					 "  --active <n>                                    searches running at once per map (default 8)\n"
+					 "  --slice <n>                                     nodes per search turn (default 256)\n"
+					 "  --update-nodes <n>                              nodes per map per loop (default 4096)\n"
+					 "  --landmarks <On|Off>                            build ALT landmarks per map (default On)\n"
+					 "  --cache <n>                                     remember up to n paths per map\n"
+					 "                                                  (default 0, off)\n";
+	}
+
+	bool ParseOptions(int argc, char** argv, ServerOptions& options)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			const std::string option = argv[i];
+			if (i + 1 >= argc)
+			{
+				return false;
+			}
+			const std::string value = argv[++i];
+			if (option == "--map")
+			{
+				options.Maps.push_back(value);
+			}
+			else if (option == "--socket")
+			{
+				options.SocketPath = value;
+			}
+			else if (option == "--seed")
+			{
+				options.Seed = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+			}
+			else if (option == "--algorithm")
+			{
+				// SearchScheduler는 AStarSearch만 돌리므로 Bidirectional과 D* Lite는 받지 않는다.
+				options.Service.Algorithm = ESearchAlgorithm::from_string(value);
+				if (value != ESearchAlgorithm::to_string(options.Service.Algorithm)
+					|| options.Service.Algorithm == ESearchAlgorithm::Bidirectional
+					|| options.Service.Algorithm == ESearchAlgorithm::DStarLite)
+				{
+					return false;
+				}
+			}
+			else if (option == "--open-list")
+			{
+				options.Service.OpenListType = EOpenListType::from_string(value);
+				if (value != EOpenListType::to_string(options.Service.OpenListType))
+				{
+					return false;
+				}
+			}
+			else if (option == "--active")
+			{
+				options.Service.ActiveCount = std::atoi(value.c_str());
+			}
+			else if (option == "--slice")
+			{
+				options.Service.SliceNodeCount = std::atoi(value.c_str());
+			}
+			else if (option == "--update-nodes")
+			{
+				options.UpdateNodeCount = std::atoi(value.c_str());
+			}
+			else if (option == "--cache")
+			{
+				options.Service.CacheCapacity = std::atoi(value.c_str());
+			}
+			else if (option == "--landmarks")
+			{
+				if (value != "On" && value != "Off")
+				{
+					return false;
+				}
+				options.Service.bBuildLandmarks = value == "On";
+			}
+			else
+			{
+				return false;
+			}
+		}
+		return !options.Maps.empty() && options.Service.ActiveCount > 0 && options.Service.SliceNodeCount > 0
+			   && options.UpdateNodeCount > 0 && options.Service.CacheCapacity >= 0;
+	}
+} // namespace
+
+int main(int argc, char** argv)
+{
+	ServerOptions options;
+	if (!ParseOptions(argc, argv, options))
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	using Clock = std::chrono::steady_clock;
+	PathService service(options.Service);
+	for (const std::string& source : options.Maps)
+	{
+		const Clock::time_point begin = Clock::now();
+		std::string error;
+		if (!service.AddMap(source, options.Seed, error))
+		{
+			std::cerr << "Failed to load " << source << ": " << error << "\n";
+			return 1;
+		}
+		const Grid& map = service.GetMap(service.GetMapCount() - 1);
+		std::cout << "Map " << service.GetMapCount() - 1 << ": " << source << " (" << map.GetRowCount() << "x"
+				  << map.GetColumnCount() << ", "
+				  << std::chrono::duration<double, std::milli>(Clock::now() - begin).count() << " ms)\n";
+	}
+
+	std::string error;
+	const int listenDescriptor = ListenUnixSocket(options.SocketPath, error);
+	if (listenDescriptor < 0)
+	{
+		std::cerr << "Failed to listen: " << error << "\n";
+		return 1;
+	}
+	std::signal(SIGPIPE, SIG_IGN);
+	std::signal(SIGINT, OnStopSignal);
+	std::signal(SIGTERM, OnStopSignal);
+	std::cout << "Listening on " << options.SocketPath << std::endl;
+
+	std::unordered_map<int, MessageSocket> clients;
+	int nextClientId = 0;
+	const PathResponseSink sink = [&clients](int clientId, uint32_t requestId, EPathStatus status, float cost,
+											 const std::vector<GridPosition>& points)
+	{
+		auto client = clients.find(clientId);
+		if (client != clients.end())
+		{
+			AppendPathResponse(client->second.GetSendBuffer(), requestId, status, cost, points);
+		}
+	};
+
+	// 받은 쿼리를 서비스에 넣는다. 연결이 끊겼거나 QueryBatch가 아닌 프레임을 받았으면 false.
+	// 끊긴 연결에서 마지막으로 받은 쿼리는 응답을 받을 곳이 없으므로 버린다.
+	QueryBatch batch;
+	auto receiveQueries = [&](int clientId, MessageSocket& client)
+	{
+		if (!client.Receive())
+		{
+			return false;
+		}
+		bool bValidFrames = true;
+		const bool bComplete = client.ForEachFrame(
+			[&](const FrameView& frame)
+			{
+				if (!ParseQueryBatch(frame, batch))
+				{
+					bValidFrames = false;
+					return;
+				}
+				service.Submit(clientId, batch, sink);
+			});
+		return bComplete && bValidFrames;
+	};
+
+	std::vector<pollfd> pollDescriptors;
+	std::vector<int> pollClients;
+	std::vector<int> closedClients;
+	uint64_t expandedCount = 0;
+	while (!bStopRequested)
+	{
+		pollDescriptors.clear();
+		pollClients.clear();
+		pollDescriptors.push_back({listenDescriptor, POLLIN, 0});
+		for (const auto& [clientId, client] : clients)
+		{
+			short events = client.GetPendingSendSize() > 0 ? POLLOUT : 0;
+			if (client.GetPendingSendSize() < MAX_PENDING_SEND_BYTES)
+			{
+				events |= POLLIN;
+			}
+			pollDescriptors.push_back({client.GetDescriptor(), events, 0});
+			pollClients.push_back(clientId);
+		}
+		// 진행 중인 쿼리가 있으면 기다리지 않고 소켓만 확인한다.
+		const int timeout = service.HasWork() ? 0 : IDLE_POLL_MILLISECONDS;
+		if (poll(pollDescriptors.data(), pollDescriptors.size(), timeout) < 0 && errno != EINTR)
+		{
+			std::cerr << "poll failed\n";
+			break;
+		}
+
+		if (pollDescriptors[0].revents & POLLIN)
+		{
+			for (int descriptor = AcceptUnixSocket(listenDescriptor); descriptor >= 0;
+				 descriptor = AcceptUnixSocket(listenDescriptor))
+			{
+				clients.emplace(nextClientId++, MessageSocket(descriptor));
+			}
+		}
+
+		closedClients.clear();
+		for (size_t i = 1; i < pollDescriptors.size(); ++i)
+		{
+			const int clientId = pollClients[i - 1];
+			MessageSocket& client = clients.at(clientId);
+			const short revents = pollDescriptors[i].revents;
+			bool bOpen = (revents & (POLLERR | POLLNVAL)) == 0;
+			if (bOpen && (revents & (POLLIN | POLLHUP)))
+			{
+				bOpen = receiveQueries(clientId, client);
+			}
+			if (!bOpen)
+			{
+				closedClients.push_back(clientId);
+			}
+		}
+		for (int clientId : closedClients)
+		{
+			service.DropClient(clientId);
+			clients.erase(clientId);
+		}
+
+		expandedCount += service.Update(options.UpdateNodeCount, sink);
+
+		closedClients.clear();
+		for (auto& [clientId, client] : clients)
+		{
+			if (client.GetPendingSendSize() > 0 && !client.Flush())
+			{
+				closedClients.push_back(clientId);
+			}
+		}
+		for (int clientId : closedClients)
+		{
+			service.DropClient(clientId);
+			clients.erase(clientId);
+		}
+	}
+
+	close(listenDescriptor);
+	unlink(options.SocketPath.c_str());
+	std::cout << "Answered " << service.GetAnsweredCount() << " queries (" << service.GetFoundCount()
+			  << " found), expanded " << expandedCount << " nodes\n";
+	if (options.Service.CacheCapacity > 0)
+	{
+		const PathCacheCounters cache = service.GetCacheCounters();
+		std::cout << "Cache: " << cache.Hits << " hits, " << cache.Misses << " misses, " << cache.Evictions
+				  << " evictions, " << cache.EntryCount << " entries\n";
+	}
+	return 0;
+}
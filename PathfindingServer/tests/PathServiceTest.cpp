@@ -0,0 +1,152 @@
+// 잘못된 쿼리(없는 맵, 맵 밖의 좌표, 벽인 시작이나 도착)는 Submit에서 바로 BadRequest로 응답하고,
+// 나머지는 Update를 돌린 뒤 A*와 같은 도달 여부와 비용으로 한 번씩 응답하는지 확인한다.
+#include "TestUtils.h"
+
+#include "Server/PathService.h"
+
+#include "Pathfinding/AStarSearch.h"
+
+#include <map>
+#include <string>
+
+namespace
+{
+	constexpr int MAP_SIZE = 48;
+	constexpr uint32_t MAP_SEED = 7;
+	constexpr int QUERY_COUNT = 60;
+	constexpr int NODE_BUDGET = 64;
+
+	struct Answer
+	{
+		EPathStatus Status = EPathStatus::NotFound;
+		float Cost = 0.0f;
+		std::vector<GridPosition> Points;
+		int Count = 0;
+	};
+
+	// 맵에서 조건에 맞는 첫 셀
+	GridPosition FindCell(const Grid& grid, bool bWalkable, int skipCount = 0)
+	{
+		for (int row = 0; row < grid.GetRowCount(); ++row)
+		{
+			for (int column = 0; column < grid.GetColumnCount(); ++column)
+			{
+				if (grid.IsWalkable(row, column) == bWalkable && skipCount-- == 0)
+				{
+					return {row, column};
+				}
+			}
+		}
+		return {-1, -1};
+	}
+
+	void CheckService(const PathServiceOptions& options, uint8_t flags)
+	{
+		PathService service(options);
+		std::string error;
+		CHECK(service.AddMap("random:" + std::to_string(MAP_SIZE), MAP_SEED, error));
+		CHECK(service.GetMapCount() == 1);
+		const Grid& grid = service.GetMap(0);
+
+		std::map<uint32_t, Answer> answers;
+		const PathResponseSink sink = [&](int clientId, uint32_t requestId, EPathStatus status, float cost,
+										  const std::vector<GridPosition>& points)
+		{
+			CHECK(clientId == 3);
+			Answer& answer = answers[requestId];
+			answer.Status = status;
+			answer.Cost = cost;
+			answer.Points = points;
+			++answer.Count;
+		};
+
+		const GridPosition wall = FindCell(grid, false);
+		const GridPosition otherWall = FindCell(grid, false, 1);
+		const GridPosition open = FindCell(grid, true);
+		const GridPosition otherOpen = FindCell(grid, true, 1);
+		CHECK(wall.Row >= 0 && otherWall.Row >= 0 && open.Row >= 0 && otherOpen.Row >= 0);
+
+		QueryBatch bad;
+		bad.Flags = flags;
+		bad.Queries.push_back({1, wall, wall});
+		bad.Queries.push_back({2, wall, open});
+		bad.Queries.push_back({3, open, wall});
+		bad.Queries.push_back({4, wall, otherWall});
+		bad.Queries.push_back({5, open, {MAP_SIZE, 0}});
+		bad.Queries.push_back({6, {0, MAP_SIZE}, open});
+		bad.Queries.push_back({7, {-1, 0}, open});
+		service.Submit(3, bad, sink);
+		QueryBatch badMap;
+		badMap.MapIndex = 1;
+		badMap.Queries.push_back({8, open, otherOpen});
+		service.Submit(3, badMap, sink);
+		// 탐색 없이 바로 응답한다.
+		CHECK(!service.HasWork());
+		CHECK(answers.size() == 8);
+		for (const auto& [requestId, answer] : answers)
+		{
+			CHECK(answer.Status == EPathStatus::BadRequest);
+			CHECK(answer.Count == 1 && answer.Points.empty());
+		}
+
+		QueryBatch batch;
+		batch.Method = EHeuristicMethod::Octile;
+		batch.Flags = flags;
+		const std::vector<PathQuery> queries = MakeQueries(grid, QUERY_COUNT, batch.Method, MAP_SEED);
+		uint32_t requestId = 100;
+		for (const PathQuery& query : queries)
+		{
+			batch.Queries.push_back({requestId++, query.Start, query.End});
+		}
+		batch.Queries.push_back({requestId++, open, open});
+		service.Submit(3, batch, sink);
+		CHECK(service.GetPendingCount() == static_cast<int>(batch.Queries.size()));
+		while (service.HasWork())
+		{
+			service.Update(NODE_BUDGET, sink);
+		}
+
+		AStarSearch astar(grid);
+		PathResult expected;
+		for (const WireQuery& wireQuery : batch.Queries)
+		{
+			const PathQuery query = {wireQuery.Start, wireQuery.End, batch.Method};
+			astar.Reset(query.Start, query.End, query.Method);
+			astar.Run(expected);
+			const Answer& answer = answers[wireQuery.RequestId];
+			CHECK(answer.Count == 1);
+			CHECK(answer.Status == (expected.bFound ? EPathStatus::Found : EPathStatus::NotFound));
+			if (answer.Status != EPathStatus::Found)
+			{
+				CHECK(answer.Points.empty());
+				continue;
+			}
+			CHECK(IsSameCost(answer.Cost, expected.Cost));
+			CHECK(!answer.Points.empty() && answer.Points.front() == query.Start && answer.Points.back() == query.End);
+			if ((flags & Protocol::QUERY_FLAG_CELLS) != 0)
+			{
+				PathResult cells;
+				cells.bFound = true;
+				cells.Cost = answer.Cost;
+				cells.Cells = answer.Points;
+				CHECK(IsValidCellPath(grid, query, cells));
+			}
+		}
+		const Answer& same = answers[requestId - 1];
+		CHECK(same.Status == EPathStatus::Found && same.Cost == 0.0f);
+		CHECK(service.GetAnsweredCount() == answers.size());
+	}
+} // namespace
+
+int main()
+{
+	PathServiceOptions options;
+	options.ActiveCount = 4;
+	options.SliceNodeCount = 16;
+	CheckService(options, Protocol::QUERY_FLAG_CELLS);
+	CheckService(options, 0);
+	options.CacheCapacity = 32;
+	CheckService(options, Protocol::QUERY_FLAG_CELLS);
+	CheckService(options, 0);
+	return FinishTest("PathServiceTest");
+}
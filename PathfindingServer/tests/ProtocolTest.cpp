@@ -0,0 +1,227 @@
+// 프레임을 쓰고 다시 읽어 같은 값이 되는지, 덜 받았거나 길이가 맞지 않거나 너무 긴 프레임을 거절하는지 확인한다.
+// 서버는 소켓에서 받은 바이트를 그대로 이 함수들에 넘기므로 임의의 본문도 넣어 본다.
+#include "TestUtils.h"
+
+#include "Common/Protocol.h"
+
+namespace
+{
+	constexpr int FUZZ_COUNT = 20000;
+
+	QueryBatch MakeBatch()
+	{
+		QueryBatch batch;
+		batch.MapIndex = 65535;
+		batch.Method = EHeuristicMethod::ALT;
+		batch.Flags = Protocol::QUERY_FLAG_CELLS;
+		batch.Queries.push_back({0, {0, 0}, {0, 0}});
+		batch.Queries.push_back({0xFFFFFFFFu, {65535, 1}, {2, 65535}});
+		batch.Queries.push_back({42, {100, 200}, {300, 400}});
+		return batch;
+	}
+
+	bool IsSameBatch(const QueryBatch& a, const QueryBatch& b)
+	{
+		if (a.MapIndex != b.MapIndex || a.Method != b.Method || a.Flags != b.Flags
+			|| a.Queries.size() != b.Queries.size())
+		{
+			return false;
+		}
+		for (size_t i = 0; i < a.Queries.size(); ++i)
+		{
+			const WireQuery& left = a.Queries[i];
+			const WireQuery& right = b.Queries[i];
+			if (left.RequestId != right.RequestId || !(left.Start == right.Start) || !(left.End == right.End))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// 본문의 offset 위치에 리틀 엔디언 uint32를 덮어쓴다.
+	void PatchU32(std::vector<uint8_t>& buffer, size_t offset, uint32_t value)
+	{
+		for (int i = 0; i < 4; ++i)
+		{
+			buffer[offset + i] = static_cast<uint8_t>(value >> (i * 8));
+		}
+	}
+
+	void CheckRoundTrip()
+	{
+		const QueryBatch batch = MakeBatch();
+		const std::vector<GridPosition> points = {{0, 0}, {65535, 65535}, {7, 9}};
+		std::vector<uint8_t> buffer;
+		AppendQueryBatch(buffer, batch);
+		const size_t batchSize = buffer.size();
+		AppendPathResponse(buffer, 77, EPathStatus::Found, 12.5f, points);
+		AppendPathResponse(buffer, 78, EPathStatus::BadRequest, 0.0f, {});
+
+		FrameView frame;
+		CHECK(PeekFrame(buffer.data(), buffer.size(), frame) == EFrameState::Complete);
+		CHECK(frame.Type == EMessageType::QueryBatch && frame.FrameSize == batchSize);
+		QueryBatch parsedBatch;
+		CHECK(ParseQueryBatch(frame, parsedBatch));
+		CHECK(IsSameBatch(batch, parsedBatch));
+		PathResponse wrongType;
+		CHECK(!ParsePathResponse(frame, wrongType));
+
+		size_t offset = frame.FrameSize;
+		CHECK(PeekFrame(buffer.data() + offset, buffer.size() - offset, frame) == EFrameState::Complete);
+		PathResponse response;
+		CHECK(ParsePathResponse(frame, response));
+		CHECK(response.RequestId == 77 && response.Status == EPathStatus::Found && response.Cost == 12.5f);
+		CHECK(response.Points == points);
+		CHECK(!ParseQueryBatch(frame, parsedBatch));
+
+		offset += frame.FrameSize;
+		CHECK(PeekFrame(buffer.data() + offset, buffer.size() - offset, frame) == EFrameState::Complete);
+		CHECK(ParsePathResponse(frame, response));
+		CHECK(response.RequestId == 78 && response.Status == EPathStatus::BadRequest && response.Points.empty());
+		CHECK(offset + frame.FrameSize == buffer.size());
+
+		// 빈 배치
+		buffer.clear();
+		AppendQueryBatch(buffer, QueryBatch{});
+		CHECK(PeekFrame(buffer.data(), buffer.size(), frame) == EFrameState::Complete);
+		CHECK(ParseQueryBatch(frame, parsedBatch));
+		CHECK(parsedBatch.Queries.empty());
+	}
+
+	void CheckIncompleteAndOversized()
+	{
+		std::vector<uint8_t> buffer;
+		AppendQueryBatch(buffer, MakeBatch());
+		FrameView frame;
+		for (size_t size = 0; size < buffer.size(); ++size)
+		{
+			CHECK(PeekFrame(buffer.data(), size, frame) == EFrameState::Incomplete);
+		}
+
+		std::vector<uint8_t> header(Protocol::FRAME_HEADER_SIZE, 0);
+		header[4] = static_cast<uint8_t>(EMessageType::QueryBatch);
+		PatchU32(header, 0, Protocol::MAX_BODY_SIZE + 1);
+		CHECK(PeekFrame(header.data(), header.size(), frame) == EFrameState::Invalid);
+		PatchU32(header, 0, 0xFFFFFFFFu);
+		CHECK(PeekFrame(header.data(), header.size(), frame) == EFrameState::Invalid);
+		PatchU32(header, 0, Protocol::MAX_BODY_SIZE);
+		CHECK(PeekFrame(header.data(), header.size(), frame) == EFrameState::Incomplete);
+	}
+
+	// 헤더의 길이는 맞지만 본문 안의 개수나 값이 틀린 프레임
+	void CheckMalformedBodies()
+	{
+		std::vector<uint8_t> valid;
+		AppendQueryBatch(valid, MakeBatch());
+		// 본문 안의 위치: MapIndex(2), Heuristic(1), Flags(1), Count(4)
+		constexpr size_t METHOD_OFFSET = Protocol::FRAME_HEADER_SIZE + 2;
+		constexpr size_t COUNT_OFFSET = Protocol::FRAME_HEADER_SIZE + 4;
+		const uint32_t queryCount = static_cast<uint32_t>(MakeBatch().Queries.size());
+		QueryBatch parsed;
+		FrameView frame;
+		for (const uint32_t count : {queryCount - 1, queryCount + 1, 0u, 0x15555556u, 0xFFFFFFFFu})
+		{
+			std::vector<uint8_t> buffer = valid;
+			PatchU32(buffer, COUNT_OFFSET, count);
+			CHECK(PeekFrame(buffer.data(), buffer.size(), frame) == EFrameState::Complete);
+			CHECK(!ParseQueryBatch(frame, parsed));
+		}
+
+		std::vector<uint8_t> buffer = valid;
+		buffer[METHOD_OFFSET] = EHeuristicMethod::NUM_TYPES;
+		CHECK(PeekFrame(buffer.data(), buffer.size(), frame) == EFrameState::Complete);
+		CHECK(!ParseQueryBatch(frame, parsed));
+
+		// 본문이 고정 필드보다 짧다.
+		for (uint32_t bodySize = 0; bodySize < 8; ++bodySize)
+		{
+			buffer.assign(valid.begin(), valid.begin() + Protocol::FRAME_HEADER_SIZE + bodySize);
+			PatchU32(buffer, 0, bodySize);
+			CHECK(PeekFrame(buffer.data(), buffer.size(), frame) == EFrameState::Complete);
+			CHECK(!ParseQueryBatch(frame, parsed));
+		}
+
+		std::vector<uint8_t> response;
+		AppendPathResponse(response, 1, EPathStatus::NotFound, 0.0f, {{1, 2}});
+		// 본문 안의 위치: RequestId(4), Status(1), Cost(4), PointCount(4)
+		constexpr size_t STATUS_OFFSET = Protocol::FRAME_HEADER_SIZE + 4;
+		constexpr size_t POINT_COUNT_OFFSET = Protocol::FRAME_HEADER_SIZE + 9;
+		PathResponse parsedResponse;
+		buffer = response;
+		buffer[STATUS_OFFSET] = static_cast<uint8_t>(EPathStatus::BadRequest) + 1;
+		CHECK(PeekFrame(buffer.data(), buffer.size(), frame) == EFrameState::Complete);
+		CHECK(!ParsePathResponse(frame, parsedResponse));
+		for (const uint32_t count : {0u, 2u, 0x40000001u, 0xFFFFFFFFu})
+		{
+			buffer = response;
+			PatchU32(buffer, POINT_COUNT_OFFSET, count);
+			CHECK(PeekFrame(buffer.data(), buffer.size(), frame) == EFrameState::Complete);
+			CHECK(!ParsePathResponse(frame, parsedResponse));
+		}
+	}
+
+	// 임의의 본문은 거절되거나, 받아들였다면 다시 쓴 바이트가 원래 프레임과 같아야 한다.
+	void CheckRandomBodies()
+	{
+		std::mt19937 random(131);
+		std::vector<uint8_t> buffer;
+		std::vector<uint8_t> rewritten;
+		QueryBatch parsed;
+		PathResponse parsedResponse;
+		int acceptedCount = 0;
+		for (int i = 0; i < FUZZ_COUNT; ++i)
+		{
+			// 절반은 올바른 프레임의 바이트 몇 개를 바꾸고, 나머지는 완전히 임의의 본문이다.
+			buffer.clear();
+			if (i % 2 == 0)
+			{
+				AppendQueryBatch(buffer, MakeBatch());
+				for (int flip = 0; flip < 3; ++flip)
+				{
+					const size_t position = Protocol::FRAME_HEADER_SIZE
+											+ random() % (buffer.size() - Protocol::FRAME_HEADER_SIZE);
+					buffer[position] = static_cast<uint8_t>(random());
+				}
+			}
+			else
+			{
+				const uint32_t bodySize = random() % 64;
+				buffer.resize(Protocol::FRAME_HEADER_SIZE + bodySize);
+				PatchU32(buffer, 0, bodySize);
+				buffer[4] = static_cast<uint8_t>(1 + random() % 2);
+				for (size_t position = Protocol::FRAME_HEADER_SIZE; position < buffer.size(); ++position)
+				{
+					buffer[position] = static_cast<uint8_t>(random());
+				}
+			}
+
+			FrameView frame;
+			CHECK(PeekFrame(buffer.data(), buffer.size(), frame) == EFrameState::Complete);
+			rewritten.clear();
+			if (ParseQueryBatch(frame, parsed))
+			{
+				++acceptedCount;
+				AppendQueryBatch(rewritten, parsed);
+				CHECK(rewritten == buffer);
+			}
+			else if (ParsePathResponse(frame, parsedResponse))
+			{
+				++acceptedCount;
+				AppendPathResponse(rewritten, parsedResponse.RequestId, parsedResponse.Status, parsedResponse.Cost,
+								   parsedResponse.Points);
+				CHECK(rewritten == buffer);
+			}
+		}
+		CHECK(acceptedCount > 0);
+	}
+} // namespace
+
+int main()
+{
+	CheckRoundTrip();
+	CheckIncompleteAndOversized();
+	CheckMalformedBodies();
+	CheckRandomBodies();
+	return FinishTest("ProtocolTest");
+}